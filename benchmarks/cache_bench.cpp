@@ -0,0 +1,82 @@
+// Benchmark of NOMAD::EvalCache against a std::map<NOMAD::Point,NOMAD::Point> cache:
+// insertion of mesh points, then lookups of points in and out of the cache.
+
+#include <map>
+#include <vector>
+
+#include "Cache/EvalCache.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "timer.hpp"
+
+int main()
+{
+    const int n = 10;
+    const int p = 1000000;
+    char name[64];
+
+    std::printf("NOMAD::EvalCache, n=%d, p=%d\n", n, p);
+
+    // Mesh points ref + k*delta, and points off the mesh for the misses
+    NOMAD::RNG::set_seed(1);
+    NOMAD::Point ref(n), delta(n);
+    for (int i = 0; i < n; i++)
+    {
+        ref[i] = NOMAD::RNG::rand(-1.0, 1.0);
+        delta[i] = 0.01 * (i + 1);
+    }
+    NOMAD::PointSet points(p, n, NOMAD::AOS);
+    NOMAD::PointSet misses(p, n, NOMAD::AOS);
+    for (int j = 0; j < p; j++)
+        for (int i = 0; i < n; i++)
+        {
+            int k = static_cast<int>(NOMAD::RNG::rand(-1000.0, 1000.0));
+            points(j,i) = ref[i] + k * delta[i];
+            misses(j,i) = ref[i] + (k + 0.5) * delta[i];
+        }
+    NOMAD::Point f(2, 1.0);
+
+    for (int v = 0; v < 3; v++)
+    {
+        const char * cache_name = (v == 0) ? "std::map<Point,Point>"
+                                : (v == 1) ? "EvalCache" : "EvalCache mesh hash";
+        std::map<NOMAD::Point, NOMAD::Point> map;
+        NOMAD::EvalCache cache(n, 2, (v == 2) ? NOMAD::PointHash(ref, delta) : NOMAD::PointHash());
+        int found = 0;
+
+        Timer timer;
+        for (int j = 0; j < p; j++)
+        {
+            if (v == 0)
+                map.insert(std::make_pair(points.get_point(j), f));
+            else
+                cache.insert(points.row(j), f);
+        }
+        std::snprintf(name, sizeof(name), "insert, %s", cache_name);
+        print_result(name, timer.elapsed(), p, "point");
+
+        timer.restart();
+        for (int j = 0; j < p; j++)
+        {
+            if (v == 0)
+                found += (map.find(points.get_point(j)) != map.end());
+            else
+                found += (cache.find(points.row(j)) >= 0);
+        }
+        std::snprintf(name, sizeof(name), "hits, %s", cache_name);
+        print_result(name, timer.elapsed(), p, "point");
+
+        timer.restart();
+        for (int j = 0; j < p; j++)
+        {
+            if (v == 0)
+                found += (map.find(misses.get_point(j)) != map.end());
+            else
+                found += (cache.find(misses.row(j)) >= 0);
+        }
+        std::snprintf(name, sizeof(name), "misses, %s", cache_name);
+        print_result(name, timer.elapsed(), p, "point");
+        do_not_optimize(found);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Benchmark of NOMAD::CacheFile: appending records, and warm start from the
+// binary file against parsing the same records from text with Double::atof.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "Cache/CacheFile.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "timer.hpp"
+
+int main()
+{
+    const int n = 10;
+    const int p = 1000000;
+    std::vector<NOMAD::bb_output_type> bbot;
+    bbot.push_back(NOMAD::OBJ);
+    bbot.push_back(NOMAD::PB);
+    bbot.push_back(NOMAD::PB);
+    const int m = static_cast<int>(bbot.size());
+
+    std::ostringstream oss;
+    oss << "cachefile_bench." << getpid();
+    const std::string bin_name = oss.str() + ".bin";
+    const std::string txt_name = oss.str() + ".txt";
+
+    std::printf("NOMAD::CacheFile, n=%d, m=%d, p=%d\n", n, m, p);
+
+    NOMAD::RNG::set_seed(1);
+    NOMAD::PointSet points(p, n, NOMAD::AOS);
+    NOMAD::PointSet outputs(p, m, NOMAD::AOS);
+    for (int j = 0; j < p; j++)
+    {
+        for (int i = 0; i < n; i++)
+            points(j,i) = NOMAD::RNG::rand(-1.0, 1.0);
+        for (int i = 0; i < m; i++)
+            outputs(j,i) = NOMAD::RNG::rand(-100.0, 100.0);
+    }
+
+    // Writing
+    Timer timer;
+    {
+        NOMAD::CacheFile file;
+        file.create(bin_name, n, bbot);
+        for (int j = 0; j < p; j++)
+            file.append(points.row(j), outputs.row(j));
+        file.close();
+    }
+    print_result("append + close", timer.elapsed(), p, "record");
+
+    {
+        NOMAD::CacheFile file;
+        file.open(bin_name, true);
+        timer.restart();
+        std::ofstream out(txt_name.c_str());
+        file.export_text(out);
+        out.close();
+        print_result("text export", timer.elapsed(), p, "record");
+    }
+
+    // Warm start from the binary file
+    double sum = 0.0;
+    timer.restart();
+    NOMAD::CacheFile file;
+    file.open(bin_name, true);
+    print_result("binary open", timer.elapsed(), 1, "file");
+
+    timer.restart();
+    for (int j = 0; j < p; j++)
+        sum += file.get_outputs(j)[0].todouble();
+    do_not_optimize(sum);
+    print_result("binary first scan", timer.elapsed(), p, "record");
+
+    timer.restart();
+    {
+        NOMAD::EvalCache cache(n, m);
+        file.load(cache);
+    }
+    print_result("binary load in EvalCache", timer.elapsed(), p, "record");
+    file.close();
+
+    // Warm start from the text file
+    timer.restart();
+    {
+        std::ifstream in(txt_name.c_str());
+        NOMAD::PointSet x(p, n, NOMAD::AOS), f(p, m, NOMAD::AOS);
+        std::string line, token;
+        int j = 0;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream iss(line);
+            iss >> token;   // (
+            for (int i = 0; i < n; i++)
+            {
+                iss >> token;
+                x(j,i).atof(token);
+            }
+            iss >> token;   // )
+            for (int i = 0; i < m; i++)
+            {
+                iss >> token;
+                f(j,i).atof(token);
+            }
+            j++;
+        }
+        do_not_optimize(x(p - 1,0));
+    }
+    print_result("text parse", timer.elapsed(), p, "record");
+
+    std::remove(bin_name.c_str());
+    std::remove(txt_name.c_str());
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Benchmark of NOMAD::Double arithmetic on Vector::norm()-style loops.
+//
+// double_bench uses the default checked NOMAD::Double.
+// double_bench_unchecked and the library objects it links are compiled with
+// UNCHECKED_DOUBLE: the loop is not checked per operation, and the result
+// is validated once per batch.
+
+#include <vector>
+
+#include "Math/Double.hpp"
+#include "Math/Point.hpp"
+#include "Math/Reduction.hpp"
+#include "Math/Vector.hpp"
+#include "timer.hpp"
+
+// Same loop as Vector::norm(), on NOMAD::Double.
+static NOMAD::Double norm_double(const std::vector<NOMAD::Double>& a,
+                                 const std::vector<NOMAD::Double>& b)
+{
+    NOMAD::Double norm = 0;
+    const size_t n = a.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        NOMAD::Double diff = b[i] - a[i];
+        norm += diff * diff;
+    }
+#ifdef UNCHECKED_DOUBLE
+    norm.check_defined();
+#endif
+    return norm.sqrt();
+}
+
+// Reference loop on raw doubles.
+static double norm_raw(const std::vector<double>& a, const std::vector<double>& b)
+{
+    double norm = 0;
+    const size_t n = a.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        double diff = b[i] - a[i];
+        norm += diff * diff;
+    }
+    return std::sqrt(norm);
+}
+
+int main()
+{
+#ifdef UNCHECKED_DOUBLE
+    std::printf("NOMAD::Double norm loops (UNCHECKED_DOUBLE)\n");
+#else
+    std::printf("NOMAD::Double norm loops (checked)\n");
+#endif
+    const int n = NOMAD::MAX_DIMENSION;
+    const int nb_rep = 200000;
+
+    std::vector<NOMAD::Double> a(n), b(n);
+    std::vector<double> ra(n), rb(n);
+    NOMAD::Point pa(n), pb(n);
+    for (int i = 0; i < n; i++)
+    {
+        ra[i] = 0.5 * i;
+        rb[i] = 1.0 / (i + 1);
+        a[i] = pa[i] = ra[i];
+        b[i] = pb[i] = rb[i];
+    }
+
+    Timer timer;
+    for (int r = 0; r < nb_rep; r++)
+    {
+        NOMAD::Double norm = norm_double(a, b);
+        do_not_optimize(norm);
+    }
+    print_result("NOMAD::Double loop", timer.elapsed(), double(n) * nb_rep, "coord");
+
+    timer.restart();
+    for (int r = 0; r < nb_rep; r++)
+    {
+        double norm = norm_raw(ra, rb);
+        do_not_optimize(norm);
+    }
+    print_result("double loop (reference)", timer.elapsed(), double(n) * nb_rep, "coord");
+
+    NOMAD::Vector v(pa, pb);
+    timer.restart();
+    for (int r = 0; r < nb_rep / 10; r++)
+    {
+        NOMAD::Double norm = v.norm();
+        do_not_optimize(norm);
+    }
+    print_result("Vector::norm()", timer.elapsed(), double(n) * nb_rep / 10, "coord");
+
+    timer.restart();
+    for (int r = 0; r < nb_rep; r++)
+    {
+        NOMAD::Double norm = NOMAD::Reduction::dist(&a[0], &b[0], n);
+        do_not_optimize(norm);
+    }
+    print_result("Reduction::dist() (pairwise)", timer.elapsed(), double(n) * nb_rep, "coord");
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Benchmark of NOMAD::KDTree against a linear scan of the points:
+// incremental insertion, radius queries and nearest neighbor queries.
+
+#include <cmath>
+#include <vector>
+
+#include "Cache/KDTree.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "timer.hpp"
+
+int main()
+{
+    const int n = 5;
+    const int sizes[] = { 100000, 1000000 };
+    const int nb_queries = 1000;
+    const int k = 10;
+    char name[64];
+
+    NOMAD::RNG::set_seed(1);
+    NOMAD::Point x(n), scale(n);
+    for (int i = 0; i < n; i++)
+        scale[i] = 1.0 + i;
+
+    for (int s = 0; s < 2; s++)
+    {
+        const int p = sizes[s];
+        std::printf("NOMAD::KDTree, n=%d, p=%d\n", n, p);
+
+        NOMAD::PointSet points(p, n, NOMAD::AOS);
+        for (int j = 0; j < p; j++)
+            for (int i = 0; i < n; i++)
+                points(j,i) = NOMAD::RNG::rand(-1.0, 1.0) * (i + 1);
+        NOMAD::PointSet queries(nb_queries, n, NOMAD::AOS);
+        for (int j = 0; j < nb_queries; j++)
+            for (int i = 0; i < n; i++)
+                queries(j,i) = NOMAD::RNG::rand(-1.0, 1.0) * (i + 1);
+
+        // About 100 points in each ball: the scaled points are uniform in
+        // [-1,1]^5, and the volume of the unit ball is 8 pi^2 / 15.
+        const double radius = std::pow(100.0 / p * 32 / (8 * 3.14159 * 3.14159 / 15), 1.0 / n);
+
+        Timer timer;
+        NOMAD::KDTree tree(n);
+        for (int j = 0; j < p; j++)
+            tree.insert(points.row(j));
+        print_result("insert", timer.elapsed(), p, "point");
+
+        std::vector<int> ids;
+        long nb_found = 0;
+        timer.restart();
+        for (int j = 0; j < nb_queries; j++)
+        {
+            tree.radius_search(queries.row(j), radius, ids, scale);
+            nb_found += ids.size();
+        }
+        std::snprintf(name, sizeof(name), "radius, KDTree (%.0f found)", double(nb_found) / nb_queries);
+        print_result(name, timer.elapsed(), nb_queries, "query");
+
+        // Linear scan on the scaled points
+        NOMAD::PointSet scaled(points);
+        for (int j = 0; j < p; j++)
+            for (int i = 0; i < n; i++)
+                scaled(j,i) = points(j,i) / scale[i];
+        std::vector<NOMAD::Double> dists(p);
+        nb_found = 0;
+        const int nb_scan_queries = nb_queries / 10;
+        timer.restart();
+        for (int j = 0; j < nb_scan_queries; j++)
+        {
+            for (int i = 0; i < n; i++)
+                x[i] = queries(j,i) / scale[i];
+            scaled.dists(x, &dists[0]);
+            for (int l = 0; l < p; l++)
+                nb_found += (dists[l] <= radius);
+        }
+        std::snprintf(name, sizeof(name), "radius, scan (%.0f found)", double(nb_found) / nb_scan_queries);
+        print_result(name, timer.elapsed(), nb_scan_queries, "query");
+
+        timer.restart();
+        for (int j = 0; j < nb_queries; j++)
+        {
+            tree.nearest(queries.row(j), k, ids, NULL, scale);
+            do_not_optimize(ids[0]);
+        }
+        std::snprintf(name, sizeof(name), "%d nearest, KDTree", k);
+        print_result(name, timer.elapsed(), nb_queries, "query");
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Benchmark of NOMAD::LHS: sampling of all the points by Sample(), against
+// the streaming generator NOMAD::LHS::Stream, scaling of SampleParallel()
+// from 1 thread to the number of cores, and quality of SampleMaximin()
+// against its time.
+//
+// Usage: lhs_bench [max_threads]   (default: the number of cores)
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Math/LHS.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "timer.hpp"
+
+// Previous version of LHS::Sample(PointSet&): integer bounds, and four
+// NOMAD::Double temporaries per coordinate.
+void sample_reference(int n, int p, const std::vector<int> &l, const std::vector<int> &u,
+                      NOMAD::PointSet &points)
+{
+    std::vector<std::vector<int> > Pi;
+    for (int i = 0; i < n; i++)
+    {
+        std::vector<int> v = NOMAD::LHS::Permutation(p);
+        Pi.push_back(v);
+    }
+    for (int j = 0; j < p; j++)
+    {
+        NOMAD::PointSet::Slice point = points.row(j);
+        for (int i = 0; i < n; i++)
+        {
+            NOMAD::Double r_ij = NOMAD::RNG::rand(0,1);
+            NOMAD::Double l_i(l[i]);
+            NOMAD::Double Pi_ij( Pi[i][j] );
+            NOMAD::Double pdouble( p );
+            NOMAD::Double u_i( u[i] );
+            point[i] = l_i + (Pi_ij - r_ij) / pdouble * (u_i - l_i);
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    const int n = 100;
+    const int p = 100000;
+    const int block_size = 1000;
+
+    std::printf("NOMAD::LHS, n=%d, p=%d\n", n, p);
+
+    NOMAD::LHS lhs(n, p);
+    lhs.set_l(std::vector<int>(n, -10));
+    lhs.set_u(std::vector<int>(n, 10));
+
+    NOMAD::PointSet points(p, n, NOMAD::AOS);
+    Timer timer;
+    lhs.Sample(points);
+    print_result("Sample(PointSet)", timer.elapsed(), p, "point");
+
+    timer.restart();
+    NOMAD::LHS::Stream stream(lhs);
+    NOMAD::Point x;
+    stream.next(x);
+    do_not_optimize(x[0]);
+    print_result("Stream, first point", timer.elapsed(), 1, "point");
+
+    timer.restart();
+    stream.seek(0);
+    NOMAD::PointSet block(block_size, n, NOMAD::AOS);
+    while (stream.next(block) > 0)
+        do_not_optimize(block(0,0));
+    print_result("Stream, blocks of 1000", timer.elapsed(), p, "point");
+
+    // Large dimension, real bounds
+    {
+        const int n_large = 1000;
+        const int p_large = 10000;
+        std::printf("NOMAD::LHS, n=%d, p=%d\n", n_large, p_large);
+        NOMAD::LHS lhs_large(n_large, p_large);
+        std::vector<int> l(n_large, -10), u(n_large, 10);
+        NOMAD::PointSet large(p_large, n_large, NOMAD::AOS);
+
+        timer.restart();
+        sample_reference(n_large, p_large, l, u, large);
+        print_result("previous Sample(PointSet)", timer.elapsed(), p_large, "point");
+
+        std::vector<double> lb(n_large, -10.0), ub(n_large, 10.0);
+        lhs_large.set_bounds(lb, ub);
+        timer.restart();
+        lhs_large.Sample(large);
+        print_result("Sample(PointSet), real bounds", timer.elapsed(), p_large, "point");
+
+        // Without the permutations
+        timer.restart();
+        for (int i = 0; i < n_large; i++)
+            do_not_optimize(NOMAD::LHS::Permutation(p_large)[0]);
+        print_result("  of which permutations", timer.elapsed(), p_large, "point");
+
+        timer.restart();
+        lhs_large.SampleParallel(large, 1);
+        print_result("SampleParallel(PointSet), 1 thread", timer.elapsed(), p_large, "point");
+    }
+
+    // Scaling: 1, 2, 4, .. threads, and one per core
+    const int nb_cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int max_threads = (argc > 1) ? std::max(1, std::atoi(argv[1])) : nb_cores;
+    std::printf("NOMAD::LHS::SampleParallel, n=%d, p=%d, %d cores\n", n, p, nb_cores);
+    NOMAD::PointSet ref(p, n, NOMAD::AOS);
+    lhs.SampleParallel(ref, 1);
+    char name[64];
+    double time_1 = 0.0;
+    for (int t = 1; ; t = std::min(2 * t, max_threads))
+    {
+        timer.restart();
+        lhs.SampleParallel(points, t);
+        double time_t = timer.elapsed();
+        if (t == 1)
+            time_1 = time_t;
+        bool same = (0 == memcmp(&ref(0,0), &points(0,0), sizeof(NOMAD::Double) * n * p));
+        std::snprintf(name, sizeof(name), "%d threads, speedup %.2f%s", t, time_1 / time_t,
+                      same ? "" : " DIFFERENT");
+        print_result(name, time_t, p, "point");
+        if (t == max_threads)
+            break;
+    }
+
+    // Maximin designs: minimum distance in [0,1]^n against the budget
+    {
+        const int n_opt = 10;
+        const int p_opt = 100;
+        std::printf("NOMAD::LHS::SampleMaximin, n=%d, p=%d\n", n_opt, p_opt);
+        NOMAD::LHS lhs_opt(n_opt, p_opt);
+        lhs_opt.set_bounds(std::vector<double>(n_opt, 0.0), std::vector<double>(n_opt, 1.0));
+        NOMAD::PointSet design(p_opt, n_opt, NOMAD::AOS);
+
+        const int budgets[] = { 0, 1000, 10000, 100000, 1000000 };
+        for (int b = 0; b < 5; b++)
+        {
+            timer.restart();
+            double d = lhs_opt.SampleMaximin(design, budgets[b], 0.0, 1, 1);
+            std::snprintf(name, sizeof(name), "%d exchanges, min dist %.4f", budgets[b], d);
+            print_result(name, timer.elapsed(), std::max(budgets[b], 1), "exchange");
+        }
+
+        timer.restart();
+        double d = lhs_opt.SampleMaximin(design, 100000, 0.0, 8, max_threads);
+        std::snprintf(name, sizeof(name), "8 x 100000, %d threads, min dist %.4f", max_threads, d);
+        print_result(name, timer.elapsed(), 8 * 100000, "exchange");
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Benchmark of NOMAD::Point construction, copy and destruction, for the
+// small dimensions of most problems and for larger ones, and of the
+// comparisons with each instruction set.
+
+#include <vector>
+
+#include "Math/Compare.hpp"
+#include "Math/Point.hpp"
+#include "timer.hpp"
+
+int main()
+{
+    std::printf("NOMAD::Point construct/copy/destroy (POINT_SMALL_SIZE=%d)\n", POINT_SMALL_SIZE);
+    const int dims[] = { 2, 5, 10, 50 };
+    const int nb_rep = 2000000;
+
+    for (int d = 0; d < 4; d++)
+    {
+        const int n = dims[d];
+        char name[64];
+
+        Timer timer;
+        for (int r = 0; r < nb_rep; r++)
+        {
+            NOMAD::Point p(n, 1.0);
+            do_not_optimize(p);
+        }
+        std::snprintf(name, sizeof(name), "n=%d construct+destroy", n);
+        print_result(name, timer.elapsed(), nb_rep, "point");
+
+        NOMAD::Point src(n, 2.0);
+        timer.restart();
+        for (int r = 0; r < nb_rep; r++)
+        {
+            NOMAD::Point p(src);
+            do_not_optimize(p);
+        }
+        std::snprintf(name, sizeof(name), "n=%d copy+destroy", n);
+        print_result(name, timer.elapsed(), nb_rep, "point");
+
+        // Vector of points, as in LHS::Sample().
+        timer.restart();
+        for (int r = 0; r < nb_rep / 100; r++)
+        {
+            std::vector<NOMAD::Point> points(100, src);
+            do_not_optimize(points[0]);
+        }
+        std::snprintf(name, sizeof(name), "n=%d vector of 100 copies", n);
+        print_result(name, timer.elapsed(), nb_rep, "point");
+    }
+
+    // Comparisons of equal points: all the coordinates are compared.
+    const NOMAD::Compare::isa_type isas[] = { NOMAD::Compare::SCALAR,
+                                              NOMAD::Compare::SSE2,
+                                              NOMAD::Compare::AVX2 };
+    const char * isa_names[] = { "scalar", "SSE2", "AVX2" };
+    const NOMAD::Compare::isa_type best = NOMAD::Compare::get_isa();
+    std::printf("Comparisons of equal points\n");
+    for (int d = 0; d < 4; d++)
+    {
+        const int n = dims[d];
+        char name[64];
+        NOMAD::Point x(n), y(n);
+        for (int i = 0; i < n; i++)
+            x[i] = y[i] = 0.1 * i;
+
+        for (int t = 0; t < 3; t++)
+        {
+            if (NOMAD::Compare::set_isa(isas[t]) != isas[t])
+                continue;
+            int nb_true = 0;
+            Timer timer;
+            for (int r = 0; r < nb_rep; r++)
+            {
+                do_not_optimize(x);
+                nb_true += (x == y);
+                nb_true += (x < y);
+            }
+            do_not_optimize(nb_true);
+            std::snprintf(name, sizeof(name), "n=%d == and <, %s", n, isa_names[t]);
+            print_result(name, timer.elapsed(), 2.0 * nb_rep, "compare");
+        }
+    }
+    NOMAD::Compare::set_isa(best);
+    return 0;
+}
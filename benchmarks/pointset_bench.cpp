@@ -0,0 +1,94 @@
+// Benchmark of NOMAD::PointSet against a vector of NOMAD::Point*:
+// LHS sampling, and norms of all the points with both layouts.
+
+#include <vector>
+
+#include "Math/LHS.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "timer.hpp"
+
+int main()
+{
+    const int n = 50;
+    const int p = 2000;
+    const int nb_rep = 20;
+    char name[64];
+
+    std::printf("NOMAD::PointSet, n=%d, p=%d\n", n, p);
+
+    NOMAD::LHS lhs(n, p);
+    lhs.set_l(std::vector<int>(n, -10));
+    lhs.set_u(std::vector<int>(n, 10));
+
+    // LHS sampling
+    Timer timer;
+    for (int r = 0; r < nb_rep; r++)
+    {
+        std::vector<NOMAD::Point*> sample = lhs.Sample();
+        do_not_optimize(sample[0]);
+        for (int j = 0; j < p; j++)
+            delete sample[j];
+    }
+    print_result("LHS vector<Point*>", timer.elapsed(), double(nb_rep) * p, "point");
+
+    NOMAD::PointSet aos(p, n, NOMAD::AOS);
+    timer.restart();
+    for (int r = 0; r < nb_rep; r++)
+    {
+        lhs.Sample(aos);
+        do_not_optimize(aos(0,0));
+    }
+    print_result("LHS PointSet", timer.elapsed(), double(nb_rep) * p, "point");
+
+    // Norms, on points that fit in the cache
+    const int p_norm = 256;
+    std::vector<NOMAD::Point*> points = lhs.Sample();
+    NOMAD::PointSet soa(0, n, NOMAD::SOA);
+    NOMAD::PointSet aos_norm(0, n, NOMAD::AOS);
+    for (int j = 0; j < p_norm; j++)
+    {
+        soa.add_point(*points[j]);
+        aos_norm.add_point(*points[j]);
+    }
+    std::vector<NOMAD::Double> norms(p_norm);
+    const int nb_norm_rep = 20000;
+    const NOMAD::hnorm_type types[] = { NOMAD::L1, NOMAD::L2, NOMAD::LINF };
+    const char * type_names[] = { "L1", "L2", "LINF" };
+    std::printf("Norms of %d points\n", p_norm);
+
+    for (int t = 0; t < 3; t++)
+    {
+        timer.restart();
+        for (int r = 0; r < nb_norm_rep; r++)
+        {
+            for (int j = 0; j < p_norm; j++)
+                norms[j] = points[j]->norm(types[t]);
+            do_not_optimize(norms[0]);
+        }
+        std::snprintf(name, sizeof(name), "%s norms, vector<Point*>", type_names[t]);
+        print_result(name, timer.elapsed(), double(nb_norm_rep) * p_norm * n, "coord");
+
+        timer.restart();
+        for (int r = 0; r < nb_norm_rep; r++)
+        {
+            aos_norm.norms(&norms[0], types[t]);
+            do_not_optimize(norms[0]);
+        }
+        std::snprintf(name, sizeof(name), "%s norms, PointSet AOS", type_names[t]);
+        print_result(name, timer.elapsed(), double(nb_norm_rep) * p_norm * n, "coord");
+
+        timer.restart();
+        for (int r = 0; r < nb_norm_rep; r++)
+        {
+            soa.norms(&norms[0], types[t]);
+            do_not_optimize(norms[0]);
+        }
+        std::snprintf(name, sizeof(name), "%s norms, PointSet SOA", type_names[t]);
+        print_result(name, timer.elapsed(), double(nb_norm_rep) * p_norm * n, "coord");
+    }
+
+    for (int j = 0; j < p; j++)
+        delete points[j];
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Benchmark of the projection of trial points to the mesh:
+// one NOMAD::Double::project_to_mesh() call per coordinate, against the
+// batched projection of whole points.
+
+#include <cstdlib>
+#include <vector>
+
+#include "Math/Double.hpp"
+#include "Math/Point.hpp"
+#include "timer.hpp"
+
+int main()
+{
+    std::printf("Projection to the mesh\n");
+    const int n = 50;
+    const int nb_points = 1000;
+    const int nb_rep = 200;
+
+    NOMAD::Point ref(n), delta(n), lb(n), ub(n);
+    std::vector<NOMAD::Point> points(nb_points, NOMAD::Point(n));
+    std::srand(1);
+    for (int i = 0; i < n; i++)
+    {
+        ref[i] = 0.1 * i;
+        delta[i] = 1.0 / (1 + i % 8);
+        lb[i] = -10.0;
+        ub[i] = 10.0;
+    }
+    for (int k = 0; k < nb_points; k++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            points[k][i] = ((double)std::rand() / RAND_MAX - 0.5) * 30.0;
+        }
+    }
+
+    std::vector<NOMAD::Point> work(points);
+    Timer timer;
+    for (int r = 0; r < nb_rep; r++)
+    {
+        work = points;
+        for (int k = 0; k < nb_points; k++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                work[k][i].project_to_mesh(ref[i], delta[i], lb[i], ub[i]);
+            }
+        }
+        do_not_optimize(work[0][0]);
+    }
+    print_result("scalar Double::project_to_mesh", timer.elapsed(), double(n) * nb_points * nb_rep, "coord");
+    std::vector<NOMAD::Point> scalar(work);
+
+    timer.restart();
+    for (int r = 0; r < nb_rep; r++)
+    {
+        work = points;
+        NOMAD::Point::project_to_mesh(&work[0], nb_points, ref, delta, lb, ub);
+        do_not_optimize(work[0][0]);
+    }
+    print_result("batched Point::project_to_mesh", timer.elapsed(), double(n) * nb_points * nb_rep, "coord");
+
+    timer.restart();
+    for (int r = 0; r < nb_rep; r++)
+    {
+        work = points;
+        do_not_optimize(work[0][0]);
+    }
+    print_result("copy only (overhead)", timer.elapsed(), double(n) * nb_points * nb_rep, "coord");
+
+    for (int k = 0; k < nb_points; k++)
+    {
+        work[k] = points[k];
+    }
+    NOMAD::Point::project_to_mesh(&work[0], nb_points, ref, delta, lb, ub);
+    for (int k = 0; k < nb_points; k++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (scalar[k][i].todouble() != work[k][i].todouble())
+            {
+                std::printf("ERROR: different results\n");
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
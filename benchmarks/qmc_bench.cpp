@@ -0,0 +1,109 @@
+// Benchmark of the low-discrepancy sequences NOMAD::Sobol and NOMAD::Halton,
+// against NOMAD::LHS: sampling of all the points, streaming by blocks, and
+// direct access to one sample; then the error of the integration of a
+// smooth function in [0,1]^10, against the number of points.
+
+#include <cmath>
+#include <vector>
+
+#include "Math/Halton.hpp"
+#include "Math/LHS.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "Math/Sobol.hpp"
+#include "timer.hpp"
+
+// Generators of p samples with the same interface.
+template <typename T>
+void bench_sequence(const char *title, T &gen, int n, int p, int block_size)
+{
+    std::printf("%s, n=%d, p=%d\n", title, n, p);
+    NOMAD::PointSet points(p, n, NOMAD::AOS);
+    Timer timer;
+    gen.Sample(points);
+    print_result("Sample(PointSet)", timer.elapsed(), p, "point");
+
+    timer.restart();
+    gen.seek(0);
+    NOMAD::PointSet block(block_size, n, NOMAD::AOS);
+    while (gen.next(block) > 0)
+        do_not_optimize(block(0,0));
+    print_result("next(PointSet), blocks of 1000", timer.elapsed(), p, "point");
+
+    timer.restart();
+    NOMAD::Point x;
+    const int nb_access = 10000;
+    for (int k = 0; k < nb_access; k++)
+    {
+        gen.Sample((k * 7919) % p, x);
+        do_not_optimize(x[0]);
+    }
+    print_result("Sample(k), random k", timer.elapsed(), nb_access, "point");
+}
+
+// Integral of prod_i (1 + (x_i-1/2)/(i+1)) in [0,1]^n, equal to 1.
+double integrate(const NOMAD::PointSet &points)
+{
+    double sum = 0.0;
+    for (int k = 0; k < points.get_nb_points(); k++)
+    {
+        double f = 1.0;
+        for (int i = 0; i < points.get_dimension(); i++)
+            f *= 1.0 + (points(k,i).todouble() - 0.5) / (i + 1);
+        sum += f;
+    }
+    return sum / points.get_nb_points();
+}
+
+int main(void)
+{
+    const int n = 100;
+    const int p = 100000;
+    const int block_size = 1000;
+
+    NOMAD::Sobol sobol(n, p);
+    bench_sequence("NOMAD::Sobol", sobol, n, p, block_size);
+
+    NOMAD::Halton halton(n, p);
+    bench_sequence("NOMAD::Halton", halton, n, p, block_size);
+
+    NOMAD::LHS lhs(n, p);
+    lhs.set_bounds(std::vector<double>(n, 0.0), std::vector<double>(n, 1.0));
+    NOMAD::LHS::Stream stream(lhs);
+    bench_sequence("NOMAD::LHS::Stream", stream, n, p, block_size);
+
+    // Integration error, averaged over seeds
+    const int n_int = 10;
+    const int nb_seeds = 10;
+    std::printf("Integration error in [0,1]^%d, mean over %d seeds\n", n_int, nb_seeds);
+    std::printf("  %8s %12s %12s %12s %12s\n", "points", "random", "LHS", "Halton", "Sobol");
+    for (int m = 8; m <= 16; m += 2)
+    {
+        const int p_int = 1 << m;
+        double err[4] = { 0.0, 0.0, 0.0, 0.0 };
+        NOMAD::PointSet points(p_int, n_int, NOMAD::AOS);
+        for (int s = 0; s < nb_seeds; s++)
+        {
+            NOMAD::RNG::set_seed(s);
+            for (int k = 0; k < p_int; k++)
+                for (int i = 0; i < n_int; i++)
+                    points(k,i) = NOMAD::RNG::rand(0.0, 1.0);
+            err[0] += std::fabs(integrate(points) - 1.0);
+
+            NOMAD::LHS lhs_int(n_int, p_int, s);
+            lhs_int.set_bounds(std::vector<double>(n_int, 0.0), std::vector<double>(n_int, 1.0));
+            NOMAD::LHS::Stream(lhs_int).Sample(points);
+            err[1] += std::fabs(integrate(points) - 1.0);
+
+            NOMAD::Halton(n_int, p_int, s).Sample(points);
+            err[2] += std::fabs(integrate(points) - 1.0);
+
+            NOMAD::Sobol(n_int, p_int, s).Sample(points);
+            err[3] += std::fabs(integrate(points) - 1.0);
+        }
+        std::printf("  %8d %12.3e %12.3e %12.3e %12.3e\n", p_int,
+                    err[0] / nb_seeds, err[1] / nb_seeds, err[2] / nb_seeds, err[3] / nb_seeds);
+    }
+
+    return 0;
+}
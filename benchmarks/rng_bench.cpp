@@ -0,0 +1,152 @@
+// Benchmark of NOMAD::RNG: time of set_seed() against the seed, with the
+// mixing of the seed, in compatibility mode (jump ahead), and with the
+// draws of the previous versions. Then draws of the static functions
+// against a NOMAD::RandomGenerator object, cost of substream(), and
+// uniform and normal variates per call against the bulk fills.
+
+#include <climits>
+#include <vector>
+
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "timer.hpp"
+
+// Previous version of RNG::set_seed(): s draws from the default state.
+void set_seed_reference(int s)
+{
+    NOMAD::RNG::reset_private_seed_to_default();
+    for (int i = 0; i < s; i++)
+        NOMAD::RNG::rand();
+}
+
+int main(void)
+{
+    char name[64];
+    std::printf("NOMAD::RNG::set_seed\n");
+    const int seeds[] = { 1000, 1000000, 1000000000, INT_MAX };
+    for (int k = 0; k < 4; k++)
+    {
+        const int s = seeds[k];
+        Timer timer;
+        set_seed_reference(s);
+        uint32_t ref = NOMAD::RNG::rand();
+        std::snprintf(name, sizeof(name), "previous, seed %d", s);
+        print_result(name, timer.elapsed(), 1, "seed");
+
+        const int nb = 10000;
+        NOMAD::RNG::set_compatibility_mode(true);
+        timer.restart();
+        for (int i = 0; i < nb; i++)
+            NOMAD::RNG::set_seed(s);
+        std::snprintf(name, sizeof(name), "compatibility, seed %d%s", s,
+                      (NOMAD::RNG::rand() == ref) ? "" : " DIFFERENT");
+        print_result(name, timer.elapsed(), nb, "seed");
+
+        NOMAD::RNG::set_compatibility_mode(false);
+        timer.restart();
+        for (int i = 0; i < nb; i++)
+            NOMAD::RNG::set_seed(s);
+        do_not_optimize(NOMAD::RNG::rand());
+        std::snprintf(name, sizeof(name), "mixed, seed %d", s);
+        print_result(name, timer.elapsed(), nb, "seed");
+    }
+
+    std::printf("Draws\n");
+    const int nb_draws = 100000000;
+    NOMAD::RNG::set_seed(1);
+    Timer timer;
+    uint32_t sum = 0;
+    for (int i = 0; i < nb_draws; i++)
+        sum += NOMAD::RNG::rand();
+    do_not_optimize(sum);
+    print_result("RNG::rand()", timer.elapsed(), nb_draws, "variate");
+
+    NOMAD::RandomGenerator g(1);
+    timer.restart();
+    sum = 0;
+    for (int i = 0; i < nb_draws; i++)
+        sum += g.rand();
+    do_not_optimize(sum);
+    print_result("RandomGenerator::rand()", timer.elapsed(), nb_draws, "variate");
+
+    const int nb_streams = 10000;
+    timer.restart();
+    for (int k = 0; k < nb_streams; k++)
+    {
+        NOMAD::RandomGenerator s = g.substream(k);
+        do_not_optimize(s);
+    }
+    print_result("substream(k)", timer.elapsed(), nb_streams, "stream");
+
+    // Variates
+    const int nb = 10000000;
+    std::vector<double> v(nb);
+    std::printf("Uniform variates in [-1,1], %d values\n", nb);
+    timer.restart();
+    for (int i = 0; i < nb; i++)
+        v[i] = NOMAD::RNG::rand(-1.0, 1.0);
+    do_not_optimize(v[0]);
+    print_result("RNG::rand(a,b)", timer.elapsed(), nb, "variate");
+
+    timer.restart();
+    for (int i = 0; i < nb; i++)
+        v[i] = g.rand(-1.0, 1.0);
+    do_not_optimize(v[0]);
+    print_result("RandomGenerator::rand(a,b)", timer.elapsed(), nb, "variate");
+
+    timer.restart();
+    g.fill_uniform(&v[0], nb, -1.0, 1.0);
+    do_not_optimize(v[0]);
+    print_result("fill_uniform(array)", timer.elapsed(), nb, "variate");
+
+    // In the cache: 4096 values, repeated
+    const int nb_small = 4096;
+    timer.restart();
+    for (int r = 0; r < nb / nb_small; r++)
+    {
+        for (int i = 0; i < nb_small; i++)
+            v[i] = g.rand(-1.0, 1.0);
+        do_not_optimize(v[0]);
+    }
+    print_result("RandomGenerator::rand(a,b), 4096 values", timer.elapsed(), nb / nb_small * nb_small, "variate");
+
+    timer.restart();
+    for (int r = 0; r < nb / nb_small; r++)
+    {
+        g.fill_uniform(&v[0], nb_small, -1.0, 1.0);
+        do_not_optimize(v[0]);
+    }
+    print_result("fill_uniform(array), 4096 values", timer.elapsed(), nb / nb_small * nb_small, "variate");
+
+    const int n = 100;
+    NOMAD::PointSet points(nb / n, n, NOMAD::SOA);
+    timer.restart();
+    g.fill_uniform(points, -1.0, 1.0);
+    do_not_optimize(points(0,0));
+    print_result("fill_uniform(PointSet)", timer.elapsed(), nb, "variate");
+
+    std::printf("Normal variates N(0,1), %d values\n", nb);
+    timer.restart();
+    for (int i = 0; i < nb; i++)
+        v[i] = NOMAD::RNG::normal_rand();
+    do_not_optimize(v[0]);
+    print_result("RNG::normal_rand() (Box-Muller)", timer.elapsed(), nb, "variate");
+
+    timer.restart();
+    for (int i = 0; i < nb; i++)
+        v[i] = NOMAD::RNG::normal_rand_mean_0();
+    do_not_optimize(v[0]);
+    print_result("RNG::normal_rand_mean_0() (12 sums)", timer.elapsed(), nb, "variate");
+
+    timer.restart();
+    g.fill_normal(&v[0], nb);
+    do_not_optimize(v[0]);
+    print_result("fill_normal(array) (ziggurat)", timer.elapsed(), nb, "variate");
+
+    timer.restart();
+    g.fill_normal(points);
+    do_not_optimize(points(0,0));
+    print_result("fill_normal(PointSet)", timer.elapsed(), nb, "variate");
+
+    return 0;
+}
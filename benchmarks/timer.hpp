@@ -0,0 +1,40 @@
+// Small helpers shared by the benchmarks.
+
+#ifndef __NOMAD400_BENCH_TIMER__
+#define __NOMAD400_BENCH_TIMER__
+
+#include <chrono>
+#include <cstdio>
+
+// Wall clock timer.
+class Timer
+{
+private:
+    std::chrono::steady_clock::time_point _start;
+
+public:
+    Timer() : _start(std::chrono::steady_clock::now()) {}
+
+    void restart() { _start = std::chrono::steady_clock::now(); }
+
+    // Elapsed time in seconds since construction or last restart.
+    double elapsed() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+    }
+};
+
+// Print one benchmark result line.
+inline void print_result(const char* name, double seconds, double nb_ops, const char* unit)
+{
+    std::printf("  %-40s %10.4f s %14.3e %s/s\n", name, seconds, nb_ops / seconds, unit);
+}
+
+// Keep the compiler from optimizing away a computed value.
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+#endif
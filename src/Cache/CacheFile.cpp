@@ -0,0 +1,374 @@
+/**
+ \file   CacheFile.cpp
+ \brief  Binary cache file, mapped in memory (implementation)
+ \see    CacheFile.hpp
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Cache/CacheFile.hpp"
+#include "Util/Exception.hpp"
+#include "Util/utils.hpp"
+
+const uint32_t NOMAD::CacheFile::VERSION;
+
+namespace {
+
+    /*-----------------------------------------------------------*/
+    /*                       header of the file                  */
+    /*-----------------------------------------------------------*/
+    // Followed by the m blackbox output types as int32_t, and padded to
+    // a multiple of 8 bytes, so that the records are aligned.
+    struct Header {
+        char     magic[8];     // MAGIC
+        uint32_t version;      // NOMAD::CacheFile::VERSION
+        uint32_t byte_order;   // BYTE_ORDER_MARK, as written by the machine
+        uint32_t header_size;  // Size of the header, in bytes
+        int32_t  n;            // Dimension of the points
+        int32_t  m;            // Number of outputs
+        int32_t  reserved;     // 0
+        double   epsilon;      // Epsilon of NOMAD::Double
+        uint64_t record_size;  // Size of a record, in bytes
+        uint64_t nb_records;   // Number of complete records
+    };
+
+    const char     MAGIC[8]        = { 'N' , 'O' , 'M' , 'A' , 'D' , 'C' , 'F' , '\0' };
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    // Size of the file when it is created
+    const size_t MIN_FILE_SIZE = 4096;
+
+    std::string error_str ( const std::string & file_name )
+    {
+        return file_name + ": " + strerror ( errno );
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                         constructor                       */
+/*-----------------------------------------------------------*/
+NOMAD::CacheFile::CacheFile ( void )
+  : _fd          ( -1    ) ,
+    _read_only   ( false ) ,
+    _map         ( NULL  ) ,
+    _map_size    ( 0     ) ,
+    _n           ( 0     ) ,
+    _m           ( 0     ) ,
+    _epsilon     ( 0.0   ) ,
+    _header_size ( 0     ) ,
+    _record_size ( 0     ) ,
+    _size        ( 0     )
+{
+}
+
+NOMAD::CacheFile::~CacheFile ( void )
+{
+    try
+    {
+        close();
+    }
+    catch ( ... )
+    {
+        release();
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                           mapping                         */
+/*-----------------------------------------------------------*/
+void NOMAD::CacheFile::map ( size_t map_size )
+{
+    if ( _map )
+        munmap ( _map , _map_size );
+    _map      = NULL;
+    _map_size = 0;
+
+    int   prot = ( _read_only ) ? PROT_READ : PROT_READ | PROT_WRITE;
+    void * map = mmap ( NULL , map_size , prot , MAP_SHARED , _fd , 0 );
+    if ( map == MAP_FAILED )
+    {
+        std::string err = error_str ( _file_name );
+        release();
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile: cannot map file " + err );
+    }
+    _map      = static_cast<char *> ( map );
+    _map_size = map_size;
+}
+
+void NOMAD::CacheFile::release ( void )
+{
+    if ( _map )
+        munmap ( _map , _map_size );
+    if ( _fd >= 0 )
+        ::close ( _fd );
+    _fd          = -1;
+    _read_only   = false;
+    _map         = NULL;
+    _map_size    = 0;
+    _n           = 0;
+    _m           = 0;
+    _epsilon     = 0.0;
+    _header_size = 0;
+    _record_size = 0;
+    _size        = 0;
+    _bbot.clear();
+    _file_name.clear();
+}
+
+/*-----------------------------------------------------------*/
+/*                           creation                        */
+/*-----------------------------------------------------------*/
+void NOMAD::CacheFile::create ( const std::string                        & file_name ,
+                                int                                        n         ,
+                                const std::vector<NOMAD::bb_output_type> & bbot      ,
+                                double                                     epsilon     )
+{
+    if ( n <= 0 || n > NOMAD::MAX_DIMENSION || !( epsilon > 0 ) )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::create(): bad dimension or epsilon" );
+    close();
+
+    _fd = ::open ( file_name.c_str() , O_RDWR | O_CREAT | O_TRUNC , 0644 );
+    if ( _fd < 0 )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::create(): cannot create file " + error_str ( file_name ) );
+
+    _file_name   = file_name;
+    _read_only   = false;
+    _n           = n;
+    _m           = static_cast<int> ( bbot.size() );
+    _epsilon     = epsilon;
+    _bbot        = bbot;
+    _header_size = ( sizeof ( Header ) + _m * sizeof ( int32_t ) + 7 ) / 8 * 8;
+    _record_size = ( _n + _m ) * sizeof ( NOMAD::Double );
+    _size        = 0;
+
+    size_t file_size = std::max ( MIN_FILE_SIZE , _header_size );
+    if ( ftruncate ( _fd , file_size ) != 0 )
+    {
+        std::string err = error_str ( file_name );
+        release();
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::create(): cannot resize file " + err );
+    }
+    map ( file_size );
+
+    Header * header = reinterpret_cast<Header *> ( _map );
+    memcpy ( header->magic , MAGIC , sizeof ( MAGIC ) );
+    header->version     = VERSION;
+    header->byte_order  = BYTE_ORDER_MARK;
+    header->header_size = static_cast<uint32_t> ( _header_size );
+    header->n           = _n;
+    header->m           = _m;
+    header->reserved    = 0;
+    header->epsilon     = _epsilon;
+    header->record_size = _record_size;
+    header->nb_records  = 0;
+
+    int32_t * types = reinterpret_cast<int32_t *> ( _map + sizeof ( Header ) );
+    for ( int j = 0 ; j < _m ; ++j )
+        types[j] = static_cast<int32_t> ( _bbot[j] );
+}
+
+/*-----------------------------------------------------------*/
+/*                            opening                        */
+/*-----------------------------------------------------------*/
+void NOMAD::CacheFile::open ( const std::string & file_name , bool read_only )
+{
+    close();
+
+    _fd = ::open ( file_name.c_str() , ( read_only ) ? O_RDONLY : O_RDWR );
+    if ( _fd < 0 )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::open(): cannot open file " + error_str ( file_name ) );
+    _file_name = file_name;
+    _read_only = read_only;
+
+    struct stat st;
+    if ( fstat ( _fd , &st ) != 0 || static_cast<size_t> ( st.st_size ) < sizeof ( Header ) )
+    {
+        release();
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::open(): not a cache file: " + file_name );
+    }
+    const size_t file_size = st.st_size;
+    map ( file_size );
+
+    // Check the header
+    const Header * header = reinterpret_cast<const Header *> ( _map );
+    std::string    error;
+    if ( memcmp ( header->magic , MAGIC , sizeof ( MAGIC ) ) != 0 )
+        error = "not a cache file";
+    else if ( header->byte_order != BYTE_ORDER_MARK )
+        error = "bad byte order";
+    else if ( header->version != VERSION )
+        error = "unsupported version " + NOMAD::itos ( static_cast<size_t> ( header->version ) );
+    else if ( header->n <= 0 || header->n > NOMAD::MAX_DIMENSION ||
+              header->m < 0  || header->m > NOMAD::MAX_DIMENSION ||
+              header->header_size != ( sizeof ( Header ) + header->m * sizeof ( int32_t ) + 7 ) / 8 * 8 ||
+              header->record_size != ( header->n + header->m ) * sizeof ( NOMAD::Double ) ||
+              header->header_size > file_size ||
+              header->nb_records > ( file_size - header->header_size ) / header->record_size ||
+              header->nb_records > static_cast<uint64_t> ( INT_MAX ) )
+        error = "corrupted header";
+    if ( !error.empty() )
+    {
+        release();
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::open(): " + error + ": " + file_name );
+    }
+
+    _n           = header->n;
+    _m           = header->m;
+    _epsilon     = header->epsilon;
+    _header_size = header->header_size;
+    _record_size = header->record_size;
+    _size        = static_cast<int> ( header->nb_records );
+
+    const int32_t * types = reinterpret_cast<const int32_t *> ( _map + sizeof ( Header ) );
+    _bbot.resize ( _m );
+    for ( int j = 0 ; j < _m ; ++j )
+        _bbot[j] = ( types[j] >= NOMAD::OBJ && types[j] <= NOMAD::UNDEFINED_BBO ) ?
+                   static_cast<NOMAD::bb_output_type> ( types[j] ) : NOMAD::UNDEFINED_BBO;
+}
+
+/*-----------------------------------------------------------*/
+/*                     flush and closing                     */
+/*-----------------------------------------------------------*/
+void NOMAD::CacheFile::flush ( void )
+{
+    if ( !is_open() || _read_only )
+        return;
+    if ( msync ( _map , _map_size , MS_SYNC ) != 0 )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::flush(): " + error_str ( _file_name ) );
+}
+
+void NOMAD::CacheFile::close ( void )
+{
+    if ( !is_open() )
+        return;
+
+    std::string err;
+    if ( !_read_only )
+    {
+        // The file loses the free space at its end.
+        size_t file_size = _header_size + _size * _record_size;
+        munmap ( _map , _map_size );
+        _map = NULL;
+        if ( ftruncate ( _fd , file_size ) != 0 || fsync ( _fd ) != 0 )
+            err = error_str ( _file_name );
+    }
+    release();
+
+    if ( !err.empty() )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::close(): " + err );
+}
+
+/*-----------------------------------------------------------*/
+/*                      adding a record                      */
+/*-----------------------------------------------------------*/
+int NOMAD::CacheFile::append ( const NOMAD::PointView & x , const NOMAD::PointView & outputs )
+{
+    if ( !is_open() || _read_only )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::append(): file not open for writing" );
+    if ( x.get_size() != _n || outputs.get_size() != _m )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::append(): bad dimensions" );
+    if ( _size == INT_MAX )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::append(): too many records" );
+
+    // Double the size of the file
+    size_t end = _header_size + ( _size + 1 ) * _record_size;
+    if ( end > _map_size )
+    {
+        size_t file_size = std::max ( end , 2 * _map_size );
+        if ( ftruncate ( _fd , file_size ) != 0 )
+            throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                    "NOMAD::CacheFile::append(): cannot resize file " +
+                                    error_str ( _file_name ) );
+        map ( file_size );
+    }
+
+    NOMAD::Double * rec = const_cast<NOMAD::Double *> ( record ( _size ) );
+    for ( int i = 0 ; i < _n ; ++i )
+        rec[i] = x[i];
+    for ( int j = 0 ; j < _m ; ++j )
+        rec[_n+j] = outputs[j];
+
+    // The record is complete before it is counted.
+    std::atomic_thread_fence ( std::memory_order_release );
+    reinterpret_cast<Header *> ( _map )->nb_records = _size + 1;
+    return _size++;
+}
+
+/*-----------------------------------------------------------*/
+/*                 loading in a cache of evaluations         */
+/*-----------------------------------------------------------*/
+int NOMAD::CacheFile::load ( NOMAD::EvalCache & cache ) const
+{
+    if ( cache.get_dimension() != _n || cache.get_nb_outputs() != _m )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::load(): bad dimensions" );
+    cache.reserve ( cache.size() + _size );
+
+    int nb_new = 0;
+    for ( int i = 0 ; i < _size ; ++i )
+        if ( cache.insert ( get_point ( i ) , get_outputs ( i ) ) )
+            ++nb_new;
+    return nb_new;
+}
+
+/*-----------------------------------------------------------*/
+/*                         text export                       */
+/*-----------------------------------------------------------*/
+void NOMAD::CacheFile::export_text ( std::ostream & out ) const
+{
+    if ( !is_open() )
+        throw NOMAD::Exception ( "CacheFile.cpp" , __LINE__ ,
+                                "NOMAD::CacheFile::export_text(): file not open" );
+
+    char buf[NOMAD::Double::STR_SIZE];
+    NOMAD::Double ( _epsilon ).snprint ( buf , sizeof ( buf ) , false , NOMAD::Double::SHORTEST_PRECISION );
+
+    out << "# NOMAD cache file version " << VERSION << std::endl
+        << "# DIMENSION " << _n << std::endl
+        << "# BB_OUTPUT_TYPE";
+    for ( int j = 0 ; j < _m ; ++j )
+        out << " " << NOMAD::bbot_to_string ( _bbot[j] );
+    out << std::endl
+        << "# EPSILON " << buf << std::endl
+        << "# RECORDS " << _size << std::endl;
+
+    std::string line;
+    for ( int r = 0 ; r < _size ; ++r )
+    {
+        const NOMAD::Double * rec = record ( r );
+        line = "(";
+        for ( int i = 0 ; i < _n ; ++i )
+        {
+            line += ' ';
+            rec[i].append_to ( line , false , NOMAD::Double::SHORTEST_PRECISION );
+        }
+        line += " )";
+        for ( int j = 0 ; j < _m ; ++j )
+        {
+            line += ' ';
+            rec[_n+j].append_to ( line , false , NOMAD::Double::SHORTEST_PRECISION );
+        }
+        line += '\n';
+        out << line;
+    }
+}
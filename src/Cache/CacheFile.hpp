@@ -0,0 +1,202 @@
+/**
+ \file   CacheFile.hpp
+ \brief  Binary cache file, mapped in memory (headers)
+ \see    CacheFile.cpp
+ */
+
+#ifndef __NOMAD400_CACHEFILE__
+#define __NOMAD400_CACHEFILE__
+
+#include <string>
+#include <vector>
+
+#include "Cache/EvalCache.hpp"
+#include "Math/PointView.hpp"
+#include "Util/Uncopyable.hpp"
+#include "Util/defines.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for a binary file of evaluations, mapped in memory.
+    /**
+     - The file starts with a header: a magic string, the version of the
+       format, the dimension \c n, the blackbox output types and the
+       epsilon of NOMAD::Double that was used by the run. It is followed
+       by records of fixed size: the \c n coordinates of a point and its
+       \c m outputs, as the 8 bytes of each NOMAD::Double.
+     - The values are stored in the byte order of the machine, which is
+       checked at the opening. Undefined values keep their bit pattern.
+     - The file is mapped with \c mmap(), so that opening it costs
+       \c O(1), and the pages are read by the system on the first access
+       to the records. Coordinates are not parsed.
+     - Records are appended at the end. The file grows by doubling, and
+       the number of records in the header is written after the record:
+       after a crash, an incomplete record is ignored. The file is
+       truncated to its exact size by close().
+     - POSIX only.
+    */
+    class CacheFile : private NOMAD::Uncopyable {
+    public:
+
+        /// Current version of the format.
+        static const uint32_t VERSION = 1;
+
+    private:
+
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        std::string                         _file_name;   // Name of the file
+        int                                 _fd;          // File descriptor, -1 if closed
+        bool                                _read_only;   // Read-only mapping
+        char                              * _map;         // Mapping of the file
+        size_t                              _map_size;    // Size of the mapping
+        int                                 _n;           // Dimension of the points
+        int                                 _m;           // Number of outputs
+        double                              _epsilon;     // Epsilon of the run
+        std::vector<NOMAD::bb_output_type>  _bbot;        // Blackbox output types
+        size_t                              _header_size; // Size of the header, in bytes
+        size_t                              _record_size; // Size of a record, in bytes
+        int                                 _size;        // Number of records
+
+        /// Map the first bytes of the file.
+        /**
+         \param map_size The size of the mapping, at most the size of the file -- \b IN.
+         */
+        void map ( size_t map_size );
+
+        /// Remove the mapping, and close the file without exception.
+        void release ( void );
+
+        /// Access to the record \c i.
+        const NOMAD::Double * record ( int i ) const
+        {
+            return reinterpret_cast<const NOMAD::Double *> ( _map + _header_size + i * _record_size );
+        }
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /// Constructor of a closed file.
+        CacheFile ( void );
+
+        /// Destructor.
+        /**
+         Closes the file.
+         */
+        ~CacheFile ( void );
+
+        /*-------*/
+        /* Files */
+        /*-------*/
+        /// Create a new file, or replace an existing file.
+        /**
+         \param file_name The name of the file -- \b IN.
+         \param n         The dimension of the points -- \b IN.
+         \param bbot      The blackbox output types -- \b IN.
+         \param epsilon   The epsilon of NOMAD::Double
+         -- \b IN -- \b optional (default = NOMAD::Double::get_epsilon()).
+         */
+        void create ( const std::string                        & file_name ,
+                      int                                        n         ,
+                      const std::vector<NOMAD::bb_output_type> & bbot      ,
+                      double                                     epsilon = NOMAD::Double::get_epsilon() );
+
+        /// Open an existing file.
+        /**
+         \param file_name The name of the file -- \b IN.
+         \param read_only Open the file for reading only
+         -- \b IN -- \b optional (default = \c false).
+         */
+        void open ( const std::string & file_name , bool read_only = false );
+
+        /// Write the modified pages to the disk.
+        void flush ( void );
+
+        /// Close the file.
+        /**
+         Does nothing if the file is not open.
+         */
+        void close ( void );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Is the file open ?
+        bool is_open ( void ) const { return _fd >= 0; }
+
+        /// Is the file open for reading only ?
+        bool is_read_only ( void ) const { return _read_only; }
+
+        /// Access to the name of the file.
+        const std::string & get_file_name ( void ) const { return _file_name; }
+
+        /// Access to the number of records.
+        int size ( void ) const { return _size; }
+
+        /// Access to the dimension of the points.
+        int get_dimension ( void ) const { return _n; }
+
+        /// Access to the number of outputs.
+        int get_nb_outputs ( void ) const { return _m; }
+
+        /// Access to the blackbox output types.
+        const std::vector<NOMAD::bb_output_type> & get_bb_output_type ( void ) const { return _bbot; }
+
+        /// Access to the epsilon of NOMAD::Double of the run.
+        double get_epsilon ( void ) const { return _epsilon; }
+
+        /// Access to the point of the record \c i.
+        /**
+         \param i The index of the record -- \b IN.
+         \return  The point, valid until the next append() or close().
+         */
+        NOMAD::PointView get_point ( int i ) const
+        {
+            return NOMAD::PointView ( record ( i ) , _n );
+        }
+
+        /// Access to the outputs of the record \c i.
+        /**
+         \param i The index of the record -- \b IN.
+         \return  The outputs, valid until the next append() or close().
+         */
+        NOMAD::PointView get_outputs ( int i ) const
+        {
+            return NOMAD::PointView ( record ( i ) + _n , _m );
+        }
+
+        /*---------*/
+        /* Records */
+        /*---------*/
+        /// Add a record at the end of the file.
+        /**
+         \param x       The point, of dimension \c get_dimension() -- \b IN.
+         \param outputs The outputs, of dimension \c get_nb_outputs() -- \b IN.
+         \return        The index of the record.
+         */
+        int append ( const NOMAD::PointView & x , const NOMAD::PointView & outputs );
+
+        /// Add all the records to a cache of evaluations.
+        /**
+         \param cache The cache, of the same dimensions -- \b IN/OUT.
+         \return      The number of points that were not in the cache.
+         */
+        int load ( NOMAD::EvalCache & cache ) const;
+
+        /// Write the file as text.
+        /**
+         - The header is written on lines starting with \c #.
+         - Each record is written on one line, as the coordinates in
+           parentheses followed by the outputs. The values are written
+           with the shortest digits that are read back as the same
+           \c double.
+         \param out The stream -- \b IN/OUT.
+         */
+        void export_text ( std::ostream & out ) const;
+    };
+
+#include "nomad_nsend.hpp"
+#endif
@@ -0,0 +1,141 @@
+/**
+ \file   EvalCache.cpp
+ \brief  Cache of the evaluations, hashed on the points (implementation)
+ \see    EvalCache.hpp
+ */
+
+#include "Cache/EvalCache.hpp"
+#include "Util/Exception.hpp"
+
+namespace {
+
+    // Initial size of the table
+    const size_t MIN_TABLE_SIZE = 16;
+}
+
+/*-----------------------------------------------------------*/
+/*                          constructor                      */
+/*-----------------------------------------------------------*/
+NOMAD::EvalCache::EvalCache ( int n , int m , const NOMAD::PointHash & hash )
+  : _n       ( n                     ) ,
+    _m       ( m                     ) ,
+    _hash    ( hash                  ) ,
+    _points  ( 0 , n , NOMAD::AOS    ) ,
+    _outputs ( 0 , m , NOMAD::AOS    ) ,
+    _table   (                       ) ,
+    _mask    ( 0                     )
+{
+    if ( n <= 0 || m < 0 )
+        throw NOMAD::Exception ( "EvalCache.cpp" , __LINE__ ,
+                                "NOMAD::EvalCache::EvalCache(): bad dimensions" );
+    rehash ( MIN_TABLE_SIZE );
+}
+
+/*-----------------------------------------------------------*/
+/*                         table management                  */
+/*-----------------------------------------------------------*/
+void NOMAD::EvalCache::add_slot ( uint64_t h , int index )
+{
+    uint64_t k = h & _mask;
+    while ( _table[k].index >= 0 )
+        k = ( k + 1 ) & _mask;
+    _table[k].hash  = h;
+    _table[k].index = index;
+}
+
+void NOMAD::EvalCache::rehash ( size_t table_size )
+{
+    Slot empty;
+    empty.hash  = 0;
+    empty.index = -1;
+    _table.assign ( table_size , empty );
+    _mask = table_size - 1;
+
+    for ( int i = 0 ; i < size() ; ++i )
+        add_slot ( _hash ( _points.row ( i ) ) , i );
+}
+
+void NOMAD::EvalCache::reserve ( int capacity )
+{
+    _points.reserve  ( capacity );
+    _outputs.reserve ( capacity );
+
+    // The load factor stays below 1/2
+    size_t table_size = _table.size();
+    while ( table_size < 2 * static_cast<size_t> ( capacity ) )
+        table_size *= 2;
+    if ( table_size > _table.size() )
+        rehash ( table_size );
+}
+
+void NOMAD::EvalCache::clear ( void )
+{
+    _points.clear();
+    _outputs.clear();
+    rehash ( _table.size() );
+}
+
+/*-----------------------------------------------------------*/
+/*                            lookup                         */
+/*-----------------------------------------------------------*/
+int NOMAD::EvalCache::find ( const NOMAD::PointView & x , uint64_t h ) const
+{
+    for ( uint64_t k = h & _mask ; _table[k].index >= 0 ; k = ( k + 1 ) & _mask )
+        if ( _table[k].hash == h && NOMAD::PointView ( _points.row ( _table[k].index ) ) == x )
+            return _table[k].index;
+    return -1;
+}
+
+int NOMAD::EvalCache::find ( const NOMAD::PointView & x ) const
+{
+    if ( x.get_size() != _n )
+        return -1;
+
+    // A point may be equal to points in the neighbour cells:
+    // all their hashes are probed
+    uint64_t keys[NOMAD::PointHash::MAX_KEYS];
+    int nb_keys = _hash.keys ( x , keys );
+    for ( int s = 0 ; s < nb_keys ; ++s )
+    {
+        int index = find ( x , keys[s] );
+        if ( index >= 0 )
+            return index;
+    }
+
+    // Too many coordinates near a cell boundary: full scan
+    if ( nb_keys < 0 )
+        for ( int i = 0 ; i < size() ; ++i )
+            if ( NOMAD::PointView ( _points.row ( i ) ) == x )
+                return i;
+
+    return -1;
+}
+
+bool NOMAD::EvalCache::find ( const NOMAD::PointView & x , NOMAD::PointView & outputs ) const
+{
+    int index = find ( x );
+    if ( index < 0 )
+        return false;
+    outputs = get_outputs ( index );
+    return true;
+}
+
+/*-----------------------------------------------------------*/
+/*                           insertion                       */
+/*-----------------------------------------------------------*/
+bool NOMAD::EvalCache::insert ( const NOMAD::PointView & x , const NOMAD::PointView & outputs )
+{
+    if ( x.get_size() != _n || outputs.get_size() != _m )
+        throw NOMAD::Exception ( "EvalCache.cpp" , __LINE__ ,
+                                "NOMAD::EvalCache::insert(): bad dimensions" );
+    if ( find ( x ) >= 0 )
+        return false;
+
+    if ( 2 * static_cast<size_t> ( size() + 1 ) > _table.size() )
+        rehash ( 2 * _table.size() );
+
+    _points.add_point  ( x );
+    _outputs.add_point ( outputs );
+    add_slot ( _hash ( x ) , size() - 1 );
+    return true;
+}
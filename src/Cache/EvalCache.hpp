@@ -0,0 +1,153 @@
+/**
+ \file   EvalCache.hpp
+ \brief  Cache of the evaluations, hashed on the points
+ \see    EvalCache.cpp
+ */
+
+#ifndef __NOMAD400_EVALCACHE__
+#define __NOMAD400_EVALCACHE__
+
+#include <vector>
+
+#include "Math/PointHash.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/PointView.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the cache of the blackbox evaluations.
+    /**
+     - Maps points of dimension \c n to their \c m blackbox outputs.
+     - The points and the outputs are stored in two NOMAD::PointSet, in
+       the order of insertion. An open addressing table with linear
+       probing stores the hash and the index of each point.
+     - Points are compared with NOMAD::Point::operator==(). The hash is a
+       NOMAD::PointHash, so that a lookup costs a few hash probes instead
+       of \c O(log(size)) comparisons in an ordered tree.
+     - Evaluations are never removed, except by clear().
+    */
+    class EvalCache {
+    private:
+
+        /// Entry of the table.
+        struct Slot {
+            uint64_t hash;  // Hash of the point
+            int      index; // Index of the point, -1 for an empty slot
+        };
+
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        int               _n;         // Dimension of the points
+        int               _m;         // Number of outputs
+        NOMAD::PointHash  _hash;      // Hash of the points
+        NOMAD::PointSet   _points;    // Points, in the order of insertion
+        NOMAD::PointSet   _outputs;   // Outputs of the points
+        std::vector<Slot> _table;     // Open addressing table
+        uint64_t          _mask;      // Size of the table minus 1
+
+        /// Index of a point with a given hash.
+        /**
+         \param x The point -- \b IN.
+         \param h The hash -- \b IN.
+         \return  The index of the point, or \c -1.
+         */
+        int find ( const NOMAD::PointView & x , uint64_t h ) const;
+
+        /// Add a hash in the table.
+        /**
+         \param h     The hash -- \b IN.
+         \param index The index of the point -- \b IN.
+         */
+        void add_slot ( uint64_t h , int index );
+
+        /// Resize the table and add all the points again.
+        /**
+         \param table_size The size of the table, a power of 2 -- \b IN.
+         */
+        void rehash ( size_t table_size );
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /**
+         \param n    Dimension of the points -- \b IN.
+         \param m    Number of outputs -- \b IN.
+         \param hash Hash of the points
+         -- \b IN -- \b optional (default = PointHash()).
+         */
+        EvalCache ( int n , int m , const NOMAD::PointHash & hash = NOMAD::PointHash() );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the number of evaluations.
+        int size ( void ) const { return _points.get_nb_points(); }
+
+        /// Access to the dimension of the points.
+        int get_dimension ( void ) const { return _n; }
+
+        /// Access to the number of outputs.
+        int get_nb_outputs ( void ) const { return _m; }
+
+        /// Access to the hash of the points.
+        const NOMAD::PointHash & get_hash ( void ) const { return _hash; }
+
+        /// Access to the point \c i.
+        /**
+         \param i The index of the evaluation -- \b IN.
+         \return  The point, valid until the next insertion.
+         */
+        NOMAD::PointView get_point ( int i ) const { return _points.row ( i ); }
+
+        /// Access to the outputs of the point \c i.
+        /**
+         \param i The index of the evaluation -- \b IN.
+         \return  The outputs, valid until the next insertion.
+         */
+        NOMAD::PointView get_outputs ( int i ) const { return _outputs.row ( i ); }
+
+        /// Access to all the points.
+        const NOMAD::PointSet & get_points ( void ) const { return _points; }
+
+        /// Reserve space for evaluations.
+        /**
+         \param capacity The number of evaluations -- \b IN.
+         */
+        void reserve ( int capacity );
+
+        /// Remove all the evaluations.
+        void clear ( void );
+
+        /*--------*/
+        /* Lookup */
+        /*--------*/
+        /// Index of a point.
+        /**
+         \param x The point -- \b IN.
+         \return  The index of an evaluation at a point equal to \c x, or \c -1.
+         */
+        int find ( const NOMAD::PointView & x ) const;
+
+        /// Outputs of a point.
+        /**
+         \param x       The point -- \b IN.
+         \param outputs The outputs, if the point is in the cache -- \b OUT.
+         \return        A boolean equal to \c true if the point is in the cache.
+         */
+        bool find ( const NOMAD::PointView & x , NOMAD::PointView & outputs ) const;
+
+        /// Add an evaluation.
+        /**
+         \param x       The point, of dimension \c get_dimension() -- \b IN.
+         \param outputs The outputs, of dimension \c get_nb_outputs() -- \b IN.
+         \return        A boolean equal to \c false if the point was already
+                        in the cache; its outputs are then unchanged.
+         */
+        bool insert ( const NOMAD::PointView & x , const NOMAD::PointView & outputs );
+    };
+
+#include "nomad_nsend.hpp"
+#endif
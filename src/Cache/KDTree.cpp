@@ -0,0 +1,431 @@
+/**
+ \file   KDTree.cpp
+ \brief  k-d tree over points, for radius and nearest neighbor queries (implementation)
+ \see    KDTree.hpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include "Cache/KDTree.hpp"
+#include "Util/Exception.hpp"
+
+const int NOMAD::KDTree::LEAF_SIZE;
+const int NOMAD::KDTree::BUFFER_SIZE;
+
+namespace {
+
+    /*-----------------------------------------------------------*/
+    /*                            norms                          */
+    /*-----------------------------------------------------------*/
+    // The distances are accumulated as the sum of the |d_i| (L1), the sum
+    // of the d_i^2 (L2), or the max of the |d_i| (LINF). update() replaces
+    // the term of one coordinate in a lower bound of the distance.
+    template < NOMAD::hnorm_type TYPE >
+    struct Norm {
+        static double term    ( double d )                         { return std::fabs ( d ); }
+        static double combine ( double a , double b )              { return a + b; }
+        static double update  ( double r , double old , double t ) { return r - old + t; }
+        static double from_dist ( double d )                       { return d; }
+    };
+
+    template <>
+    struct Norm < NOMAD::L2 > {
+        static double term    ( double d )                         { return d * d; }
+        static double combine ( double a , double b )              { return a + b; }
+        static double update  ( double r , double old , double t ) { return r - old + t; }
+        static double from_dist ( double d )                       { return d * d; }
+    };
+
+    template <>
+    struct Norm < NOMAD::LINF > {
+        static double term    ( double d )                         { return std::fabs ( d ); }
+        static double combine ( double a , double b )              { return std::max ( a , b ); }
+        static double update  ( double r , double   , double t )   { return std::max ( r , t ); }
+        static double from_dist ( double d )                       { return d; }
+    };
+
+    /*-----------------------------------------------------------*/
+    /*                     results of the queries                */
+    /*-----------------------------------------------------------*/
+    // Points within a fixed bound.
+    class Ball {
+    private:
+        double             _bound;
+        std::vector<int> & _ids;
+    public:
+        Ball ( double bound , std::vector<int> & ids ) : _bound ( bound ) , _ids ( ids ) {}
+        double bound ( void ) const { return _bound; }
+        void add ( int id , double r ) { if ( r <= _bound ) _ids.push_back ( id ); }
+    };
+
+    // k nearest points, in a max-heap on the distance.
+    class Nearest {
+    private:
+        size_t                                _k;
+        std::vector< std::pair<double,int> >  _heap;
+    public:
+        explicit Nearest ( int k ) : _k ( k ) { _heap.reserve ( k ); }
+        double bound ( void ) const
+        {
+            return ( _heap.size() < _k ) ? std::numeric_limits<double>::infinity() : _heap.front().first;
+        }
+        void add ( int id , double r )
+        {
+            if ( _heap.size() < _k )
+            {
+                _heap.push_back ( std::make_pair ( r , id ) );
+                std::push_heap ( _heap.begin() , _heap.end() );
+            }
+            else if ( r < _heap.front().first )
+            {
+                std::pop_heap ( _heap.begin() , _heap.end() );
+                _heap.back() = std::make_pair ( r , id );
+                std::push_heap ( _heap.begin() , _heap.end() );
+            }
+        }
+        std::vector< std::pair<double,int> > & sorted ( void )
+        {
+            std::sort_heap ( _heap.begin() , _heap.end() );
+            return _heap;
+        }
+    };
+
+    /*-----------------------------------------------------------*/
+    /*                   search in a tree or a buffer            */
+    /*-----------------------------------------------------------*/
+    template < NOMAD::hnorm_type TYPE , typename RESULT >
+    class Search {
+    private:
+        const double * _q;          // Query point
+        const double * _inv_scale;  // Inverses of the scaling
+        int            _n;          // Dimension
+        RESULT       & _result;     // Points found
+
+        // Tree being searched
+        const int    * _ids;
+        const double * _coords;
+        const int    * _split_dims;
+        int            _leaf_size;
+        double       * _off;        // Distance of the query to the cell, per coordinate
+
+    public:
+        Search ( const double * q , const double * inv_scale , int n , RESULT & result ,
+                 double * off , int leaf_size )
+          : _q ( q ) , _inv_scale ( inv_scale ) , _n ( n ) , _result ( result ) ,
+            _ids ( NULL ) , _coords ( NULL ) , _split_dims ( NULL ) ,
+            _leaf_size ( leaf_size ) , _off ( off ) {}
+
+        // Distance to the point with coordinates x, abandoned when larger
+        // than the bound.
+        void visit ( int id , const double * x )
+        {
+            const double bound = _result.bound();
+            double r = 0.0;
+            for ( int i = 0 ; i < _n ; ++i )
+            {
+                r = Norm<TYPE>::combine ( r , Norm<TYPE>::term ( ( _q[i] - x[i] ) * _inv_scale[i] ) );
+                if ( r > bound )
+                    return;
+            }
+            _result.add ( id , r );
+        }
+
+        // Subtree of the points [lo,hi), at a lower bound r of the distance.
+        void run ( int lo , int hi , double r )
+        {
+            if ( hi - lo <= _leaf_size )
+            {
+                for ( int j = lo ; j < hi ; ++j )
+                    visit ( _ids[j] , _coords + static_cast<size_t> ( j ) * _n );
+                return;
+            }
+
+            const int    mid  = lo + ( hi - lo ) / 2;
+            const int    d    = _split_dims[mid];
+            const double diff = ( _q[d] - _coords[static_cast<size_t> ( mid ) * _n + d] ) * _inv_scale[d];
+
+            // Near side first, then the median, then the far side if the
+            // bound on its distance is not larger than the current bound.
+            if ( diff < 0 )
+                run ( lo , mid , r );
+            else
+                run ( mid + 1 , hi , r );
+
+            visit ( _ids[mid] , _coords + static_cast<size_t> ( mid ) * _n );
+
+            const double old = _off[d];
+            const double t   = Norm<TYPE>::term ( diff );
+            const double r2  = Norm<TYPE>::update ( r , old , t );
+            if ( r2 <= _result.bound() )
+            {
+                _off[d] = t;
+                if ( diff < 0 )
+                    run ( mid + 1 , hi , r2 );
+                else
+                    run ( lo , mid , r2 );
+                _off[d] = old;
+            }
+        }
+
+        void tree ( const int * ids , const double * coords , const int * split_dims , int size )
+        {
+            _ids        = ids;
+            _coords     = coords;
+            _split_dims = split_dims;
+            std::fill ( _off , _off + _n , 0.0 );
+            run ( 0 , size , 0.0 );
+        }
+    };
+
+    // Order of the points on one coordinate.
+    class Coordinate_Less {
+    private:
+        const double * _x;
+        int            _n;
+        int            _d;
+    public:
+        Coordinate_Less ( const double * x , int n , int d ) : _x ( x ) , _n ( n ) , _d ( d ) {}
+        bool operator () ( int i , int j ) const
+        {
+            return _x[static_cast<size_t> ( i ) * _n + _d] < _x[static_cast<size_t> ( j ) * _n + _d];
+        }
+    };
+}
+
+/*-----------------------------------------------------------*/
+/*                          constructor                      */
+/*-----------------------------------------------------------*/
+NOMAD::KDTree::KDTree ( int n )
+  : _n      ( n                  ) ,
+    _points ( 0 , n , NOMAD::AOS ) ,
+    _buffer (                    ) ,
+    _trees  (                    )
+{
+    if ( n <= 0 )
+        throw NOMAD::Exception ( "KDTree.cpp" , __LINE__ ,
+                                "NOMAD::KDTree::KDTree(): bad dimension" );
+    _buffer.reserve ( BUFFER_SIZE );
+}
+
+/*-----------------------------------------------------------*/
+/*                        build of a tree                    */
+/*-----------------------------------------------------------*/
+void NOMAD::KDTree::build ( const std::vector<int> & ids , Tree & tree ) const
+{
+    tree.ids = ids;
+    tree.split_dims.assign ( ids.size() , -1 );
+    build ( tree , 0 , static_cast<int> ( ids.size() ) );
+
+    // Coordinates in the order of the tree, for the locality of the queries
+    const double * x = reinterpret_cast<const double *> ( _points.data() );
+    tree.coords.resize ( ids.size() * _n );
+    for ( size_t j = 0 ; j < ids.size() ; ++j )
+        std::copy ( x + static_cast<size_t> ( tree.ids[j] ) * _n ,
+                    x + static_cast<size_t> ( tree.ids[j] + 1 ) * _n ,
+                    tree.coords.begin() + j * _n );
+}
+
+void NOMAD::KDTree::build ( Tree & tree , int lo , int hi ) const
+{
+    if ( hi - lo <= LEAF_SIZE )
+        return;
+
+    // Split on the coordinate of largest spread
+    const double * x = reinterpret_cast<const double *> ( _points.data() );
+    int    d      = 0;
+    double spread = -1.0;
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        double xmin = x[static_cast<size_t> ( tree.ids[lo] ) * _n + i] , xmax = xmin;
+        for ( int j = lo + 1 ; j < hi ; ++j )
+        {
+            double v = x[static_cast<size_t> ( tree.ids[j] ) * _n + i];
+            xmin = std::min ( xmin , v );
+            xmax = std::max ( xmax , v );
+        }
+        if ( xmax - xmin > spread )
+        {
+            spread = xmax - xmin;
+            d      = i;
+        }
+    }
+
+    const int mid = lo + ( hi - lo ) / 2;
+    std::nth_element ( tree.ids.begin() + lo , tree.ids.begin() + mid , tree.ids.begin() + hi ,
+                       Coordinate_Less ( x , _n , d ) );
+    tree.split_dims[mid] = d;
+
+    build ( tree , lo      , mid );
+    build ( tree , mid + 1 , hi  );
+}
+
+/*-----------------------------------------------------------*/
+/*                            insertion                      */
+/*-----------------------------------------------------------*/
+int NOMAD::KDTree::insert ( const NOMAD::PointView & x )
+{
+    if ( x.get_size() != _n )
+        throw NOMAD::Exception ( "KDTree.cpp" , __LINE__ ,
+                                "NOMAD::KDTree::insert(): bad dimensions" );
+    for ( int i = 0 ; i < _n ; ++i )
+        if ( !x[i].is_defined() )
+            throw NOMAD::Exception ( "KDTree.cpp" , __LINE__ ,
+                                    "NOMAD::KDTree::insert(): undefined coordinate" );
+
+    int id = size();
+    _points.add_point ( x );
+    _buffer.push_back ( id );
+    if ( static_cast<int> ( _buffer.size() ) < BUFFER_SIZE )
+        return id;
+
+    // Merge the buffer and the trees 0, 1, ..., l-1 into the tree l,
+    // as the carry of a binary counter
+    std::vector<int> ids;
+    ids.swap ( _buffer );
+    size_t l = 0;
+    for ( ; l < _trees.size() && !_trees[l].ids.empty() ; ++l )
+    {
+        ids.insert ( ids.end() , _trees[l].ids.begin() , _trees[l].ids.end() );
+        _trees[l] = Tree();
+    }
+    if ( l == _trees.size() )
+        _trees.push_back ( Tree() );
+    build ( ids , _trees[l] );
+
+    _buffer.reserve ( BUFFER_SIZE );
+    return id;
+}
+
+void NOMAD::KDTree::clear ( void )
+{
+    _points.clear();
+    _buffer.clear();
+    _trees.clear();
+}
+
+/*-----------------------------------------------------------*/
+/*                             queries                       */
+/*-----------------------------------------------------------*/
+void NOMAD::KDTree::prepare ( const NOMAD::PointView & x         ,
+                              const NOMAD::PointView & scale     ,
+                              std::vector<double>    & q         ,
+                              std::vector<double>    & inv_scale   ) const
+{
+    if ( x.get_size() != _n || ( scale.get_size() != 0 && scale.get_size() != _n ) )
+        throw NOMAD::Exception ( "KDTree.cpp" , __LINE__ ,
+                                "NOMAD::KDTree: bad dimensions" );
+
+    q.resize ( _n );
+    inv_scale.assign ( _n , 1.0 );
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        q[i] = x[i].todouble();
+        if ( scale.get_size() > 0 )
+        {
+            if ( !( scale[i] > 0.0 ) )
+                throw NOMAD::Exception ( "KDTree.cpp" , __LINE__ ,
+                                        "NOMAD::KDTree: the scaling must be positive" );
+            inv_scale[i] = 1.0 / scale[i].todouble();
+        }
+    }
+}
+
+namespace {
+
+    // Search in the buffer and in all the trees.
+    template < NOMAD::hnorm_type TYPE , typename RESULT , typename TREES >
+    void search_all ( const std::vector<double> & q         ,
+                      const std::vector<double> & inv_scale ,
+                      const double              * points    ,
+                      const std::vector<int>    & buffer    ,
+                      const TREES               & trees     ,
+                      int                         leaf_size ,
+                      RESULT                    & result      )
+    {
+        const int n = static_cast<int> ( q.size() );
+        std::vector<double> off ( n );
+        Search<TYPE,RESULT> search ( &q[0] , &inv_scale[0] , n , result , &off[0] , leaf_size );
+
+        for ( size_t j = 0 ; j < buffer.size() ; ++j )
+            search.visit ( buffer[j] , points + static_cast<size_t> ( buffer[j] ) * n );
+
+        for ( size_t l = 0 ; l < trees.size() ; ++l )
+            if ( !trees[l].ids.empty() )
+                search.tree ( &trees[l].ids[0] , &trees[l].coords[0] , &trees[l].split_dims[0] ,
+                              static_cast<int> ( trees[l].ids.size() ) );
+    }
+}
+
+void NOMAD::KDTree::radius_search ( const NOMAD::PointView & x      ,
+                                    const NOMAD::Double    & radius ,
+                                    std::vector<int>       & ids    ,
+                                    const NOMAD::PointView & scale  ,
+                                    NOMAD::hnorm_type        type     ) const
+{
+    std::vector<double> q , inv_scale;
+    prepare ( x , scale , q , inv_scale );
+    ids.clear();
+
+    const double * points = reinterpret_cast<const double *> ( _points.data() );
+    const double   r      = radius.todouble();
+    switch ( type )
+    {
+        case NOMAD::L1:
+        {
+            Ball ball ( Norm<NOMAD::L1>::from_dist ( r ) , ids );
+            search_all<NOMAD::L1> ( q , inv_scale , points , _buffer , _trees , LEAF_SIZE , ball );
+            break;
+        }
+        case NOMAD::LINF:
+        {
+            Ball ball ( Norm<NOMAD::LINF>::from_dist ( r ) , ids );
+            search_all<NOMAD::LINF> ( q , inv_scale , points , _buffer , _trees , LEAF_SIZE , ball );
+            break;
+        }
+        default:
+        {
+            Ball ball ( Norm<NOMAD::L2>::from_dist ( r ) , ids );
+            search_all<NOMAD::L2> ( q , inv_scale , points , _buffer , _trees , LEAF_SIZE , ball );
+        }
+    }
+}
+
+void NOMAD::KDTree::nearest ( const NOMAD::PointView     & x     ,
+                              int                          k     ,
+                              std::vector<int>           & ids   ,
+                              std::vector<NOMAD::Double> * dists ,
+                              const NOMAD::PointView     & scale ,
+                              NOMAD::hnorm_type            type    ) const
+{
+    std::vector<double> q , inv_scale;
+    prepare ( x , scale , q , inv_scale );
+    ids.clear();
+    if ( dists )
+        dists->clear();
+    if ( k <= 0 || size() == 0 )
+        return;
+
+    const double * points = reinterpret_cast<const double *> ( _points.data() );
+    Nearest result ( std::min ( k , size() ) );
+    switch ( type )
+    {
+        case NOMAD::L1:
+            search_all<NOMAD::L1>   ( q , inv_scale , points , _buffer , _trees , LEAF_SIZE , result );
+            break;
+        case NOMAD::LINF:
+            search_all<NOMAD::LINF> ( q , inv_scale , points , _buffer , _trees , LEAF_SIZE , result );
+            break;
+        default:
+            search_all<NOMAD::L2>   ( q , inv_scale , points , _buffer , _trees , LEAF_SIZE , result );
+    }
+
+    const std::vector< std::pair<double,int> > & found = result.sorted();
+    for ( size_t j = 0 ; j < found.size() ; ++j )
+    {
+        ids.push_back ( found[j].second );
+        if ( dists )
+            dists->push_back ( ( type == NOMAD::L2 ) ? std::sqrt ( found[j].first ) : found[j].first );
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ \file   KDTree.hpp
+ \brief  k-d tree over points, for radius and nearest neighbor queries
+ \see    KDTree.cpp
+ */
+
+#ifndef __NOMAD400_KDTREE__
+#define __NOMAD400_KDTREE__
+
+#include <vector>
+
+#include "Math/Double.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/PointView.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for a spatial index over points: radius and k-nearest queries.
+    /**
+     - Points are inserted one by one and identified by their order of
+       insertion. They are copied in a NOMAD::PointSet.
+     - Insertion is amortized \c O(log^2(size)): new points go to a small
+       buffer, and full buffers are merged with the trees of the same size
+       into a balanced k-d tree of twice the size (logarithmic method).
+       There are at most \c log2(size) trees.
+     - Each tree is built by median splits on the coordinate of largest
+       spread. The coordinates are copied in the order of the tree, and the
+       leaves of \c LEAF_SIZE points are scanned linearly.
+     - Queries use the norm of the scaled vector \c (x-y)/scale, with
+       L1, L2 or LINF norms, and prune the subtrees that are farther than
+       the radius or than the current \c k-th neighbor.
+     - Distances are computed with \c double values, without epsilon.
+       Points must be defined.
+     */
+    class KDTree {
+    public:
+
+        /// Max number of points in a leaf.
+        static const int LEAF_SIZE = 16;
+
+        /// Size of the buffer of new points, and of the smallest tree.
+        static const int BUFFER_SIZE = 4 * LEAF_SIZE;
+
+    private:
+
+        /// Balanced k-d tree of a fixed set of points.
+        struct Tree {
+            std::vector<int>    ids;        // Points, in the order of the tree
+            std::vector<double> coords;     // Coordinates, in the order of the tree
+            std::vector<int>    split_dims; // Split coordinate of each node, at its median
+        };
+
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        int                 _n;         // Dimension of the points
+        NOMAD::PointSet     _points;    // Points, in the order of insertion
+        std::vector<int>    _buffer;    // Points not in a tree yet
+        std::vector<Tree>   _trees;     // Tree l has BUFFER_SIZE*2^l points or is empty
+
+        /// Build a tree.
+        /**
+         \param ids  The points -- \b IN.
+         \param tree The tree -- \b OUT.
+         */
+        void build ( const std::vector<int> & ids , Tree & tree ) const;
+
+        /// Build the subtree of the points \c [lo,hi) of a tree.
+        /**
+         \param tree The tree -- \b IN/OUT.
+         \param lo   The first point -- \b IN.
+         \param hi   The end of the points -- \b IN.
+         */
+        void build ( Tree & tree , int lo , int hi ) const;
+
+        /// Scaling of a query.
+        /**
+         \param x         The query point -- \b IN.
+         \param scale     The scaling, or an empty view -- \b IN.
+         \param q         The coordinates of \c x -- \b OUT.
+         \param inv_scale The inverses of the scaling -- \b OUT.
+         */
+        void prepare ( const NOMAD::PointView    & x         ,
+                       const NOMAD::PointView    & scale     ,
+                       std::vector<double>       & q         ,
+                       std::vector<double>       & inv_scale   ) const;
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /**
+         \param n Dimension of the points -- \b IN.
+         */
+        explicit KDTree ( int n );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the number of points.
+        int size ( void ) const { return _points.get_nb_points(); }
+
+        /// Access to the dimension of the points.
+        int get_dimension ( void ) const { return _n; }
+
+        /// Access to the point \c id.
+        /**
+         \param id The index of the point, in the order of insertion -- \b IN.
+         \return   The point, valid until the next insertion.
+         */
+        NOMAD::PointView get_point ( int id ) const { return _points.row ( id ); }
+
+        /// Add a point.
+        /**
+         \param x The point, of dimension \c get_dimension(), defined -- \b IN.
+         \return  The index of the point.
+         */
+        int insert ( const NOMAD::PointView & x );
+
+        /// Remove all the points.
+        void clear ( void );
+
+        /*---------*/
+        /* Queries */
+        /*---------*/
+        /// Points in a ball.
+        /**
+         \param x      The center -- \b IN.
+         \param radius The radius -- \b IN.
+         \param ids    The indices of the points at a distance of at most
+                       \c radius from \c x, in no particular order -- \b OUT.
+         \param scale  The scaling of the coordinates, positive, or an empty
+                       view for no scaling -- \b IN -- \b optional (default = empty).
+         \param type   The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         */
+        void radius_search ( const NOMAD::PointView & x                          ,
+                             const NOMAD::Double    & radius                     ,
+                             std::vector<int>       & ids                        ,
+                             const NOMAD::PointView & scale = NOMAD::PointView() ,
+                             NOMAD::hnorm_type        type  = NOMAD::L2            ) const;
+
+        /// Nearest neighbors.
+        /**
+         \param x     The query point -- \b IN.
+         \param k     The number of neighbors -- \b IN.
+         \param ids   The indices of the \c min(k,size()) nearest points, by
+                      increasing distance -- \b OUT.
+         \param dists The distances, or \c NULL -- \b OUT -- \b optional (default = NULL).
+         \param scale The scaling of the coordinates, positive, or an empty
+                      view for no scaling -- \b IN -- \b optional (default = empty).
+         \param type  The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         */
+        void nearest ( const NOMAD::PointView     & x                          ,
+                       int                          k                          ,
+                       std::vector<int>           & ids                        ,
+                       std::vector<NOMAD::Double> * dists = NULL               ,
+                       const NOMAD::PointView     & scale = NOMAD::PointView() ,
+                       NOMAD::hnorm_type            type  = NOMAD::L2            ) const;
+    };
+
+#include "nomad_nsend.hpp"
+#endif
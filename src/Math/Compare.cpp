@@ -0,0 +1,222 @@
+/**
+ \file   Compare.cpp
+ \brief  Vectorized comparisons of arrays of reals (implementation)
+ \see    Compare.hpp
+ */
+
+#include <cmath>
+#include "Math/Compare.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define NOMAD_COMPARE_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    /*-----------------------------------------------------------*/
+    /*                         scalar kernels                    */
+    /*-----------------------------------------------------------*/
+    // Same tests as NOMAD::Double::operator==() and operator<(), on the
+    // values. NaN fails all the comparisons.
+    inline bool not_equal ( double a , double b , double eps )
+    {
+        return !( std::fabs ( a - b ) < eps );
+    }
+
+    inline bool ordered ( double a , double b , double eps )
+    {
+        return a < b - eps || a > b + eps || a != a || b != b;
+    }
+
+    int first_not_equal_scalar ( const double * x , const double * y , int n , double eps )
+    {
+        for ( int i = 0 ; i < n ; ++i )
+            if ( not_equal ( x[i] , y[i] , eps ) )
+                return i;
+        return n;
+    }
+
+    int first_ordered_scalar ( const double * x , const double * y , int n , double eps )
+    {
+        for ( int i = 0 ; i < n ; ++i )
+            if ( ordered ( x[i] , y[i] , eps ) )
+                return i;
+        return n;
+    }
+
+#ifdef NOMAD_COMPARE_X86
+
+    /*-----------------------------------------------------------*/
+    /*                          SSE2 kernels                     */
+    /*-----------------------------------------------------------*/
+    // SSE2 is part of x86-64: no check of the processor.
+    int first_not_equal_sse2 ( const double * x , const double * y , int n , double eps )
+    {
+        const __m128d veps = _mm_set1_pd ( eps );
+        const __m128d mabs = _mm_castsi128_pd ( _mm_set1_epi64x ( 0x7FFFFFFFFFFFFFFFLL ) );
+        int i = 0;
+        for ( ; i + 2 <= n ; i += 2 )
+        {
+            __m128d d = _mm_and_pd ( _mm_sub_pd ( _mm_loadu_pd ( x + i ) , _mm_loadu_pd ( y + i ) ) , mabs );
+            int mask  = _mm_movemask_pd ( _mm_cmpnlt_pd ( d , veps ) );
+            if ( mask )
+                return i + __builtin_ctz ( mask );
+        }
+        return i + first_not_equal_scalar ( x + i , y + i , n - i , eps );
+    }
+
+    int first_ordered_sse2 ( const double * x , const double * y , int n , double eps )
+    {
+        const __m128d veps = _mm_set1_pd ( eps );
+        int i = 0;
+        for ( ; i + 2 <= n ; i += 2 )
+        {
+            __m128d a = _mm_loadu_pd ( x + i );
+            __m128d b = _mm_loadu_pd ( y + i );
+            __m128d m = _mm_or_pd ( _mm_or_pd ( _mm_cmplt_pd ( a , _mm_sub_pd ( b , veps ) ) ,
+                                                _mm_cmpgt_pd ( a , _mm_add_pd ( b , veps ) ) ) ,
+                                    _mm_cmpunord_pd ( a , b ) );
+            int mask = _mm_movemask_pd ( m );
+            if ( mask )
+                return i + __builtin_ctz ( mask );
+        }
+        return i + first_ordered_scalar ( x + i , y + i , n - i , eps );
+    }
+
+    /*-----------------------------------------------------------*/
+    /*                          AVX2 kernels                     */
+    /*-----------------------------------------------------------*/
+    // Compiled for AVX2 whatever the flags of the library, and called
+    // only if the processor supports it. Two blocks of 4 values are
+    // tested per iteration.
+    __attribute__((target("avx2")))
+    int first_not_equal_avx2 ( const double * x , const double * y , int n , double eps )
+    {
+        const __m256d veps = _mm256_set1_pd ( eps );
+        const __m256d mabs = _mm256_castsi256_pd ( _mm256_set1_epi64x ( 0x7FFFFFFFFFFFFFFFLL ) );
+        int i = 0;
+        for ( ; i + 8 <= n ; i += 8 )
+        {
+            __m256d d1 = _mm256_and_pd ( _mm256_sub_pd ( _mm256_loadu_pd ( x + i     ) ,
+                                                         _mm256_loadu_pd ( y + i     ) ) , mabs );
+            __m256d d2 = _mm256_and_pd ( _mm256_sub_pd ( _mm256_loadu_pd ( x + i + 4 ) ,
+                                                         _mm256_loadu_pd ( y + i + 4 ) ) , mabs );
+            int mask = _mm256_movemask_pd ( _mm256_cmp_pd ( d1 , veps , _CMP_NLT_UQ ) )
+                     | _mm256_movemask_pd ( _mm256_cmp_pd ( d2 , veps , _CMP_NLT_UQ ) ) << 4;
+            if ( mask )
+                return i + __builtin_ctz ( mask );
+        }
+        for ( ; i + 4 <= n ; i += 4 )
+        {
+            __m256d d = _mm256_and_pd ( _mm256_sub_pd ( _mm256_loadu_pd ( x + i ) ,
+                                                        _mm256_loadu_pd ( y + i ) ) , mabs );
+            int mask  = _mm256_movemask_pd ( _mm256_cmp_pd ( d , veps , _CMP_NLT_UQ ) );
+            if ( mask )
+                return i + __builtin_ctz ( mask );
+        }
+        return i + first_not_equal_scalar ( x + i , y + i , n - i , eps );
+    }
+
+    __attribute__((target("avx2")))
+    int first_ordered_avx2 ( const double * x , const double * y , int n , double eps )
+    {
+        const __m256d veps = _mm256_set1_pd ( eps );
+        int i = 0;
+        for ( ; i + 4 <= n ; i += 4 )
+        {
+            __m256d a = _mm256_loadu_pd ( x + i );
+            __m256d b = _mm256_loadu_pd ( y + i );
+            __m256d m = _mm256_or_pd (
+                            _mm256_or_pd ( _mm256_cmp_pd ( a , _mm256_sub_pd ( b , veps ) , _CMP_LT_OQ ) ,
+                                           _mm256_cmp_pd ( a , _mm256_add_pd ( b , veps ) , _CMP_GT_OQ ) ) ,
+                            _mm256_cmp_pd ( a , b , _CMP_UNORD_Q ) );
+            int mask = _mm256_movemask_pd ( m );
+            if ( mask )
+                return i + __builtin_ctz ( mask );
+        }
+        return i + first_ordered_scalar ( x + i , y + i , n - i , eps );
+    }
+
+#endif
+
+    /*-----------------------------------------------------------*/
+    /*                 choice of the kernels at first call       */
+    /*-----------------------------------------------------------*/
+    int first_not_equal_resolve ( const double * x , const double * y , int n , double eps );
+    int first_ordered_resolve   ( const double * x , const double * y , int n , double eps );
+}
+
+// Constant initialization: the pointers are valid before any dynamic
+// initialization that would compare points.
+std::atomic<NOMAD::Compare::kernel>   NOMAD::Compare::_first_not_equal ( first_not_equal_resolve );
+std::atomic<NOMAD::Compare::kernel>   NOMAD::Compare::_first_ordered   ( first_ordered_resolve   );
+std::atomic<NOMAD::Compare::isa_type> NOMAD::Compare::_isa             ( NOMAD::Compare::SCALAR  );
+
+namespace {
+
+    // Concurrent first calls all store the same kernels.
+    int first_not_equal_resolve ( const double * x , const double * y , int n , double eps )
+    {
+        NOMAD::Compare::get_isa();
+        return first_not_equal_scalar ( x , y , n , eps );
+    }
+
+    int first_ordered_resolve ( const double * x , const double * y , int n , double eps )
+    {
+        NOMAD::Compare::get_isa();
+        return first_ordered_scalar ( x , y , n , eps );
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                      instruction sets                     */
+/*-----------------------------------------------------------*/
+NOMAD::Compare::isa_type NOMAD::Compare::get_best_isa ( void )
+{
+#ifdef NOMAD_COMPARE_X86
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports ( "avx2" ) )
+        return NOMAD::Compare::AVX2;
+    return NOMAD::Compare::SSE2;
+#else
+    return NOMAD::Compare::SCALAR;
+#endif
+}
+
+NOMAD::Compare::isa_type NOMAD::Compare::get_isa ( void )
+{
+    // The acquire loads see the _isa stored before the kernels.
+    if ( _first_not_equal.load ( std::memory_order_acquire ) == first_not_equal_resolve ||
+         _first_ordered.load   ( std::memory_order_acquire ) == first_ordered_resolve      )
+        set_isa ( get_best_isa() );
+    return _isa.load ( std::memory_order_relaxed );
+}
+
+NOMAD::Compare::isa_type NOMAD::Compare::set_isa ( NOMAD::Compare::isa_type isa )
+{
+    if ( isa > get_best_isa() )
+        isa = get_best_isa();
+
+    kernel first_not_equal = first_not_equal_scalar;
+    kernel first_ordered   = first_ordered_scalar;
+    switch ( isa )
+    {
+#ifdef NOMAD_COMPARE_X86
+        case NOMAD::Compare::AVX2:
+            first_not_equal = first_not_equal_avx2;
+            first_ordered   = first_ordered_avx2;
+            break;
+        case NOMAD::Compare::SSE2:
+            first_not_equal = first_not_equal_sse2;
+            first_ordered   = first_ordered_sse2;
+            break;
+#endif
+        default:
+            isa = NOMAD::Compare::SCALAR;
+    }
+    _isa.store             ( isa             , std::memory_order_relaxed );
+    _first_not_equal.store ( first_not_equal , std::memory_order_release );
+    _first_ordered.store   ( first_ordered   , std::memory_order_release );
+    return isa;
+}
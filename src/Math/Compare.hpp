@@ -0,0 +1,103 @@
+/**
+ \file   Compare.hpp
+ \brief  Vectorized comparisons of arrays of reals (headers)
+ \see    Compare.cpp
+ */
+
+#ifndef __NOMAD400_COMPARE__
+#define __NOMAD400_COMPARE__
+
+#include <atomic>
+
+#include "Math/Double.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Comparisons of arrays of NOMAD::Double, for NOMAD::Point::operator==() and operator<().
+    /**
+     - The kernels compare blocks of values at once and return the index of
+       the first value that decides the comparison. The caller compares
+       this value with the operators of NOMAD::Double, which keeps the
+       epsilon and the exceptions on undefined values.
+     - The values are read as \c double. Undefined values are NaN, and
+       always decide.
+     - The kernel is chosen at the first call: AVX2 or SSE2 on x86-64 with
+       GCC, depending on the processor, and a scalar loop otherwise. The
+       kernels are held in atomic pointers, so that the first calls may be
+       concurrent.
+     */
+    class Compare {
+
+    public:
+
+        /// Instruction sets of the kernels.
+        enum isa_type {
+            SCALAR ,  ///< Scalar loop.
+            SSE2   ,  ///< Blocks of 2 values.
+            AVX2      ///< Blocks of 4 values.
+        };
+
+        /// Index of the first values that are not equal.
+        /**
+         \param x   The first values -- \b IN.
+         \param y   The second values -- \b IN.
+         \param n   Number of values -- \b IN.
+         \param eps The epsilon -- \b IN.
+         \return    The first \c i such that \c !(|x[i]-y[i]|<eps), or \c n.
+         */
+        static int first_not_equal ( const NOMAD::Double * x ,
+                                     const NOMAD::Double * y ,
+                                     int                   n ,
+                                     double                eps )
+        {
+            kernel k = _first_not_equal.load ( std::memory_order_relaxed );
+            return k ( reinterpret_cast<const double *> ( x ) ,
+                       reinterpret_cast<const double *> ( y ) , n , eps );
+        }
+
+        /// Index of the first values that are ordered or not comparable.
+        /**
+         \param x   The first values -- \b IN.
+         \param y   The second values -- \b IN.
+         \param n   Number of values -- \b IN.
+         \param eps The epsilon -- \b IN.
+         \return    The first \c i such that \c x[i]<y[i]-eps, \c x[i]>y[i]+eps,
+                    or \c x[i] or \c y[i] is NaN, or \c n.
+         */
+        static int first_ordered ( const NOMAD::Double * x ,
+                                   const NOMAD::Double * y ,
+                                   int                   n ,
+                                   double                eps )
+        {
+            kernel k = _first_ordered.load ( std::memory_order_relaxed );
+            return k ( reinterpret_cast<const double *> ( x ) ,
+                       reinterpret_cast<const double *> ( y ) , n , eps );
+        }
+
+        /// Access to the instruction set of the kernels.
+        static isa_type get_isa ( void );
+
+        /// Best instruction set supported by the processor.
+        static isa_type get_best_isa ( void );
+
+        /// Choose the instruction set of the kernels.
+        /**
+         Test-only override, used by the tests and benchmarks to compare the
+         kernels. It must not be called while other threads compare points:
+         they could use the kernels of different instruction sets.
+         \param isa The instruction set, lowered to \c get_best_isa() -- \b IN.
+         \return    The instruction set that is used.
+         */
+        static isa_type set_isa ( isa_type isa );
+
+    private:
+
+        typedef int ( * kernel ) ( const double * , const double * , int , double );
+
+        static std::atomic<kernel>   _first_not_equal; ///< Kernel of first_not_equal().
+        static std::atomic<kernel>   _first_ordered;   ///< Kernel of first_ordered().
+        static std::atomic<isa_type> _isa;             ///< Instruction set of the kernels.
+    };
+
+#include "nomad_nsend.hpp"
+#endif
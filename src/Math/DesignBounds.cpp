@@ -0,0 +1,47 @@
+/**
+ \file   DesignBounds.cpp
+ \brief  Bounds of the sample designs (implementation)
+ \see    DesignBounds.hpp
+ */
+
+#include <cmath>
+#include "Math/DesignBounds.hpp"
+
+/*-----------------------------------------------------------*/
+/*                    check of the bounds                    */
+/*-----------------------------------------------------------*/
+const char * NOMAD::check_design_bounds ( const std::vector<double> & l ,
+                                          const std::vector<double> & u ,
+                                          int                         n   )
+{
+    if ( static_cast<int> ( l.size() ) != n || static_cast<int> ( u.size() ) != n )
+        return "bad dimensions";
+    for ( int i = 0 ; i < n ; ++i )
+        if ( !( l[i] <= u[i] ) || !( std::fabs ( l[i] ) < NOMAD::INF ) || !( std::fabs ( u[i] ) < NOMAD::INF ) )
+            return "bad bounds";
+    return NULL;
+}
+
+const char * NOMAD::check_design_bounds ( const NOMAD::Point  & l  ,
+                                          const NOMAD::Point  & u  ,
+                                          int                   n  ,
+                                          std::vector<double> & lb ,
+                                          std::vector<double> & ub   )
+{
+    if ( l.get_size() != n || u.get_size() != n )
+        return "bad dimensions";
+    // Undefined bounds throw in todouble().
+    std::vector<double> lv ( n ) , uv ( n );
+    for ( int i = 0 ; i < n ; ++i )
+    {
+        lv[i] = l[i].todouble();
+        uv[i] = u[i].todouble();
+    }
+    const char * error = NOMAD::check_design_bounds ( lv , uv , n );
+    if ( !error )
+    {
+        lb.swap ( lv );
+        ub.swap ( uv );
+    }
+    return error;
+}
@@ -0,0 +1,48 @@
+/**
+ \file   DesignBounds.hpp
+ \brief  Bounds of the sample designs (headers)
+ \see    DesignBounds.cpp
+ */
+
+#ifndef __NOMAD400_DESIGN_BOUNDS__
+#define __NOMAD400_DESIGN_BOUNDS__
+
+#include <vector>
+
+#include "Math/Point.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Check the real bounds of a design, for \c set_bounds() of NOMAD::LHS, NOMAD::Sobol and NOMAD::Halton.
+    /**
+     The bounds must have the dimension \c n, be finite, and satisfy
+     \c l<=u. The caller throws the error with its own name.
+     \param l The lower bounds -- \b IN.
+     \param u The upper bounds -- \b IN.
+     \param n The dimension -- \b IN.
+     \return  \c NULL if the bounds are valid, or the error:
+              \c "bad dimensions" or \c "bad bounds".
+     */
+    const char * check_design_bounds ( const std::vector<double> & l ,
+                                       const std::vector<double> & u ,
+                                       int                         n   );
+
+    /// Check the real bounds of a design, given as points.
+    /**
+     Same as the other version, with the bounds converted to \c double.
+     Undefined bounds throw NOMAD::Double::Not_Defined.
+     \param l  The lower bounds -- \b IN.
+     \param u  The upper bounds -- \b IN.
+     \param n  The dimension -- \b IN.
+     \param lb The lower bounds, if they are valid -- \b OUT.
+     \param ub The upper bounds, if they are valid -- \b OUT.
+     \return   \c NULL if the bounds are valid, or the error.
+     */
+    const char * check_design_bounds ( const NOMAD::Point  & l  ,
+                                       const NOMAD::Point  & u  ,
+                                       int                   n  ,
+                                       std::vector<double> & lb ,
+                                       std::vector<double> & ub   );
+
+#include "nomad_nsend.hpp"
+#endif
@@ -5,120 +5,126 @@
  \date   2010-04-02
  \see    Double.hpp
  */
+#include <cctype>
+#include <cstdio>
+
 #include "Math/Double.hpp"
 
 /*-----------------------------------*/
 /*   static members initialization   */
 /*-----------------------------------*/
-double      NOMAD::Double::_epsilon         = NOMAD::DEFAULT_EPSILON;
-std::string NOMAD::Double::_inf_str         = NOMAD::DEFAULT_INF_STR;
-std::string NOMAD::Double::_undef_str       = NOMAD::DEFAULT_UNDEF_STR;
-#ifdef MEMORY_DEBUG
-int         NOMAD::Double::_cardinality     = 0;
-int         NOMAD::Double::_max_cardinality = 0;
-#endif
+NOMAD::DoubleContext NOMAD::Double::_default_context;
+NOMAD_THREAD_LOCAL NOMAD::DoubleContext * NOMAD::Double::_context = &NOMAD::Double::_default_context;
+const uint64_t NOMAD::Double::UNDEF_BITS;
+const int      NOMAD::Double::DEFAULT_PRECISION;
+const int      NOMAD::Double::SHORTEST_PRECISION;
+const size_t   NOMAD::Double::STR_SIZE;
 
 /*-----------------------------------------------*/
-/*                  constructor 1                */
+/*     exceptions thrown by inline operations    */
 /*-----------------------------------------------*/
-NOMAD::Double::Double ( void )
-: _value   ( 0.0   ) ,
-_defined ( false )
+void NOMAD::Double::throw_not_defined ( int line , const char * msg )
 {
-#ifdef MEMORY_DEBUG
-    ++NOMAD::Double::_cardinality;
-    if ( NOMAD::Double::_cardinality > NOMAD::Double::_max_cardinality )
-        ++NOMAD::Double::_max_cardinality;
-#endif
+    throw Not_Defined ( "Double.hpp" , line , msg );
 }
 
-/*-----------------------------------------------*/
-/*                  constructor 2                */
-/*-----------------------------------------------*/
-NOMAD::Double::Double ( double v )
-: _value   ( v    ) ,
-_defined ( true )
+void NOMAD::Double::throw_invalid_value ( int line , const char * msg )
 {
-#ifdef MEMORY_DEBUG
-    ++NOMAD::Double::_cardinality;
-    if (NOMAD::Double::_cardinality > NOMAD::Double::_max_cardinality)
-        ++NOMAD::Double::_max_cardinality;
-#endif
+    throw Invalid_Value ( "Double.hpp" , line , msg );
 }
 
 /*-----------------------------------------------*/
-/*                  Copy constructor             */
+/*          get the value as a string            */
 /*-----------------------------------------------*/
-NOMAD::Double::Double ( const NOMAD::Double & d )
-: _value   ( d._value   ) ,
-_defined ( d._defined )
+const std::string NOMAD::Double::tostring ( void ) const
 {
-#ifdef MEMORY_DEBUG
-    ++NOMAD::Double::_cardinality;
-    if (NOMAD::Double::_cardinality > NOMAD::Double::_max_cardinality)
-        ++NOMAD::Double::_max_cardinality;
-#endif
+    std::string ret_str;
+    append_to ( ret_str );
+    return ret_str;
 }
 
 /*-----------------------------------------------*/
-/*                    destructor                 */
+/*    copy a string to a buffer (snprintf-like)  */
 /*-----------------------------------------------*/
-NOMAD::Double::~Double ( void )
+static int snprint_str ( char * buf , size_t size , const char * prefix , const std::string & s )
 {
-#ifdef MEMORY_DEBUG
-    --NOMAD::Double::_cardinality;
-#endif
+    return snprintf ( buf , size , "%s%s" , prefix , s.c_str() );
 }
 
 /*-----------------------------------------------*/
-/*               set epsilon (static)            */
+/*      write a double to a buffer (static)      */
 /*-----------------------------------------------*/
-void NOMAD::Double::set_epsilon ( double eps )
+int NOMAD::Double::snprint_double ( char * buf , size_t size , double value , int precision )
 {
-    if ( eps <= 0.0 )
-        throw NOMAD::Exception ( "Double.cpp" , __LINE__ ,
-                                "NOMAD::Double::set_epsilon(): invalid epsilon" );
-    NOMAD::Double::_epsilon = eps;
+    if ( precision != SHORTEST_PRECISION )
+        return snprintf ( buf , size , "%.*g" , precision , value );
+
+    // Shortest round-trip digits: any decimal of 15 digits or less is read
+    // back exactly, so the first precision in {15,16,17} that round-trips
+    // gives the shortest digits ("%g" removes the trailing zeros).
+    char tmp[STR_SIZE];
+    int n = 0;
+    for ( int p = 15 ; p <= 17 ; ++p )
+    {
+        n = snprintf ( tmp , sizeof(tmp) , "%.*g" , p , value );
+        if ( std::strtod ( tmp , NULL ) == value )
+            break;
+    }
+    // NaN never round-trips, and was written with p=17: "nan" or "-nan".
+    if ( size > 0 )
+    {
+        size_t ncopy = ( static_cast<size_t>(n) < size ) ? n : size-1;
+        std::memcpy ( buf , tmp , ncopy );
+        buf[ncopy] = '\0';
+    }
+    return n;
 }
 
 /*-----------------------------------------------*/
-/*                  get the value                */
+/*          write the value to a buffer          */
 /*-----------------------------------------------*/
-const double & NOMAD::Double::todouble ( void ) const
+int NOMAD::Double::snprint ( char * buf , size_t size , bool int_display , int precision ) const
 {
-    if ( !_defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double::todouble(): value not defined" );
-    return _value;
+    if ( !is_defined() )
+        return snprint_str ( buf , size , "" , NOMAD::Double::_context->get_undef_str() );
+    if ( _value == NOMAD::INF )
+        return snprint_str ( buf , size , "" , NOMAD::Double::_context->get_inf_str() );
+    if ( _value == -NOMAD::INF )
+        return snprint_str ( buf , size , "-" , NOMAD::Double::_context->get_inf_str() );
+    if ( int_display && std::floor(_value) == std::ceil(_value) && fabs(_value) < INT_MAX-1 )
+        return snprintf ( buf , size , "%d" , static_cast<int>(_value) );
+    return snprint_double ( buf , size , _value , precision );
 }
 
 /*-----------------------------------------------*/
-/*          get the value as a string            */
+/*           append the value to a string        */
 /*-----------------------------------------------*/
-const std::string NOMAD::Double::tostring ( void ) const
+void NOMAD::Double::append_to ( std::string & s , bool int_display , int precision ) const
 {
-    std::string ret_str;
-
-    if ( _defined )
+    if ( !is_defined() )
+        s += NOMAD::Double::_context->get_undef_str();
+    else if ( _value == NOMAD::INF )
+        s += NOMAD::Double::_context->get_inf_str();
+    else if ( _value == -NOMAD::INF )
     {
-        if ( _value == NOMAD::INF )
-            ret_str = NOMAD::Double::_inf_str;
-        else if ( _value == -NOMAD::INF )
-            ret_str = "-" + NOMAD::Double::_inf_str;
-        else
-        {
-            std::stringstream ss;
-            ss << _value;
-            ret_str = ss.str();
-        }
+        s += '-';
+        s += NOMAD::Double::_context->get_inf_str();
     }
     else
     {
-        ret_str = NOMAD::Double::_undef_str;
+        char buf[STR_SIZE];
+        int n = snprint ( buf , sizeof(buf) , int_display , precision );
+        if ( static_cast<size_t>(n) < sizeof(buf) )
+            s.append ( buf , n );
+        else
+        {
+            // Only with a precision larger than 17 digits.
+            size_t len = s.size();
+            s.resize ( len + n + 1 );
+            snprint ( &s[len] , n + 1 , int_display , precision );
+            s.resize ( len + n );
+        }
     }
-
-    return ret_str;
-
 }
 
 /*------------------------------------------*/
@@ -138,78 +144,172 @@ std::istream & NOMAD::operator >> ( std::istream & in , NOMAD::Double & d )
 /*-----------------------------------------------*/
 /*      atof: value determined by a string       */
 /*-----------------------------------------------*/
-bool NOMAD::Double::atof ( const std::string & ss )
+bool NOMAD::Double::atof ( const std::string & s )
 {
-    
-    std::string s = ss;
-    NOMAD::toupper(s);
-    
-    if ( s == "-" || ss == NOMAD::Double::_undef_str )
+    const char * first = s.data();
+    return parse_token ( first , first + s.size() );
+}
+
+/*-------------------------------------------------*/
+/*  atof from a string that can begin with 'r' to  */
+/*  indicate a proportion (relative value)         */
+/*-------------------------------------------------*/
+bool NOMAD::Double::relative_atof ( const std::string & s , bool & relative )
+{
+    const char * first = s.data();
+    const char * last  = first + s.size();
+    if ( first != last && std::toupper(static_cast<unsigned char>(*first)) == 'R' )
     {
-        _value   = 0.0;
-        _defined = false;
+        relative = true;
+        if ( !parse_token ( first+1 , last ) )
+            return false;
+        return ( *this >= 0.0 );
+    }
+    relative = false;
+    return parse_token ( first , last );
+}
+
+/*-----------------------------------------------*/
+/*     characters that separate parsed values    */
+/*-----------------------------------------------*/
+static bool is_parse_space ( char c )
+{
+    return ( c == ' ' || c == '\t' || c == '\n' || c == '\r' );
+}
+
+/*-----------------------------------------------*/
+/*   compare a token with an upper case string   */
+/*-----------------------------------------------*/
+static bool token_equals_upper ( const char * first , const char * last , const char * upper )
+{
+    for ( ; first != last ; ++first , ++upper )
+        if ( *upper == '\0' || std::toupper(static_cast<unsigned char>(*first)) != *upper )
+            return false;
+    return ( *upper == '\0' );
+}
+
+/*-----------------------------------------------*/
+/*        compare a token with a sign + string   */
+/*-----------------------------------------------*/
+static bool token_equals ( const char * first , const char * last , char sign , const std::string & s )
+{
+    if ( sign != '\0' )
+    {
+        if ( first == last || *first != sign )
+            return false;
+        ++first;
+    }
+    return ( static_cast<size_t>(last-first) == s.size() &&
+             std::memcmp ( first , s.data() , s.size() ) == 0 );
+}
+
+/*-----------------------------------------------*/
+/*   parse a token that must be entirely valid   */
+/*-----------------------------------------------*/
+bool NOMAD::Double::parse_token ( const char * first , const char * last )
+{
+    if ( token_equals ( first , last , '\0' , NOMAD::Double::_context->get_undef_str() ) ||
+         ( last - first == 1 && *first == '-' ) )
+    {
+        _value = undef_value();
         return true;
     }
     
-    if ( s == "INF" ||  s == "+INF" ||
-        ss == NOMAD::Double::_inf_str ||
-        ss == ("+" + NOMAD::Double::_inf_str) )
+    if ( token_equals_upper ( first , last , "INF"  ) ||
+         token_equals_upper ( first , last , "+INF" ) ||
+         token_equals ( first , last , '\0' , NOMAD::Double::_context->get_inf_str() ) ||
+         token_equals ( first , last , '+'  , NOMAD::Double::_context->get_inf_str() )    )
     {
-        _value   = NOMAD::INF;
-        _defined = true;
+        _value = NOMAD::INF;
         return true;
     }
     
-    if ( s == "-INF" || ss == ("-" + NOMAD::Double::_inf_str) )
+    if ( token_equals_upper ( first , last , "-INF" ) ||
+         token_equals ( first , last , '-' , NOMAD::Double::_context->get_inf_str() ) )
     {
-        _value   = -NOMAD::INF;
-        _defined = true;
+        _value = -NOMAD::INF;
         return true;
     }
     
-    if ( s.empty() || (s.size() == 1 && !isdigit(s[0])) )
+    size_t n = last - first;
+    if ( n == 0 || (n == 1 && !isdigit(static_cast<unsigned char>(*first))) )
         return false;
     
-    if ( !isdigit(s[0]) && s[0] != '+' && s[0] != '-' && s[0] != '.' )
+    if ( !isdigit(static_cast<unsigned char>(*first)) && *first != '+' && *first != '-' && *first != '.' )
         return false;
     
-    size_t n = s.size();
     for ( size_t k = 1 ; k < n ; ++k )
-        if ( !isdigit(s[k]) && s[k] != '.' )
+        if ( !isdigit(static_cast<unsigned char>(first[k])) && first[k] != '.' )
         {
-            if ( s[k] == 'E' )
+            if ( first[k] == 'E' || first[k] == 'e' )
             {
-                if ( s.size() == k+1 )
+                if ( n == k+1 )
                     return false;
                 ++k;
-                if ( !isdigit(s[k]) && s[k] != '+' && s[k] != '-' )
+                if ( !isdigit(static_cast<unsigned char>(first[k])) && first[k] != '+' && first[k] != '-' )
                     return false;
             }
             else
                 return false;
         }
     
-    *this = std::atof ( s.c_str() );
+    // strtod needs a null-terminated string: copy the token on the stack,
+    // or in a std::string for unusually long tokens.
+    char buf[64];
+    if ( n < sizeof(buf) )
+    {
+        std::memcpy ( buf , first , n );
+        buf[n] = '\0';
+        _value = std::strtod ( buf , NULL );
+    }
+    else
+        _value = std::strtod ( std::string ( first , last ).c_str() , NULL );
+    
     return true;
 }
 
-/*-------------------------------------------------*/
-/*  atof from a string that can begin with 'r' to  */
-/*  indicate a proportion (relative value)         */
-/*-------------------------------------------------*/
-bool NOMAD::Double::relative_atof ( const std::string & s , bool & relative )
-{
-    if ( std::toupper(s[0]) == 'R' )
+/*-----------------------------------------------*/
+/*     parse a value from a range of characters  */
+/*-----------------------------------------------*/
+size_t NOMAD::Double::parse ( const char * first , const char * last )
+{
+    const char * begin = first;
+    while ( first != last && is_parse_space(*first) )
+        ++first;
+    const char * end = first;
+    while ( end != last && !is_parse_space(*end) )
+        ++end;
+    
+    if ( first == end || !parse_token ( first , end ) )
+        return 0;
+    return end - begin;
+}
+
+/*-----------------------------------------------*/
+/*  parse a value that can begin with 'r' to     */
+/*  indicate a proportion (relative value)       */
+/*-----------------------------------------------*/
+size_t NOMAD::Double::relative_parse ( const char * first , const char * last , bool & relative )
+{
+    const char * begin = first;
+    while ( first != last && is_parse_space(*first) )
+        ++first;
+    const char * end = first;
+    while ( end != last && !is_parse_space(*end) )
+        ++end;
+    
+    relative = false;
+    if ( first == end )
+        return 0;
+    if ( std::toupper(static_cast<unsigned char>(*first)) == 'R' )
     {
-        relative  = true;
-        std::string ss = s;
-        ss.erase(ss.begin());
-        if ( !atof(ss) )
-            return false;
-        return ( *this >= 0.0 );
+        relative = true;
+        if ( !parse_token ( first+1 , end ) || !( *this >= 0.0 ) )
+            return 0;
     }
-    relative = false;
-    return atof(s);
+    else if ( !parse_token ( first , end ) )
+        return 0;
+    return end - begin;
 }
 
 /*-----------------------------------------------*/
@@ -217,7 +317,7 @@ bool NOMAD::Double::relative_atof ( const std::string & s , bool & relative )
 /*-----------------------------------------------*/
 bool NOMAD::Double::is_integer ( void ) const
 {
-    if ( !_defined )
+    if ( !is_defined() )
         return false;
     return ( NOMAD::Double(std::floor(_value))) == ( NOMAD::Double(std::ceil(_value)) );
 }
@@ -227,80 +327,17 @@ bool NOMAD::Double::is_integer ( void ) const
 /*-----------------------------------------------*/
 bool NOMAD::Double::is_binary ( void ) const
 {
-    if ( !_defined )
+    if ( !is_defined() )
         return false;
     return ( NOMAD::Double(_value) == 0.0 || NOMAD::Double(_value) == 1.0 );
 }
 
-/*-------------------------------------*/
-/*               d = d1/d2             */
-/*-------------------------------------*/
-const NOMAD::Double NOMAD::operator / ( const NOMAD::Double & d1 ,
-                                       const NOMAD::Double & d2   )
-{
-    if ( d2.todouble() == 0.0 )
-        throw NOMAD::Double::Invalid_Value ( "Double.cpp" , __LINE__ ,
-                                            "NOMAD::Double: d1 / d2: division by zero" );
-    return NOMAD::Double ( d1.todouble() / d2.todouble() );
-}
-
-/*-------------------------------------*/
-/*                d1 += d2             */
-/*-------------------------------------*/
-const NOMAD::Double & NOMAD::Double::operator += ( const NOMAD::Double & d2 )
-{
-    if ( !_defined || !d2._defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double: d1 += d2: d1 or d2 not defined" );
-    _value += d2._value;
-    return *this;
-}
-
-/*-------------------------------------*/
-/*               d1 -= d2              */
-/*-------------------------------------*/
-const NOMAD::Double & NOMAD::Double::operator -= ( const NOMAD::Double & d2 )
-{
-    if ( !_defined || !d2._defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double: d1 -= d2: d1 or d2 not defined" );
-    _value -= d2._value;
-    return *this;
-}
-
-/*-------------------------------------*/
-/*                d1 *= d2             */
-/*-------------------------------------*/
-const NOMAD::Double & NOMAD::Double::operator *= ( const NOMAD::Double & d2 )
-{
-    if ( !_defined || !d2._defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double: d1 *= d2: d1 or d2 not defined" );
-    _value *= d2._value;
-    return *this;
-}
-
-/*-------------------------------------*/
-/*               d1 /= d2              */
-/*-------------------------------------*/
-const NOMAD::Double & NOMAD::Double::operator /= ( const NOMAD::Double & d2 )
-{
-    if ( !_defined || !d2._defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double: d1 /= d2: d1 or d2 not defined" );
-    if ( d2._value == 0.0 )
-        throw Invalid_Value ( "Double.cpp" , __LINE__ ,
-                             "NOMAD::Double: d1 /= d2: division by zero" );
-    _value /= d2._value;
-    return *this;
-}
-
 /*-------------------------------------*/
 /*                  ++d                */
 /*-------------------------------------*/
 NOMAD::Double & NOMAD::Double::operator++ ( void )
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ , "NOMAD::Double: ++d: d not defined" );
     _value += 1;
     return *this;
@@ -311,7 +348,7 @@ NOMAD::Double & NOMAD::Double::operator++ ( void )
 /*-------------------------------------*/
 NOMAD::Double NOMAD::Double::operator++ ( int n )
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ , "NOMAD::Double: d++: d not defined" );
     NOMAD::Double tmp = *this;
     if( n <= 0 )
@@ -325,7 +362,7 @@ NOMAD::Double NOMAD::Double::operator++ ( int n )
 /*-------------------------------------*/
 NOMAD::Double & NOMAD::Double::operator-- ( void )
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ , "NOMAD::Double: --d: d not defined" );
     _value -= 1;
     return *this;
@@ -336,7 +373,7 @@ NOMAD::Double & NOMAD::Double::operator-- ( void )
 /*-------------------------------------*/
 NOMAD::Double NOMAD::Double::operator-- ( int n )
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ ,
                            "NOMAD::Double: d--: d not defined" );
     NOMAD::Double tmp = *this;
@@ -346,23 +383,6 @@ NOMAD::Double NOMAD::Double::operator-- ( int n )
     return tmp;
 }
 
-/*-------------------------------------*/
-/*              operators =            */
-/*-------------------------------------*/
-NOMAD::Double & NOMAD::Double::operator = ( const NOMAD::Double & d )
-{
-    _value   = d._value;
-    _defined = d._defined;
-    return *this;
-}
-
-NOMAD::Double & NOMAD::Double::operator = ( double r )
-{
-    _value   = r;
-    _defined = true;
-    return *this;
-}
-
 /*------------------------------------------*/
 /*                  display                 */
 /*------------------------------------------*/
@@ -371,19 +391,19 @@ void NOMAD::Double::display ( ) const
 {
     std::ostream &out = std::cout;  // VRM to be generalized, this value should be fetched
                                     // in a manager singleton
-    if ( _defined )
+    if ( is_defined() )
     {
         if ( _value == NOMAD::INF )
-            out << NOMAD::Double::_inf_str;
+            out << NOMAD::Double::_context->get_inf_str();
         else if ( _value == -NOMAD::INF )
-            out << "-" << NOMAD::Double::_inf_str;
+            out << "-" << NOMAD::Double::_context->get_inf_str();
         else if ( std::floor(_value) == std::ceil(_value) && fabs(_value) < INT_MAX-1 )
             out << static_cast<int>(_value);
         else
             out << _value;
     }
     else
-        out << NOMAD::Double::_undef_str;
+        out << NOMAD::Double::_context->get_undef_str();
 }
 */
 
@@ -400,20 +420,33 @@ void NOMAD::Double::display ( const std::string    & format   ) const
 #include "nomad_nsbegin.hpp"
 std::ostream& operator<< ( std::ostream& os, const NOMAD::Double& d )
 {
+    // Streams with a non-default format for numbers use the std::ostream
+    // formatting. Otherwise, numbers are written to a buffer, which gives
+    // the same characters without the locale and facet machinery.
+    const std::ios::fmtflags std_fmt = std::ios::floatfield | std::ios::showpoint |
+                                       std::ios::showpos    | std::ios::uppercase |
+                                       std::ios::internal;
     if ( d.is_defined() )
     {
-        double value = d.todouble();
+        double value = d._value;
         if ( value == NOMAD::INF )
-            os << NOMAD::Double::get_inf_str();
+            os << NOMAD::Double::_context->get_inf_str();
         else if ( value == -NOMAD::INF )
-            os << "-" << NOMAD::Double::get_inf_str();
+            os << "-" << NOMAD::Double::_context->get_inf_str();
         else if ( std::floor(value) == std::ceil(value) && fabs(value) < INT_MAX-1 )
             os << static_cast<int>(value);
-        else
+        else if ( ( os.flags() & std_fmt ) || os.precision() > 17 )
             os << value;
+        else
+        {
+            char buf[NOMAD::Double::STR_SIZE];
+            NOMAD::Double::snprint_double ( buf , sizeof(buf) , value ,
+                                            static_cast<int>(os.precision()) );
+            os << buf;
+        }
     }
     else
-        os << NOMAD::Double::get_undef_str();
+        os << NOMAD::Double::_context->get_undef_str();
 
     return os;
 }
@@ -424,7 +457,7 @@ std::ostream& operator<< ( std::ostream& os, const NOMAD::Double& d )
 /*------------------------------------------*/
 int NOMAD::Double::round ( void ) const
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ ,
                            "NOMAD::Double::round(): value not defined" );
     
@@ -442,7 +475,7 @@ int NOMAD::Double::round ( void ) const
 /*------------------------------------------*/
 const NOMAD::Double NOMAD::Double::roundd ( void ) const
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ ,
                            "NOMAD::Double::round(): value not defined" );
 
@@ -456,7 +489,7 @@ const NOMAD::Double NOMAD::Double::roundd ( void ) const
 /*------------------------------------------*/
 const NOMAD::Double NOMAD::Double::ceil ( void ) const
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ ,
                            "NOMAD::Double::ceil(): value not defined" );
     return NOMAD::Double( std::ceil(_value) );
@@ -467,49 +500,12 @@ const NOMAD::Double NOMAD::Double::ceil ( void ) const
 /*------------------------------------------*/
 const NOMAD::Double NOMAD::Double::floor ( void ) const
 {
-    if ( !_defined )
+    if ( !is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ ,
                            "NOMAD::Double::floor(): value not defined" );
     return NOMAD::Double( std::floor(_value) );
 }
 
-/*------------------------------------------*/
-/*                    abs                   */
-/*------------------------------------------*/
-const NOMAD::Double NOMAD::Double::abs ( void ) const
-{
-    if ( !_defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double::abs(): value not defined" );
-    return fabs ( _value );
-}
-
-/*------------------------------------------*/
-/*                  square                  */
-/*------------------------------------------*/
-const NOMAD::Double NOMAD::Double::pow2 ( void ) const
-{
-    if ( !_defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double::pow2(): value not defined" );
-    return pow ( _value , 2 );
-}
-
-/*------------------------------------------*/
-/*                square root               */
-/*------------------------------------------*/
-const NOMAD::Double NOMAD::Double::sqrt ( void ) const
-{
-    if ( !_defined )
-        throw Not_Defined ( "Double.cpp" , __LINE__ ,
-                           "NOMAD::Double::sqrt(): value not defined" );
-    if ( *this < 0.0 )
-        throw NOMAD::Double::Invalid_Value ( "Double.cpp" , __LINE__ ,
-                                            "NOMAD::Double::sqrt(x): x < 0" );
-    
-    return std::sqrt ( _value );
-}
-
 /*---------------------------------------------*/
 /*  relative error with another NOMAD::Double  */
 /*---------------------------------------------*/
@@ -525,7 +521,7 @@ const NOMAD::Double NOMAD::Double::sqrt ( void ) const
 //
 const NOMAD::Double NOMAD::Double::rel_err ( const Double & x ) const
 {
-    if ( !_defined || !x._defined )
+    if ( !is_defined() || !x.is_defined() )
         throw Not_Defined ( "Double.cpp" , __LINE__ ,
                            "NOMAD::Double::rel_err(): one of the values is not defined" );
     
@@ -597,20 +593,104 @@ void NOMAD::Double::project_to_mesh ( const NOMAD::Double & ref   ,
                                      const NOMAD::Double & lb    ,
                                      const NOMAD::Double & ub      )
 {
-    if ( !_defined )
+    if ( !is_defined() )
         return;
     
-    NOMAD::Double v0 = ( ref._defined ) ? ref : 0.0;
+    NOMAD::Double v0 = ( ref.is_defined() ) ? ref : 0.0;
     
-    if ( delta._defined && delta != 0.0 )
+    if ( delta.is_defined() && delta != 0.0 )
     {
         
         *this = v0 + ( (*this-v0) / delta).roundd() * delta;
         
-        if ( ub._defined && *this > ub )
+        if ( ub.is_defined() && *this > ub )
             *this = ub;
         
-        if ( lb._defined && *this < lb )
+        if ( lb.is_defined() && *this < lb )
             *this = lb;
     }
 }
+
+/*------------------------------------------*/
+/*   projection to the mesh of an array     */
+/*------------------------------------------*/
+namespace {
+
+    // Same rounding as NOMAD::Double::roundd(). The argument of floor() is
+    // at least .5, so it is truncated with a conversion instead of a call
+    // to floor(). Values from 2^52 are integers already, and NaN is kept.
+    inline double round_half_away ( double v )
+    {
+        double w = .5 + std::fabs ( v );
+        double r = ( w < 4503599627370496.0 ) ? static_cast<double> ( static_cast<int64_t> ( w ) ) : w;
+        return ( v < 0.0 ) ? -r : r;
+    }
+
+    // Branch-free loop of NOMAD::Double::project_to_mesh(). The template
+    // arguments remove the tests on missing arrays from the loop.
+    // Undefined values are NaN, so comparisons with undefined bounds are false.
+    template < bool HAS_REF , bool HAS_LB , bool HAS_UB >
+    void project_to_mesh_loop ( double       * x     ,
+                                int            n     ,
+                                const double * ref   ,
+                                const double * delta ,
+                                const double * lb    ,
+                                const double * ub    ,
+                                double         eps     )
+    {
+        for ( int i = 0 ; i < n ; ++i )
+        {
+            double xi = x[i];
+            double di = delta[i];
+            double v0 = 0.0;
+            if ( HAS_REF && !NOMAD::Double::is_undef_value ( ref[i] ) )
+                v0 = ref[i];
+            
+            double y = v0 + round_half_away ( ( xi - v0 ) / di ) * di;
+            if ( HAS_UB && y > ub[i] + eps )
+                y = ub[i];
+            if ( HAS_LB && y < lb[i] - eps )
+                y = lb[i];
+            
+            bool project = !NOMAD::Double::is_undef_value ( xi ) &&
+                           !NOMAD::Double::is_undef_value ( di ) &&
+                           !( std::fabs ( di ) < eps );
+            x[i] = ( project ) ? y : xi;
+        }
+    }
+}
+
+void NOMAD::Double::project_to_mesh ( NOMAD::Double       * x     ,
+                                      int                   n     ,
+                                      const NOMAD::Double * ref   ,
+                                      const NOMAD::Double * delta ,
+                                      const NOMAD::Double * lb    ,
+                                      const NOMAD::Double * ub      )
+{
+    if ( n <= 0 || !delta )
+        return;
+    
+    double eps = NOMAD::Double::get_epsilon();
+    
+    // A NOMAD::Double has the layout of a double (see UNDEF_BITS): the loop
+    // works on the raw values, including the undefined ones.
+    double       * xv = reinterpret_cast<double       *> ( x     );
+    const double * rv = reinterpret_cast<const double *> ( ref   );
+    const double * dv = reinterpret_cast<const double *> ( delta );
+    const double * lv = reinterpret_cast<const double *> ( lb    );
+    const double * uv = reinterpret_cast<const double *> ( ub    );
+    
+    // Dispatch on the optional arrays.
+    int mask = ( ref ? 4 : 0 ) | ( lb ? 2 : 0 ) | ( ub ? 1 : 0 );
+    switch ( mask )
+    {
+        case 0: project_to_mesh_loop<false,false,false> ( xv , n , rv , dv , lv , uv , eps ); break;
+        case 1: project_to_mesh_loop<false,false,true > ( xv , n , rv , dv , lv , uv , eps ); break;
+        case 2: project_to_mesh_loop<false,true ,false> ( xv , n , rv , dv , lv , uv , eps ); break;
+        case 3: project_to_mesh_loop<false,true ,true > ( xv , n , rv , dv , lv , uv , eps ); break;
+        case 4: project_to_mesh_loop<true ,false,false> ( xv , n , rv , dv , lv , uv , eps ); break;
+        case 5: project_to_mesh_loop<true ,false,true > ( xv , n , rv , dv , lv , uv , eps ); break;
+        case 6: project_to_mesh_loop<true ,true ,false> ( xv , n , rv , dv , lv , uv , eps ); break;
+        default:project_to_mesh_loop<true ,true ,true > ( xv , n , rv , dv , lv , uv , eps ); break;
+    }
+}
@@ -10,10 +10,15 @@
 #define __NOMAD400_DOUBLE__
 
 #include "math.h"
+#include <cstring>
+#include <stdint.h>
 
 #include "Util/defines.hpp"
 #include "Util/Exception.hpp"
 #include "Util/utils.hpp"
+#include "Util/MemoryCounter.hpp"
+#include "Util/Uncopyable.hpp"
+#include "Math/DoubleContext.hpp"
 
 #include "nomad_nsbegin.hpp"
     
@@ -22,21 +27,112 @@
      - Allows comparisons on reals with custom precision.
      - Deals with undefined values.
      - Use \c todouble() to access the true \c double value.
+     - An undefined value is stored as a reserved quiet NaN (see \c UNDEF_BITS),
+       so that a NOMAD::Double has the size of a \c double and is trivially
+       copyable. Other NaN values are considered defined.
+     - Comparisons and formatting consult the numeric context of the current
+       thread (see NOMAD::DoubleContext and \c set_context()).
+     - Arithmetic is inline. By default, each operation throws
+       NOMAD::Double::Not_Defined on undefined operands. When \c UNCHECKED_DOUBLE
+       is defined (see defines.hpp), operations are not checked: undefined
+       values propagate like NaN, and validation is done once per batch with
+       \c check_defined().
      */
     class Double {
         
     private:
         
-        double        _value;   ///< The value of the number.
-        bool          _defined; ///< \c true if the number has a defined value.
+        double        _value;   ///< The value of the number, or the undefined NaN.
+        
+        static NOMAD::DoubleContext _default_context; ///< Context shared by default.
+
+        /// Context of the current thread.
+        static NOMAD_THREAD_LOCAL NOMAD::DoubleContext * _context;
         
-        // VRM TODO: make these local static objects
-        static double      _epsilon;    ///< Desired precision on comparisons.
-        static std::string _inf_str;    ///< Infinity string.
-        static std::string _undef_str;  ///< Undefined value string.
         
     public:
         
+        /// Bit pattern of an undefined NOMAD::Double.
+        /**
+         A quiet NaN with a payload that is not produced by the standard
+         library (\c std::numeric_limits<double>::quiet_NaN() is
+         \c 0x7FF8000000000000).
+         */
+        static const uint64_t UNDEF_BITS = 0x7FF8000000000DEFULL;
+        
+        /// Default number of significant digits for display, as \c std::ostream.
+        static const int DEFAULT_PRECISION = 6;
+        
+        /// Precision argument of \c snprint() for the shortest round-trip digits.
+        static const int SHORTEST_PRECISION = -1;
+        
+        /// Size of a buffer that can hold any number written by \c snprint().
+        /**
+         Longer infinity or undefined value strings are truncated.
+         */
+        static const size_t STR_SIZE = 32;
+        
+    private:
+        
+        /// Throw a NOMAD::Double::Not_Defined exception.
+        /**
+         Kept out of line so that the inline operations stay small.
+         \param line The line number of the check in Double.hpp -- \b IN.
+         \param msg  The error message -- \b IN.
+         */
+        NOMAD_NORETURN static void throw_not_defined ( int line , const char * msg );
+        
+        /// Throw a NOMAD::Double::Invalid_Value exception.
+        /**
+         \param line The line number of the check in Double.hpp -- \b IN.
+         \param msg  The error message -- \b IN.
+         */
+        NOMAD_NORETURN static void throw_invalid_value ( int line , const char * msg );
+        
+        /// Per-operation check, removed when \c UNCHECKED_DOUBLE is defined.
+        /**
+         \param defined \c true if the operands are defined -- \b IN.
+         \param line    The line number of the check in Double.hpp -- \b IN.
+         \param msg     The error message -- \b IN.
+         */
+        static void check ( bool defined , int line , const char * msg )
+        {
+#ifndef UNCHECKED_DOUBLE
+            if ( !defined )
+                throw_not_defined ( line , msg );
+#else
+            (void) defined;
+            (void) line;
+            (void) msg;
+#endif
+        }
+        
+    public:
+        
+        /// The \c double used to store an undefined value.
+        /**
+         \return A NaN with the bit pattern \c UNDEF_BITS.
+         */
+        static double undef_value ( void )
+        {
+            double v;
+            uint64_t bits = UNDEF_BITS;
+            std::memcpy ( &v , &bits , sizeof(v) );
+            return v;
+        }
+        
+        /// Test if a \c double is the undefined value.
+        /**
+         \param v The \c double -- \b IN.
+         \return A boolean equal to \c true if \c v has the bit pattern \c UNDEF_BITS.
+         */
+        static bool is_undef_value ( double v )
+        {
+            uint64_t bits;
+            std::memcpy ( &bits , &v , sizeof(bits) );
+            return bits == UNDEF_BITS;
+        }
+        
         /*-------------------------------------------------------------------*/
         
         /// Exception class for undefined NOMAD::Double objects.
@@ -60,38 +156,80 @@
         };
         
         /*-------------------------------------------------------------------*/
-#ifdef MEMORY_DEBUG
         /// Access to the number of NOMAD::Double objects in memory.
         /**
+         Counted with \c MEMORY_DEBUG only (see NOMAD::MemoryCounter).
          \return The number of NOMAD::Double objects in memory.
          */
-        static int get_cardinality ( void ) { return NOMAD::Double::_cardinality; }
+        static int get_cardinality ( void )
+        {
+            return static_cast<int> ( NOMAD::MemoryCounter::get_live ( NOMAD::MemoryCounter::DOUBLE ) );
+        }
         
         /// Access to the max number of NOMAD::Double objects in memory.
         /**
+         Counted with \c MEMORY_DEBUG only (see NOMAD::MemoryCounter).
          \return The max number of NOMAD::Double objects in memory.
          */
-        static int get_max_cardinality ( void ) { return NOMAD::Double::_max_cardinality; }
-#endif
+        static int get_max_cardinality ( void )
+        {
+            return static_cast<int> ( NOMAD::MemoryCounter::get_peak ( NOMAD::MemoryCounter::DOUBLE ) );
+        }
+        
+#ifdef MEMORY_DEBUG
+        // With MEMORY_DEBUG, instances are counted by NOMAD::MemoryCounter.
         
         /// Constructor #1.
-        explicit Double ( void );
+        explicit Double ( void ) : _value ( undef_value() )
+        {
+            NOMAD::MemoryCounter::construct ( NOMAD::MemoryCounter::DOUBLE , sizeof(Double) );
+        }
         
         /// Constructor #2.
         /**
          From a \c double.
          \param v The \c double -- \b IN.
          */
-        Double ( double v );
+        Double ( double v ) : _value ( v )
+        {
+            NOMAD::MemoryCounter::construct ( NOMAD::MemoryCounter::DOUBLE , sizeof(Double) );
+        }
         
         /// Copy constructor.
         /**
          \param d The copied object -- \b IN.
          */
-        Double ( const Double & d );
+        Double ( const Double & d ) : _value ( d._value )
+        {
+            NOMAD::MemoryCounter::construct ( NOMAD::MemoryCounter::DOUBLE , sizeof(Double) );
+        }
+        
+        /// Affectation operator.
+        /**
+         \param d The right-hand side object -- \b IN.
+         \return \c *this as the result of the affectation.
+         */
+        Double & operator = ( const Double & d ) { _value = d._value; return *this; }
         
         /// Destructor.
-        ~Double ( void );
+        ~Double ( void )
+        {
+            NOMAD::MemoryCounter::destruct ( NOMAD::MemoryCounter::DOUBLE , sizeof(Double) );
+        }
+#else
+        // Without MEMORY_DEBUG, copy and destruction are implicit, which
+        // keeps NOMAD::Double trivially copyable.
+        
+        /// Constructor #1.
+        explicit Double ( void ) : _value ( undef_value() ) {}
+        
+        /// Constructor #2.
+        /**
+         From a \c double.
+         \param v The \c double -- \b IN.
+         */
+        Double ( double v ) : _value ( v ) {}
+#endif
         
         /// Function \c atof (conversion from a string to a real).
         /**
@@ -111,31 +249,72 @@
          */
         bool relative_atof ( const std::string & s , bool & relative );
         
-        /// Reset the Double.
-        void clear ( void ) { _value = 0.0; _defined = false; }
+        /// Parse a value from a range of characters.
+        /**
+         - Does not allocate memory, and the range does not need to be
+           null-terminated.
+         - Leading spaces, tabs and end of line characters are skipped. The
+           value ends at the next one of these characters, or at \c last.
+         - Accepts the same values as \c atof(): numbers, \c "-" and the
+           undefined value string, \c "INF", \c "+INF" and \c "-INF" in any
+           case, and the infinity string with an optional sign.
+         - Whole lines of coordinates can be parsed in place by advancing
+           \c first by the returned length.
+         \param first Pointer to the first character -- \b IN.
+         \param last  Pointer past the last character -- \b IN.
+         \return The number of characters consumed, or \c 0 if no valid value
+                 was found (the NOMAD::Double is then unchanged).
+         */
+        size_t parse ( const char * first , const char * last );
+        
+        /// Parse a value, possibly relative, from a range of characters.
+        /**
+         Same as \c parse(), with a value that may begin with \c 'r' to
+         indicate a proportion (relative value), as \c relative_atof().
+         \param first    Pointer to the first character -- \b IN.
+         \param last     Pointer past the last character -- \b IN.
+         \param relative A boolean indicating if the conversion was relative -- \b OUT.
+         \return The number of characters consumed, or \c 0 if no valid value
+                 was found.
+         */
+        size_t relative_parse ( const char * first , const char * last , bool & relative );
         
-        /// Reset the Double.
-        void reset ( void ) { clear(); }
+    private:
         
-        /// Affectation operator #1.
+        /// Set the value from a token that must be entirely valid.
         /**
-         \param d The right-hand side object -- \b IN.
-         \return \c *this as the result of the affectation.
+         \param first Pointer to the first character of the token -- \b IN.
+         \param last  Pointer past the last character of the token -- \b IN.
+         \return A boolean equal to \c true if the token was valid.
          */
-        Double & operator = ( const Double & d );
+        bool parse_token ( const char * first , const char * last );
+        
+    public:
+        
+        /// Reset the Double.
+        void clear ( void ) { _value = undef_value(); }
+        
+        /// Reset the Double.
+        void reset ( void ) { clear(); }
         
         /// Affectation operator #2.
         /**
+         The affectation operator #1 (from a NOMAD::Double) is implicit.
          \param r The right-hand side \c double -- \b IN.
          \return \c *this as the result of the affectation.
          */
-        Double & operator = ( double r );
+        Double & operator = ( double r ) { _value = r; return *this; }
         
         /// Access to the \c double value.
         /**
          \return The \c double value.
          */
-        const double & todouble ( void ) const;
+        const double & todouble ( void ) const
+        {
+            check ( is_defined() , __LINE__ ,
+                    "NOMAD::Double::todouble(): value not defined" );
+            return _value;
+        }
         
         /// Return the value as a string.
         /**
@@ -143,11 +322,111 @@
          */
         const std::string tostring ( void ) const;
         
+        /// Write the value in a caller-supplied buffer.
+        /**
+         - Does not allocate memory.
+         - Same format as \c tostring(), or as \c operator<< with a default
+           \c std::ostream when \c int_display is \c true.
+         - As \c snprintf, the output is truncated to \c size-1 characters
+           and null-terminated.
+         \param buf         The buffer -- \b OUT.
+         \param size        The size of the buffer -- \b IN.
+         \param int_display Display integer values as integers
+                            -- \b IN -- \b optional (default=\c false).
+         \param precision   Number of significant digits, or \c SHORTEST_PRECISION
+                            -- \b IN -- \b optional (default=\c DEFAULT_PRECISION).
+         \return The length of the complete output, as \c snprintf.
+         */
+        int snprint ( char * buf                           ,
+                      size_t size                          ,
+                      bool   int_display = false           ,
+                      int    precision   = DEFAULT_PRECISION ) const;
+        
+        /// Append the value to a string.
+        /**
+         Same format as \c snprint(), without temporary strings.
+         \param s           The string -- \b IN/OUT.
+         \param int_display Display integer values as integers
+                            -- \b IN -- \b optional (default=\c false).
+         \param precision   Number of significant digits, or \c SHORTEST_PRECISION
+                            -- \b IN -- \b optional (default=\c DEFAULT_PRECISION).
+         */
+        void append_to ( std::string & s                     ,
+                         bool          int_display = false   ,
+                         int           precision   = DEFAULT_PRECISION ) const;
+        
+        /// Write a \c double in a caller-supplied buffer.
+        /**
+         - Does not allocate memory.
+         - Same format as \c operator<< for a \c double with a default
+           \c std::ostream, except for the precision.
+         - With \c SHORTEST_PRECISION, writes the shortest digits that
+           are read back as the same \c double.
+         \param buf       The buffer -- \b OUT.
+         \param size      The size of the buffer -- \b IN.
+         \param value     The \c double -- \b IN.
+         \param precision Number of significant digits, or \c SHORTEST_PRECISION
+                          -- \b IN -- \b optional (default=\c DEFAULT_PRECISION).
+         \return The length of the complete output, as \c snprintf.
+         */
+        static int snprint_double ( char * buf                           ,
+                                    size_t size                          ,
+                                    double value                         ,
+                                    int    precision = DEFAULT_PRECISION   );
+        
         /// Is the value defined ?
         /**
          \return A boolean equal to \c true if the NOMAD::Double is defined.
          */
-        bool is_defined  ( void ) const { return _defined; }
+        bool is_defined  ( void ) const { return !is_undef_value ( _value ); }
+        
+        /// Is the value a NaN ?
+        /**
+         An undefined value is a NaN. With \c UNCHECKED_DOUBLE, any NaN
+         resulting from arithmetic on an undefined value is also a NaN,
+         even when its payload is not \c UNDEF_BITS anymore.
+         \return A boolean equal to \c true if the value is a NaN.
+         */
+        bool is_nan ( void ) const { return _value != _value; }
+        
+        /// Validation of a NOMAD::Double, typically the result of a batch.
+        /**
+         Throws a NOMAD::Double::Not_Defined exception if the value is
+         undefined. With \c UNCHECKED_DOUBLE, any NaN is considered
+         undefined, since undefined values propagate as NaN.
+         */
+        void check_defined ( void ) const
+        {
+#ifdef UNCHECKED_DOUBLE
+            if ( is_nan() )
+#else
+            if ( !is_defined() )
+#endif
+                throw_not_defined ( __LINE__ ,
+                                    "NOMAD::Double::check_defined(): value not defined" );
+        }
+        
+        /// Batch validation of an array of NOMAD::Double.
+        /**
+         Throws a NOMAD::Double::Not_Defined exception if one of the values
+         is undefined. With \c UNCHECKED_DOUBLE, any NaN is considered
+         undefined, since undefined values propagate as NaN.
+         \param first Pointer to the first value -- \b IN.
+         \param last  Pointer past the last value -- \b IN.
+         */
+        static void check_defined ( const Double * first , const Double * last )
+        {
+            bool ok = true;
+            for ( ; first != last ; ++first )
+#ifdef UNCHECKED_DOUBLE
+                ok &= !first->is_nan();
+#else
+                ok &= first->is_defined();
+#endif
+            if ( !ok )
+                throw_not_defined ( __LINE__ ,
+                                    "NOMAD::Double::check_defined(): value not defined" );
+        }
         
         /// Is the value an integer ?
         /**
@@ -166,48 +445,97 @@
          The size of an object in memory.
          \return An integer value for the size in bytes.
          */
-        int mem_sizeof ( void ) const { return sizeof(_defined) + sizeof(_value); }
+        int mem_sizeof ( void ) const { return sizeof(_value); }
+        
+        /// Access to the numeric context of the current thread.
+        /**
+         \return The context of the current thread.
+         */
+        static NOMAD::DoubleContext & get_context ( void ) { return *Double::_context; }
+        
+        /// Access to the default numeric context.
+        /**
+         The default context is used by all threads that did not set their
+         own context.
+         \return The default context.
+         */
+        static NOMAD::DoubleContext & get_default_context ( void )
+        {
+            return Double::_default_context;
+        }
+        
+        /// Set the numeric context of the current thread.
+        /**
+         The context is not copied and must remain alive while it is used.
+         \param context The new context, or \c NULL for the default context -- \b IN.
+         \return The previous context of the current thread.
+         */
+        static NOMAD::DoubleContext * set_context ( NOMAD::DoubleContext * context )
+        {
+            NOMAD::DoubleContext * previous = Double::_context;
+            Double::_context = context ? context : &Double::_default_context;
+            return previous;
+        }
+        
+        /// Set the numeric context of the current thread for a scope.
+        /**
+         The previous context is restored on destruction.
+         */
+        class Context_Scope : private NOMAD::Uncopyable {
+        private:
+            NOMAD::DoubleContext * _previous; ///< Context to restore.
+        public:
+            /// Constructor.
+            /**
+             \param context The context of the current thread -- \b IN.
+             */
+            explicit Context_Scope ( NOMAD::DoubleContext & context )
+            : _previous ( NOMAD::Double::set_context ( &context ) ) {}
+            
+            /// Destructor.
+            ~Context_Scope ( void ) { NOMAD::Double::set_context ( _previous ); }
+        };
         
         /// Access to the NOMAD::Double precision.
         /**
-         \return A \c double for the precision.
+         \return A \c double for the precision of the current context.
          */
-        static double get_epsilon ( void )  { return Double::_epsilon; }
+        static double get_epsilon ( void )  { return Double::_context->get_epsilon(); }
         
         /// Set the NOMAD::Double precision.
         /**
-         \param eps The precision -- \b IN.
+         \param eps The precision of the current context -- \b IN.
          */
-        static void set_epsilon ( double eps );
+        static void set_epsilon ( double eps ) { Double::_context->set_epsilon ( eps ); }
         
         /// Access to the undefined value string.
         /**
-         \return A \c std::string for the undefined value string.
+         \return A \c std::string for the undefined value string of the current context.
          */
-        static std::string get_undef_str ( void ) { return Double::_undef_str; }
+        static std::string get_undef_str ( void ) { return Double::_context->get_undef_str(); }
         
         /// Set the NOMAD::Double undefined value string.
         /**
-         \param undef_str The undefined value string -- \b IN.
+         \param undef_str The undefined value string of the current context -- \b IN.
          */
         static void set_undef_str ( const std::string & undef_str )
         {
-            NOMAD::Double::_undef_str = undef_str;
+            Double::_context->set_undef_str ( undef_str );
         }
         
         /// Access to the infinity string.
         /**
-         \return A \c std::string for the infinity string.
+         \return A \c std::string for the infinity string of the current context.
          */
-        static std::string get_inf_str ( void ) { return Double::_inf_str; }
+        static std::string get_inf_str ( void ) { return Double::_context->get_inf_str(); }
         
         /// Set the NOMAD::Double infinity string.
         /**
-         \param inf_str The infinity string -- \b IN.
+         \param inf_str The infinity string of the current context -- \b IN.
          */
         static void set_inf_str ( const std::string & inf_str )
         {
-            NOMAD::Double::_inf_str = inf_str;
+            Double::_context->set_inf_str ( inf_str );
         }
         
         /// Rounding to int.
@@ -241,19 +569,35 @@
         /**
          \return Another NOMAD::Double equal to max{\c -*this,\c *this}.
          */
-        const Double abs ( void ) const;
+        const Double abs ( void ) const
+        {
+            check ( is_defined() , __LINE__ , "NOMAD::Double::abs(): value not defined" );
+            return fabs ( _value );
+        }
         
         /// Square.
         /**
          \return Another NOMAD::Double equal to \c *this \c * \c *this.
          */
-        const Double pow2 ( void ) const;
+        const Double pow2 ( void ) const
+        {
+            check ( is_defined() , __LINE__ , "NOMAD::Double::pow2(): value not defined" );
+            return _value * _value;
+        }
         
         /// Square root.
         /**
          \return Another NOMAD::Double equal to \c (*this)^0.5.
          */
-        const Double sqrt ( void ) const;
+        const Double sqrt ( void ) const
+        {
+            check ( is_defined() , __LINE__ , "NOMAD::Double::sqrt(): value not defined" );
+#ifndef UNCHECKED_DOUBLE
+            if ( _value < -get_epsilon() )
+                throw_invalid_value ( __LINE__ , "NOMAD::Double::sqrt(x): x < 0" );
+#endif
+            return std::sqrt ( _value );
+        }
         
         /// Relative error with another NOMAD::Double.
         /**
@@ -294,7 +638,13 @@
          \param d1 The increment -- \b IN.
          \return The NOMAD::Double plus \c d1.
          */
-        const Double & operator += ( const Double & d1 );
+        const Double & operator += ( const Double & d1 )
+        {
+            check ( is_defined() && d1.is_defined() , __LINE__ ,
+                    "NOMAD::Double: d1 += d2: d1 or d2 not defined" );
+            _value += d1._value;
+            return *this;
+        }
         
         /// Operator \c -=.
         /**
@@ -302,7 +652,13 @@
          \param d1 The decrement -- \b IN.
          \return The NOMAD::Double minus \c d1.
          */
-        const Double & operator -= ( const Double & d1 );
+        const Double & operator -= ( const Double & d1 )
+        {
+            check ( is_defined() && d1.is_defined() , __LINE__ ,
+                    "NOMAD::Double: d1 -= d2: d1 or d2 not defined" );
+            _value -= d1._value;
+            return *this;
+        }
         
         /// Operator \c *=.
         /**
@@ -310,7 +666,13 @@
          \param d1 The factor -- \b IN.
          \return The NOMAD::Double times \c d1.
          */
-        const Double & operator *= ( const Double & d1 );
+        const Double & operator *= ( const Double & d1 )
+        {
+            check ( is_defined() && d1.is_defined() , __LINE__ ,
+                    "NOMAD::Double: d1 *= d2: d1 or d2 not defined" );
+            _value *= d1._value;
+            return *this;
+        }
         
         /// Operator \c /=.
         /**
@@ -318,7 +680,17 @@
          \param d1 The denominator -- \b IN.
          \return The NOMAD::Double divided by \c d1.
          */
-        const Double & operator /= ( const Double & d1 );
+        const Double & operator /= ( const Double & d1 )
+        {
+            check ( is_defined() && d1.is_defined() , __LINE__ ,
+                    "NOMAD::Double: d1 /= d2: d1 or d2 not defined" );
+#ifndef UNCHECKED_DOUBLE
+            if ( d1._value == 0.0 )
+                throw_invalid_value ( __LINE__ , "NOMAD::Double: d1 /= d2: division by zero" );
+#endif
+            _value /= d1._value;
+            return *this;
+        }
         
         /// Comparison <.
         /**
@@ -343,6 +715,27 @@
                               const Double & delta         ,
                               const Double & lb = Double() ,
                               const Double & ub = Double()   );
+        
+        /// Projection to the mesh of an array of values.
+        /**
+         Same result as \c project_to_mesh() on each value \c x[i], with
+         the \c ref[i], \c delta[i], \c lb[i] and \c ub[i] arguments.
+         The loop does not branch on the values and does not throw.
+         \param x      The values to project -- \b IN/OUT.
+         \param n      Number of values -- \b IN.
+         \param ref    References for projection, or \c NULL for zeros -- \b IN.
+         \param delta  Mesh size parameters -- \b IN.
+         \param lb     Lower bounds, or \c NULL for no bounds -- \b IN
+                       -- \b optional (default=NULL).
+         \param ub     Upper bounds, or \c NULL for no bounds -- \b IN
+                       -- \b optional (default=NULL).
+         */
+        static void project_to_mesh ( Double       * x           ,
+                                      int            n           ,
+                                      const Double * ref         ,
+                                      const Double * delta       ,
+                                      const Double * lb   = NULL ,
+                                      const Double * ub   = NULL   );
     
 /*
         /// Display.
@@ -437,7 +830,11 @@
      \param d2 The second NOMAD::Double -- \b IN.
      \return   A third NOMAD::Double as the result of the operation.
      */
-    const Double operator / ( const Double & d1 , const Double & d2 );
+    inline const Double operator / ( const Double & d1 , const Double & d2 )
+    {
+        NOMAD::Double d = d1;
+        return d /= d2;
+    }
     
     /// Comparison operator \c ==.
     /**
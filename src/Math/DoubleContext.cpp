@@ -0,0 +1,30 @@
+/**
+ \file   DoubleContext.cpp
+ \brief  Numeric context of NOMAD::Double (implementation)
+ \see    DoubleContext.hpp
+ */
+#include "Math/DoubleContext.hpp"
+
+/*-----------------------------------------------*/
+/*                  constructor                  */
+/*-----------------------------------------------*/
+NOMAD::DoubleContext::DoubleContext ( double              epsilon   ,
+                                      const std::string & inf_str   ,
+                                      const std::string & undef_str   )
+: _epsilon   ( NOMAD::DEFAULT_EPSILON ) ,
+  _inf_str   ( inf_str                ) ,
+  _undef_str ( undef_str              )
+{
+    set_epsilon ( epsilon );
+}
+
+/*-----------------------------------------------*/
+/*                  set epsilon                  */
+/*-----------------------------------------------*/
+void NOMAD::DoubleContext::set_epsilon ( double eps )
+{
+    if ( eps <= 0.0 )
+        throw NOMAD::Exception ( "DoubleContext.cpp" , __LINE__ ,
+                                "NOMAD::DoubleContext::set_epsilon(): invalid epsilon" );
+    _epsilon = eps;
+}
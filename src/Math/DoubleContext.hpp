@@ -0,0 +1,89 @@
+/**
+ \file   DoubleContext.hpp
+ \brief  Numeric context of NOMAD::Double (headers)
+ \see    DoubleContext.cpp
+ */
+#ifndef __NOMAD400_DOUBLE_CONTEXT__
+#define __NOMAD400_DOUBLE_CONTEXT__
+
+#include <string>
+
+#include "Util/defines.hpp"
+#include "Util/Exception.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Numeric context of NOMAD::Double.
+    /**
+     - Holds the precision used on comparisons, and the strings used to
+       display and read infinite and undefined values.
+     - NOMAD::Double consults the context of the current thread
+       (see NOMAD::Double::set_context()). By default, all threads share
+       the default context (NOMAD::Double::get_default_context()).
+     - To run optimizations with different settings in parallel, give
+       each thread its own context. A context must not be modified while
+       another thread uses it.
+     */
+    class DoubleContext {
+
+    private:
+
+        double      _epsilon;    ///< Desired precision on comparisons.
+        std::string _inf_str;    ///< Infinity string.
+        std::string _undef_str;  ///< Undefined value string.
+
+    public:
+
+        /// Constructor.
+        /**
+         \param epsilon   The precision        -- \b IN
+                          (opt, default = NOMAD::DEFAULT_EPSILON).
+         \param inf_str   The infinity string  -- \b IN
+                          (opt, default = NOMAD::DEFAULT_INF_STR).
+         \param undef_str The undefined string -- \b IN
+                          (opt, default = NOMAD::DEFAULT_UNDEF_STR).
+         */
+        explicit DoubleContext ( double              epsilon   = NOMAD::DEFAULT_EPSILON   ,
+                                 const std::string & inf_str   = NOMAD::DEFAULT_INF_STR   ,
+                                 const std::string & undef_str = NOMAD::DEFAULT_UNDEF_STR   );
+
+        /// Access to the precision.
+        /**
+         \return A \c double for the precision.
+         */
+        double get_epsilon ( void ) const { return _epsilon; }
+
+        /// Set the precision.
+        /**
+         \param eps The precision -- \b IN.
+         */
+        void set_epsilon ( double eps );
+
+        /// Access to the infinity string.
+        /**
+         \return A \c std::string for the infinity string.
+         */
+        const std::string & get_inf_str ( void ) const { return _inf_str; }
+
+        /// Set the infinity string.
+        /**
+         \param inf_str The infinity string -- \b IN.
+         */
+        void set_inf_str ( const std::string & inf_str ) { _inf_str = inf_str; }
+
+        /// Access to the undefined value string.
+        /**
+         \return A \c std::string for the undefined value string.
+         */
+        const std::string & get_undef_str ( void ) const { return _undef_str; }
+
+        /// Set the undefined value string.
+        /**
+         \param undef_str The undefined value string -- \b IN.
+         */
+        void set_undef_str ( const std::string & undef_str ) { _undef_str = undef_str; }
+    };
+
+#include "nomad_nsend.hpp"
+
+#endif
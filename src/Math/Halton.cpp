@@ -0,0 +1,246 @@
+/**
+ \file   Halton.cpp
+ \brief  Scrambled Halton sequence (implementation)
+ \see    Halton.hpp
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include "Math/DesignBounds.hpp"
+#include "Math/Halton.hpp"
+#include "Util/Exception.hpp"
+
+/*-----------------------------------------------------------*/
+/*                         constructor                       */
+/*-----------------------------------------------------------*/
+NOMAD::Halton::Halton ( int n , int p , int seed )
+  : _n            ( n    ) ,
+    _p            ( p    ) ,
+    _seed         ( seed ) ,
+    _scrambling   ( true ) ,
+    _lb           ( )      ,
+    _ub           ( )      ,
+    _bases        ( )      ,
+    _offsets      ( )      ,
+    _powers       ( )      ,
+    _denominators ( )      ,
+    _factors      ( )      ,
+    _shifts       ( )      ,
+    _digits       ( )      ,
+    _nums         ( )      ,
+    _next         ( 0    )
+{
+    if ( n <= 0 || n > NOMAD::MAX_DIMENSION || p < 0 )
+        throw NOMAD::Exception ( "Halton.cpp" , __LINE__ ,
+                                "NOMAD::Halton::Halton(): bad dimension or number of samples" );
+    _lb.assign ( n , 0.0 );
+    _ub.assign ( n , 1.0 );
+
+    // The first n primes
+    for ( int b = 2 ; static_cast<int> ( _bases.size() ) < _n ; ++b )
+    {
+        bool prime = true;
+        for ( size_t k = 0 ; k < _bases.size() && _bases[k] * _bases[k] <= b ; ++k )
+            if ( b % _bases[k] == 0 )
+            {
+                prime = false;
+                break;
+            }
+        if ( prime )
+            _bases.push_back ( b );
+    }
+
+    // K digits, enough for the index INT_MAX: b^K <= b*INT_MAX < 2^53
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        const uint64_t b = _bases[i];
+        int            K = 0;
+        for ( uint64_t bk = 1 ; bk <= static_cast<uint64_t> ( INT_MAX ) ; bk *= b )
+            ++K;
+        _offsets.push_back ( static_cast<int> ( _powers.size() ) );
+        uint64_t bk = 1;
+        for ( int j = 0 ; j < K ; ++j )
+            bk *= b;
+        _denominators.push_back ( static_cast<double> ( bk ) );
+        for ( int j = 0 ; j < K ; ++j )
+        {
+            bk /= b;
+            _powers.push_back ( bk );
+        }
+    }
+    _offsets.push_back ( static_cast<int> ( _powers.size() ) );
+
+    set_factors();
+    digits ( 0 , _digits , _nums );
+}
+
+/*-----------------------------------------------------------*/
+/*                         scrambling                        */
+/*-----------------------------------------------------------*/
+void NOMAD::Halton::set_seed ( int seed )
+{
+    _seed = seed;
+    set_factors();
+    digits ( _next , _digits , _nums );
+}
+
+void NOMAD::Halton::set_scrambling ( bool scrambling )
+{
+    _scrambling = scrambling;
+    digits ( _next , _digits , _nums );
+}
+
+void NOMAD::Halton::set_factors ( void )
+{
+    _factors.resize ( _powers.size() );
+    _shifts.resize  ( _powers.size() );
+    const uint64_t seed = NOMAD::mix ( static_cast<uint64_t> ( _seed ) + 0x9E3779B97F4A7C15ULL );
+    for ( int i = 0 ; i < _n ; ++i )
+        for ( int j = _offsets[i] ; j < _offsets[i+1] ; ++j )
+        {
+            _factors[j] = 1 + static_cast<int> ( NOMAD::mix ( seed ^ ( static_cast<uint64_t> ( j ) * 0xD1B54A32D192ED03ULL ) )
+                                                 % static_cast<uint64_t> ( _bases[i] - 1 ) );
+            _shifts[j]  =     static_cast<int> ( NOMAD::mix ( seed ^ ( static_cast<uint64_t> ( j ) * 0x9E3779B97F4A7C15ULL ) )
+                                                 % static_cast<uint64_t> ( _bases[i] ) );
+        }
+}
+
+/*-----------------------------------------------------------*/
+/*                            bounds                         */
+/*-----------------------------------------------------------*/
+void NOMAD::Halton::set_bounds ( const std::vector<double> & l , const std::vector<double> & u )
+{
+    const char * error = NOMAD::check_design_bounds ( l , u , _n );
+    if ( error )
+        throw NOMAD::Exception ( "Halton.cpp" , __LINE__ ,
+                                std::string ( "NOMAD::Halton::set_bounds(): " ) + error );
+    _lb = l;
+    _ub = u;
+}
+
+void NOMAD::Halton::set_bounds ( const NOMAD::Point & l , const NOMAD::Point & u )
+{
+    const char * error = NOMAD::check_design_bounds ( l , u , _n , _lb , _ub );
+    if ( error )
+        throw NOMAD::Exception ( "Halton.cpp" , __LINE__ ,
+                                std::string ( "NOMAD::Halton::set_bounds(): " ) + error );
+}
+
+/*-----------------------------------------------------------*/
+/*                            digits                         */
+/*-----------------------------------------------------------*/
+void NOMAD::Halton::digits ( int k , std::vector<int> & digits , std::vector<uint64_t> & nums ) const
+{
+    digits.assign ( _powers.size() , 0 );
+    nums.assign   ( _n , 0 );
+    // k+1 <= INT_MAX has at most K digits. The zeros are scrambled too.
+    const int64_t index = static_cast<int64_t> ( std::min ( k , INT_MAX - 1 ) ) + 1;
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        int64_t q = index;
+        for ( int j = _offsets[i] ; j < _offsets[i+1] ; ++j )
+        {
+            digits[j] = static_cast<int> ( q % _bases[i] );
+            nums[i]  += permute ( i , j , digits[j] ) * _powers[j];
+            q        /= _bases[i];
+        }
+    }
+}
+
+// The numerators are updated with the digits that change: one digit, and
+// 1/(b-1) digits set to zero on average.
+void NOMAD::Halton::increment ( std::vector<int> & digits , std::vector<uint64_t> & nums ) const
+{
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        const int b = _bases[i];
+        for ( int j = _offsets[i] ; j < _offsets[i+1] ; ++j )
+        {
+            const int d = digits[j];
+            nums[i] -= permute ( i , j , d ) * _powers[j];
+            if ( d + 1 < b )
+            {
+                digits[j] = d + 1;
+                nums[i]  += permute ( i , j , d + 1 ) * _powers[j];
+                break;
+            }
+            digits[j] = 0;
+            nums[i]  += permute ( i , j , 0 ) * _powers[j];
+        }
+    }
+}
+
+void NOMAD::Halton::scale ( const std::vector<uint64_t> & nums , NOMAD::PointSet::Slice y ) const
+{
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        const double t = static_cast<double> ( nums[i] ) / _denominators[i];
+        y[i] = std::min ( _lb[i] + t * ( _ub[i] - _lb[i] ) , _ub[i] );
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                           sampling                        */
+/*-----------------------------------------------------------*/
+void NOMAD::Halton::seek ( int k )
+{
+    _next = std::min ( std::max ( k , 0 ) , _p );
+    digits ( _next , _digits , _nums );
+}
+
+void NOMAD::Halton::Sample ( int k , NOMAD::Point & x ) const
+{
+    if ( k < 0 || k == INT_MAX )
+        throw NOMAD::Exception ( "Halton.cpp" , __LINE__ ,
+                                "NOMAD::Halton::Sample(): bad index" );
+    if ( x.get_size() != _n )
+        x = NOMAD::Point ( _n );
+    std::vector<int>      d;
+    std::vector<uint64_t> nums;
+    digits ( k , d , nums );
+    scale ( nums , NOMAD::PointSet::Slice ( &x[0] , _n , 1 ) );
+}
+
+void NOMAD::Halton::Sample ( NOMAD::PointSet & points ) const
+{
+    if ( points.get_nb_points() != _p || points.get_dimension() != _n )
+        points = NOMAD::PointSet ( _p , _n , points.get_layout() );
+
+    std::vector<int>      d;
+    std::vector<uint64_t> nums;
+    digits ( 0 , d , nums );
+    for ( int k = 0 ; k < _p ; ++k )
+    {
+        if ( k > 0 )
+            increment ( d , nums );
+        scale ( nums , points.row ( k ) );
+    }
+}
+
+bool NOMAD::Halton::next ( NOMAD::Point & x )
+{
+    if ( done() )
+        return false;
+    if ( x.get_size() != _n )
+        x = NOMAD::Point ( _n );
+    scale ( _nums , NOMAD::PointSet::Slice ( &x[0] , _n , 1 ) );
+    if ( ++_next < _p )
+        increment ( _digits , _nums );
+    return true;
+}
+
+int NOMAD::Halton::next ( NOMAD::PointSet & block )
+{
+    if ( block.get_dimension() != _n )
+        throw NOMAD::Exception ( "Halton.cpp" , __LINE__ ,
+                                "NOMAD::Halton::next(): bad dimension" );
+    const int nb = std::min ( block.get_nb_points() , _p - _next );
+    for ( int r = 0 ; r < nb ; ++r )
+    {
+        scale ( _nums , block.row ( r ) );
+        if ( ++_next < _p )
+            increment ( _digits , _nums );
+    }
+    return nb;
+}
@@ -0,0 +1,208 @@
+/**
+ \file   Halton.hpp
+ \brief  Scrambled Halton sequence (headers)
+ \see    Halton.cpp
+ */
+
+#ifndef __NOMAD400_HALTON__
+#define __NOMAD400_HALTON__
+
+#include <vector>
+
+#include "Math/Point.hpp"
+#include "Math/PointSet.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the Halton low-discrepancy sequence, with the interface of NOMAD::LHS.
+    /**
+     - Dimension \c n, at most NOMAD::MAX_DIMENSION, \c p samples, a seed,
+       and bounds: \c [0,1]^n by default, or set_bounds().
+     - Coordinate \c i is the radical inverse in base \c b, the \c (i+1)th
+       prime number. Sample \c k is the radical inverse of \c k+1: the
+       origin is skipped. Each coordinate is stratified: the first
+       \c b^m-1 samples and the origin (scrambled like the samples) have
+       one value in each interval of width \c b^-m.
+     - The digits of the next sample are updated with a carry, in \c O(1)
+       per coordinate on average. Sample \c k is also available directly,
+       in \c O(n*K), to shard the samples between workers with seek().
+       Values are exact fractions of \c b^K, \c b^K<=2^53.
+     - Scrambling (default): the digit \c d of position \c j of coordinate
+       \c i is replaced by \c (a*d+c) \c mod \c b, with \c a in \c [1,b-1]
+       and \c c in \c [0,b-1] drawn from the seed, \c i and \c j (random
+       linear scrambling with a digit shift). The shift also scrambles
+       base 2, where \c a=1. It applies to the \c K digits, zeros
+       included, and keeps the stratification. Without scrambling, the
+       sequence is the original Halton sequence.
+     */
+    class Halton {
+    private:
+
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        int                     _n;           // Dimension
+        int                     _p;           // Number of samples
+        int                     _seed;        // Seed of the scrambling
+        bool                    _scrambling;  // Scrambling of the samples
+        std::vector<double>     _lb;          // Lower bounds
+        std::vector<double>     _ub;          // Upper bounds
+        std::vector<int>        _bases;       // Prime base of each coordinate
+        std::vector<int>        _offsets;     // First digit of each coordinate in _powers, _factors and the digits
+        std::vector<uint64_t>   _powers;      // b^(K-1-j) for the digit j, of weight b^-(j+1)
+        std::vector<double>     _denominators; // b^K for each coordinate
+        std::vector<int>        _factors;     // Scrambling factor of each digit
+        std::vector<int>        _shifts;      // Scrambling shift of each digit
+        std::vector<int>        _digits;      // Digits of the index _next+1, lowest first
+        std::vector<uint64_t>   _nums;        // Numerators of the sample _next
+        int                     _next;        // Index of the next sample
+
+        /// Scrambled digit.
+        /**
+         \param i The coordinate -- \b IN.
+         \param j The index of the digit in _factors -- \b IN.
+         \param d The digit -- \b IN.
+         \return  The scrambled digit.
+         */
+        uint64_t permute ( int i , int j , int d ) const
+        {
+            return ( _scrambling ) ? static_cast<uint64_t> ( ( _factors[j] * d + _shifts[j] ) % _bases[i] ) : d;
+        }
+
+        /// Digits and numerators of the index \c k+1.
+        /**
+         \param k      The index -- \b IN.
+         \param digits The digits of all the coordinates -- \b OUT.
+         \param nums   The numerators of all the coordinates -- \b OUT.
+         */
+        void digits ( int k , std::vector<int> & digits , std::vector<uint64_t> & nums ) const;
+
+        /// Add one to the digits.
+        /**
+         \param digits The digits of all the coordinates -- \b IN/OUT.
+         \param nums   The numerators of all the coordinates -- \b IN/OUT.
+         */
+        void increment ( std::vector<int> & digits , std::vector<uint64_t> & nums ) const;
+
+        /// Scaling of the numerators of a sample.
+        /**
+         \param nums The numerators of all the coordinates -- \b IN.
+         \param y    The sample -- \b OUT.
+         */
+        void scale ( const std::vector<uint64_t> & nums , NOMAD::PointSet::Slice y ) const;
+
+        /// Scrambling factors and shifts, from the seed.
+        void set_factors ( void );
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /**
+         \param n    Dimension -- \b IN -- \b optional (default = 1).
+         \param p    Number of samples -- \b IN -- \b optional (default = 1).
+         \param seed Seed of the scrambling -- \b IN -- \b optional (default = 2920).
+         */
+        explicit Halton ( int n = 1 , int p = 1 , int seed = 2920 );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the dimension.
+        int get_dimension ( void ) const { return _n; }
+
+        /// Access to the number of samples.
+        int get_nb_samples ( void ) const { return _p; }
+
+        /// Access to the base of a coordinate.
+        /**
+         \param i The coordinate -- \b IN.
+         \return  The prime base.
+         */
+        int get_base ( int i ) const { return _bases[i]; }
+
+        /// Access to the seed.
+        int get_seed ( void ) const { return _seed; }
+
+        /// Set the seed of the scrambling.
+        /**
+         \param seed The seed -- \b IN.
+         */
+        void set_seed ( int seed );
+
+        /// Access to the scrambling.
+        bool get_scrambling ( void ) const { return _scrambling; }
+
+        /// Set the scrambling.
+        /**
+         \param scrambling Scramble the samples -- \b IN.
+         */
+        void set_scrambling ( bool scrambling );
+
+        /// Access to the lower bounds.
+        const std::vector<double> & get_lb ( void ) const { return _lb; }
+
+        /// Access to the upper bounds.
+        const std::vector<double> & get_ub ( void ) const { return _ub; }
+
+        /// Set the bounds.
+        /**
+         \param l The lower bounds -- \b IN.
+         \param u The upper bounds, with \c l<=u, finite -- \b IN.
+         */
+        void set_bounds ( const std::vector<double> & l , const std::vector<double> & u );
+
+        /// Set the bounds.
+        /**
+         \param l The lower bounds, defined -- \b IN.
+         \param u The upper bounds, defined -- \b IN.
+         */
+        void set_bounds ( const NOMAD::Point & l , const NOMAD::Point & u );
+
+        /// Access to the index of the next sample.
+        int get_index ( void ) const { return _next; }
+
+        /// Set the index of the next sample (skip-ahead).
+        /**
+         \param k The index, in \c [0,p] -- \b IN.
+         */
+        void seek ( int k );
+
+        /// Are all the samples generated ?
+        bool done ( void ) const { return _next >= _p; }
+
+        /*----------*/
+        /* Sampling */
+        /*----------*/
+        /// Sample \c k.
+        /**
+         \param k The index, in \c [0,INT_MAX-1] -- \b IN.
+         \param x The sample -- \b OUT.
+         */
+        void Sample ( int k , NOMAD::Point & x ) const;
+
+        /// All the samples.
+        /**
+         \param points A set of \c p points of dimension \c n -- \b OUT.
+         */
+        void Sample ( NOMAD::PointSet & points ) const;
+
+        /// Next sample.
+        /**
+         \param x The sample -- \b OUT.
+         \return  A boolean equal to \c false if all the samples are generated.
+         */
+        bool next ( NOMAD::Point & x );
+
+        /// Next samples.
+        /**
+         \param block A set of points of dimension \c n -- \b OUT.
+         \return      The number of samples in the first rows of \c block,
+                      less than its number of points at the end.
+         */
+        int next ( NOMAD::PointSet & block );
+    };
+
+#include "nomad_nsend.hpp"
+#endif
@@ -1,8 +1,265 @@
 
+#include "Math/DesignBounds.hpp"
 #include "Math/LHS.hpp"
 #include "Math/RNG.hpp"
+#include "Util/Exception.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+    // Number of rounds of the Feistel network
+    const int FEISTEL_ROUNDS = 4;
+
+    // Small generator for the optimization of the designs (splitmix64)
+    class Generator
+    {
+    private:
+        uint64_t _s;
+
+    public:
+        explicit Generator(uint64_t seed) : _s(seed) {}
+
+        uint64_t next(void)
+        {
+            _s += 0x9E3779B97F4A7C15ULL;
+            return NOMAD::mix(_s);
+        }
+
+        // Uniform in [0,1)
+        double uniform(void) { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+        // Uniform in (0, 1, .., m-1)
+        int below(int m) { return static_cast<int>((next() >> 32) * m >> 32); }
+    };
+
+    // Latin hypercube of p samples in dimension n, as cells (0, 1, .., p-1),
+    // optimized for the maximin criterion by simulated annealing.
+    // The distances are in cells: the squared distances are integers, and
+    // are exact in double. Only the sum of the terms of the criterion is
+    // updated, and recomputed from time to time.
+    class MaximinDesign
+    {
+    private:
+        int _n;
+        int _p;
+        std::vector<int>    _cells;     // Cell of sample j for coordinate i: _cells[i*p+j]
+        std::vector<double> _d2;        // Squared distances between the samples
+        std::vector<double> _new_a;     // Squared distances to sample a after an exchange
+        std::vector<double> _new_b;     // Squared distances to sample b after an exchange
+        double              _sum;       // Sum of term(d2) for all the pairs
+        Generator           _gen;
+
+        // Index of (row, column) in _cells and _d2, in size_t: p^2 and n*p
+        // may be larger than INT_MAX
+        size_t at(int row, int col) const { return static_cast<size_t>(row) * _p + col; }
+
+        // Exponent of the criterion: term = d^-20
+        static double term(double d2)
+        {
+            double t  = 1.0 / d2;
+            double t2 = t * t;
+            double t4 = t2 * t2;
+            double t8 = t4 * t4;
+            return t8 * t2;
+        }
+
+        void compute_distances(void)
+        {
+            _sum = 0.0;
+            for (int a = 0; a < _p; a++)
+            {
+                _d2[at(a, a)] = 0.0;
+                for (int b = a + 1; b < _p; b++)
+                {
+                    double d2 = 0.0;
+                    for (int i = 0; i < _n; i++)
+                    {
+                        double d = _cells[at(i, a)] - _cells[at(i, b)];
+                        d2 += d * d;
+                    }
+                    _d2[at(a, b)] = _d2[at(b, a)] = d2;
+                    _sum += term(d2);
+                }
+            }
+        }
+
+        // Change of the sum of the terms when exchanging the cells of the
+        // samples a and b for coordinate i, with the new distances in
+        // _new_a and _new_b.
+        double delta(int i, int a, int b)
+        {
+            const int *c = &_cells[at(i, 0)];
+            const double *da = &_d2[at(a, 0)];
+            const double *db = &_d2[at(b, 0)];
+            double diff = 0.0;
+            for (int j = 0; j < _p; j++)
+            {
+                double ea = c[a] - c[j];
+                double eb = c[b] - c[j];
+                double shift = eb * eb - ea * ea;
+                _new_a[j] = da[j] + shift;
+                _new_b[j] = db[j] - shift;
+                if (j != a && j != b)
+                {
+                    diff += term(_new_a[j]) + term(_new_b[j]) - term(da[j]) - term(db[j]);
+                }
+            }
+            return diff;
+        }
+
+        void exchange(int i, int a, int b, double diff)
+        {
+            std::swap(_cells[at(i, a)], _cells[at(i, b)]);
+            _new_a[a] = _new_b[b] = 0.0;
+            _new_a[b] = _new_b[a] = _d2[at(a, b)];
+            for (int j = 0; j < _p; j++)
+            {
+                _d2[at(a, j)] = _d2[at(j, a)] = _new_a[j];
+                _d2[at(b, j)] = _d2[at(j, b)] = _new_b[j];
+            }
+            _sum += diff;
+        }
+
+        // A random exchange
+        void pick(int &i, int &a, int &b)
+        {
+            i = _gen.below(_n);
+            a = _gen.below(_p);
+            b = _gen.below(_p - 1);
+            b += (b >= a);
+        }
+
+    public:
+        // The design is random after restart()
+        MaximinDesign(int n, int p)
+        :   _n(n),
+            _p(p),
+            _cells(static_cast<size_t>(n) * p),
+            _d2(static_cast<size_t>(p) * p),
+            _new_a(p),
+            _new_b(p),
+            _sum(0.0),
+            _gen(0)
+        {
+        }
+
+        // New random design, for the restart of this seed. The buffers are
+        // reused.
+        void restart(uint64_t seed)
+        {
+            _gen = Generator(seed);
+            _cells.resize(static_cast<size_t>(_n) * _p);
+
+            // Random permutations (Fisher-Yates)
+            for (int i = 0; i < _n; i++)
+            {
+                int *c = &_cells[at(i, 0)];
+                for (int j = 0; j < _p; j++)
+                {
+                    int k = _gen.below(j + 1);
+                    c[j] = c[k];
+                    c[k] = j;
+                }
+            }
+            compute_distances();
+        }
+
+        // Sum of term(d2), recomputed
+        double criterion(void)
+        {
+            compute_distances();
+            return _sum;
+        }
+
+        double min_d2(void) const
+        {
+            double d2 = NOMAD::INF;
+            for (int a = 0; a < _p; a++)
+            {
+                for (int b = a + 1; b < _p; b++)
+                {
+                    d2 = std::min(d2, _d2[at(a, b)]);
+                }
+            }
+            return d2;
+        }
+
+        // Exchange of the cells with a vector, which keeps a design with
+        // no copy. The design must be restarted before it is used again.
+        void swap_cells(std::vector<int> &cells) { _cells.swap(cells); }
+
+        // Simulated annealing on log(phi), with a temperature that decreases
+        // geometrically from T0 to T0/1000 with the budget used.
+        void optimize(int max_iterations, double max_time)
+        {
+            if (_p < 2 || (max_iterations <= 0 && max_time <= 0.0))
+            {
+                return;
+            }
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            const double q = 20.0;
+
+            // T0: mean increase of log(phi) on a few random exchanges, so
+            // that an average degradation is first accepted with a
+            // probability of 1/e.
+            int i, a, b;
+            double t0 = 0.0;
+            int nb_up = 0;
+            for (int k = 0; k < 100; k++)
+            {
+                pick(i, a, b);
+                double dlog = std::log1p(delta(i, a, b) / _sum) / q;
+                if (dlog > 0.0)
+                {
+                    t0 += dlog;
+                    nb_up++;
+                }
+            }
+            t0 = (nb_up > 0) ? t0 / nb_up : 1e-3;
+
+            double progress = 0.0;
+            double temperature = t0;
+            int nb_accepted = 0;
+            for (int it = 0; max_iterations <= 0 || it < max_iterations; it++)
+            {
+                // Budget used, checked every 64 iterations for the time
+                if ((it & 63) == 0)
+                {
+                    progress = (max_iterations > 0) ? static_cast<double>(it) / max_iterations : 0.0;
+                    if (max_time > 0.0)
+                    {
+                        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                        progress = std::max(progress, elapsed / max_time);
+                    }
+                    if (progress >= 1.0)
+                    {
+                        break;
+                    }
+                    temperature = t0 * std::pow(1e-3, progress);
+                }
+
+                pick(i, a, b);
+                double diff = delta(i, a, b);
+                double dlog = std::log1p(diff / _sum) / q;
+                if (dlog <= 0.0 || _gen.uniform() < std::exp(-dlog / temperature))
+                {
+                    exchange(i, a, b, diff);
+                    // The sum accumulates rounding errors.
+                    if (++nb_accepted % _p == 0)
+                    {
+                        compute_distances();
+                    }
+                }
+            }
+        }
+    };
+}
 
 // Constructor
 NOMAD::LHS::LHS(int n, int p, int seed)
@@ -10,6 +267,8 @@ NOMAD::LHS::LHS(int n, int p, int seed)
     _p(p),
     _l(),
     _u(),
+    _lb(),
+    _ub(),
     _seed(seed)
 {
     std::srand(_seed);
@@ -21,6 +280,8 @@ NOMAD::LHS::LHS(const NOMAD::LHS &lhs)
     _p(lhs._p),
     _l(lhs._l),
     _u(lhs._u),
+    _lb(lhs._lb),
+    _ub(lhs._ub),
     _seed(lhs._seed)
 {
 }
@@ -31,11 +292,45 @@ NOMAD::LHS::~LHS(void)
 }
 
 
+// Real bounds
+void NOMAD::LHS::set_bounds(const std::vector<double> &l, const std::vector<double> &u)
+{
+    const char *error = NOMAD::check_design_bounds(l, u, _n);
+    if (error)
+    {
+        throw NOMAD::Exception("LHS.cpp", __LINE__, std::string("NOMAD::LHS::set_bounds(): ") + error);
+    }
+    _lb = l;
+    _ub = u;
+}
+
+void NOMAD::LHS::set_bounds(const NOMAD::Point &l, const NOMAD::Point &u)
+{
+    const char *error = NOMAD::check_design_bounds(l, u, _n, _lb, _ub);
+    if (error)
+    {
+        throw NOMAD::Exception("LHS.cpp", __LINE__, std::string("NOMAD::LHS::set_bounds(): ") + error);
+    }
+}
+
+void NOMAD::LHS::check_bounds(void) const
+{
+    if (static_cast<int>(_lb.size()) != _n || static_cast<int>(_ub.size()) != _n || _p <= 0)
+    {
+        throw NOMAD::Exception("LHS.cpp", __LINE__, "NOMAD::LHS: bounds not set");
+    }
+}
+
 // Do the sample
 // Audet & Hare Algorithm 3.9 Latin Hypercube Sampling
 std::vector<NOMAD::Point*> NOMAD::LHS::Sample() const
 {
     std::vector<NOMAD::Point*> samplepoints;
+    if (_p <= 0)
+    {
+        return samplepoints;
+    }
+    check_bounds();
 
     // 0 - Initialization
     // Let Pi be a n x p matrix in which each of its n rows
@@ -56,10 +351,10 @@ std::vector<NOMAD::Point*> NOMAD::LHS::Sample() const
         {
             NOMAD::Double r_ij = RNG::rand(0,1);
             // Convert ints to Doubles to ensure there is no hidden rounding
-            NOMAD::Double l_i(_l[i]);
+            NOMAD::Double l_i(_lb[i]);
             NOMAD::Double Pi_ij( Pi[i][j] );
             NOMAD::Double pdouble( _p );
-            NOMAD::Double u_i( _u[i] );
+            NOMAD::Double u_i( _ub[i] );
 
             /* VRM for debug
             cout << "VRM: x" << i << j << " = " << l_i;
@@ -75,6 +370,186 @@ std::vector<NOMAD::Point*> NOMAD::LHS::Sample() const
     return samplepoints;
 }
 
+void NOMAD::LHS::Sample(NOMAD::PointSet &points) const
+{
+    check_bounds();
+    if (points.get_nb_points() != _p || points.get_dimension() != _n)
+    {
+        points = NOMAD::PointSet(_p, _n, points.get_layout());
+    }
+
+    // 0 - Initialization
+    // Let Pi be a n x p matrix in which each of its n rows
+    // is a random permutation of the vector (1, 2, .., p).
+    //
+    std::vector<std::vector<int> > Pi(_n);
+    for (int i = 0; i < _n; i++)
+    {
+        Pi[i] = Permutation(_p);
+    }
+
+    // x_ij = l_i + (Pi_ij - r_ij) / p * (u_i - l_i), with the scale
+    // (u_i - l_i) / p of each coordinate computed once. The result is
+    // kept in [l_i,u_i] despite the rounding.
+    std::vector<double> scale(_n);
+    for (int i = 0; i < _n; i++)
+    {
+        scale[i] = (_ub[i] - _lb[i]) / _p;
+    }
+
+    // 1 - Sample construction
+    // By blocks of samples: the random values r_ij are drawn sample by
+    // sample, as in the algorithm, then the coordinates are computed
+    // coordinate by coordinate, so that each row of Pi is read by lines
+    // of cache.
+    const int block_size = 16;
+    std::vector<double> r(block_size * _n);
+    const bool aos = (points.get_layout() == NOMAD::AOS);
+    const int row_stride = aos ? points.get_ld() : 1;   // Between two points
+    const int col_stride = aos ? 1 : points.get_ld();   // Between two coordinates
+    NOMAD::Double *data = points.data();
+
+    for (int j0 = 0; j0 < _p; j0 += block_size)
+    {
+        const int nb = std::min(block_size, _p - j0);
+        for (int k = 0; k < nb; k++)
+        {
+            for (int i = 0; i < _n; i++)
+            {
+                r[k * _n + i] = RNG::rand(0, 1);
+            }
+        }
+        for (int i = 0; i < _n; i++)
+        {
+            const int *Pi_i = &Pi[i][j0];
+            const double l_i = _lb[i], u_i = _ub[i], scale_i = scale[i];
+            NOMAD::Double *x_i = data + j0 * row_stride + i * col_stride;
+            for (int k = 0; k < nb; k++)
+            {
+                double x_ij = l_i + (Pi_i[k] - r[k * _n + i]) * scale_i;
+                x_i[k * row_stride] = std::min(std::max(x_ij, l_i), u_i);
+            }
+        }
+    }
+}
+
+void NOMAD::LHS::SampleParallel(NOMAD::PointSet &points, int nb_threads) const
+{
+    Stream(*this).Sample(points, nb_threads);
+}
+
+double NOMAD::LHS::SampleMaximin(NOMAD::PointSet &points, int max_iterations,
+                                 double max_time, int nb_restarts, int nb_threads) const
+{
+    check_bounds();
+    // The p x p matrix of the squared distances, and the n x p cells, must
+    // be indexable
+    const size_t max_size = std::vector<double>().max_size();
+    if (static_cast<size_t>(_p) > max_size / static_cast<size_t>(_p) ||
+        static_cast<size_t>(_n) > max_size / static_cast<size_t>(_p))
+    {
+        throw NOMAD::Exception("LHS.cpp", __LINE__, "NOMAD::LHS::SampleMaximin(): too many samples");
+    }
+    if (points.get_nb_points() != _p || points.get_dimension() != _n)
+    {
+        points = NOMAD::PointSet(_p, _n, points.get_layout());
+    }
+
+    nb_restarts = std::max(nb_restarts, 1);
+    if (nb_threads <= 0)
+    {
+        nb_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    nb_threads = std::min(nb_threads, nb_restarts);
+
+    // Restart r depends only on the seed and r. Thread t does the restarts
+    // t, t + nb_threads, .., and keeps its best one. The best design has the
+    // smallest criterion, then the smallest restart index, so that it does
+    // not depend on the number of threads.
+    // Each thread works on one design, and keeps the cells of its best one.
+    // The exceptions of the threads, such as std::bad_alloc for the O(p^2)
+    // matrix of a large p, are thrown after all the threads are joined.
+    const uint64_t seed = NOMAD::mix(static_cast<uint64_t>(_seed) + 0x2545F4914F6CDD1DULL);
+    std::vector<std::vector<int> > best_cells(nb_threads);
+    std::vector<double> best_criterion(nb_threads, NOMAD::INF);
+    std::vector<double> best_min_d2(nb_threads, 0.0);
+    std::vector<int> best_restart(nb_threads, nb_restarts);
+    std::vector<std::exception_ptr> errors(nb_threads);
+    auto run = [&](int t)
+    {
+        try
+        {
+            MaximinDesign design(_n, _p);
+            for (int r = t; r < nb_restarts; r += nb_threads)
+            {
+                design.restart(NOMAD::mix(seed + static_cast<uint64_t>(r) * 0x9E3779B97F4A7C15ULL));
+                design.optimize(max_iterations, max_time);
+                double criterion = design.criterion();
+                if (criterion < best_criterion[t])
+                {
+                    best_min_d2[t] = design.min_d2();
+                    design.swap_cells(best_cells[t]);
+                    best_criterion[t] = criterion;
+                    best_restart[t] = r;
+                }
+            }
+        }
+        catch (...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    // A thread that cannot be started does its restarts here
+    std::vector<std::thread> threads;
+    threads.reserve(nb_threads);
+    for (int t = 1; t < nb_threads; t++)
+    {
+        try
+        {
+            threads.push_back(std::thread(run, t));
+        }
+        catch (const std::system_error &)
+        {
+            run(t);
+        }
+    }
+    run(0);
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    for (int t = 0; t < nb_threads; t++)
+    {
+        if (errors[t])
+        {
+            std::rethrow_exception(errors[t]);
+        }
+    }
+
+    int t_best = 0;
+    for (int t = 1; t < nb_threads; t++)
+    {
+        if (best_criterion[t] < best_criterion[t_best] ||
+            (best_criterion[t] == best_criterion[t_best] && best_restart[t] < best_restart[t_best]))
+        {
+            t_best = t;
+        }
+    }
+
+    // Samples at the centers of the cells
+    const std::vector<int> &cells = best_cells[t_best];
+    for (int i = 0; i < _n; i++)
+    {
+        const double scale = (_ub[i] - _lb[i]) / _p;
+        for (int j = 0; j < _p; j++)
+        {
+            points(j, i) = _lb[i] + (cells[static_cast<size_t>(i) * _p + j] + 0.5) * scale;
+        }
+    }
+    return (_p > 1) ? std::sqrt(best_min_d2[t_best]) / _p : 0.0;
+}
+
 // Input: p
 // Output: Random permutation of the vector (1, 2, .., p)
 std::vector<int> NOMAD::LHS::Permutation(const int p)
@@ -89,3 +564,165 @@ std::vector<int> NOMAD::LHS::Permutation(const int p)
 
     return v;
 }
+
+
+// Stream constructor
+// Memory O(n): one key per coordinate and round.
+NOMAD::LHS::Stream::Stream(const NOMAD::LHS &lhs)
+:   _n(lhs._n),
+    _p(lhs._p),
+    _l(lhs._lb),
+    _scale(lhs._n),
+    _u(lhs._ub),
+    _keys(lhs._n * FEISTEL_ROUNDS),
+    _half_bits(1),
+    _next(0)
+{
+    lhs.check_bounds();
+    for (int i = 0; i < _n; i++)
+    {
+        _scale[i] = (_u[i] - _l[i]) / _p;
+    }
+
+    // The domain of the network has 2*_half_bits bits, and at least p
+    // values, so that cycle walking takes less than 4 rounds on average.
+    while ((1LL << (2 * _half_bits)) < _p)
+    {
+        _half_bits++;
+    }
+
+    const uint64_t seed = NOMAD::mix(static_cast<uint64_t>(lhs._seed) + 0x9E3779B97F4A7C15ULL);
+    for (size_t k = 0; k < _keys.size(); k++)
+    {
+        _keys[k] = NOMAD::mix(seed ^ (static_cast<uint64_t>(k) * 0xD1B54A32D192ED03ULL));
+    }
+}
+
+// Permutation of (0, 1, .., p-1) for coordinate i
+int NOMAD::LHS::Stream::cell(int i, int j) const
+{
+    const uint64_t mask = (1ULL << _half_bits) - 1;
+    const uint64_t * key = &_keys[i * FEISTEL_ROUNDS];
+    uint64_t x = static_cast<uint64_t>(j);
+    do
+    {
+        // Each round is a bijection of the domain: the network is a
+        // bijection, and so is its restriction to (0, .., p-1) by walking
+        // the cycle of x until it comes back in the range.
+        // The round function is the high bits of a product with the key.
+        uint64_t left  = x >> _half_bits;
+        uint64_t right = x & mask;
+        for (int r = 0; r < FEISTEL_ROUNDS; r++)
+        {
+            uint64_t f = (((right ^ key[r]) * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+            uint64_t t = left ^ f;
+            left  = right;
+            right = t;
+        }
+        x = (left << _half_bits) | right;
+    } while (x >= static_cast<uint64_t>(_p));
+    return static_cast<int>(x);
+}
+
+// Position in the cell, with 53 random bits
+double NOMAD::LHS::Stream::jitter(int i, int j) const
+{
+    uint64_t h = NOMAD::mix(_keys[i * FEISTEL_ROUNDS] + static_cast<uint64_t>(j) * 0x632BE59BD9B4E019ULL);
+    return (h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void NOMAD::LHS::Stream::seek(const int j)
+{
+    _next = std::min(std::max(j, 0), _p);
+}
+
+// Same formula as LHS::Sample(), with Pi_ij = cell + 1
+void NOMAD::LHS::Stream::Sample(const int j, NOMAD::PointSet::Slice x) const
+{
+    for (int i = 0; i < _n; i++)
+    {
+        double Pi_ij = cell(i, j) + 1;
+        double x_ij = _l[i] + (Pi_ij - jitter(i, j)) * _scale[i];
+        x[i] = std::min(std::max(x_ij, _l[i]), _u[i]);
+    }
+}
+
+void NOMAD::LHS::Stream::Sample(const int j, NOMAD::Point &x) const
+{
+    if (x.get_size() != _n)
+    {
+        x = NOMAD::Point(_n);
+    }
+    Sample(j, NOMAD::PointSet::Slice(&x[0], _n, 1));
+}
+
+void NOMAD::LHS::Stream::Sample(NOMAD::PointSet &points, int nb_threads) const
+{
+    if (points.get_nb_points() != _p || points.get_dimension() != _n)
+    {
+        points = NOMAD::PointSet(_p, _n, points.get_layout());
+    }
+
+    if (nb_threads <= 0)
+    {
+        nb_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    nb_threads = std::min(nb_threads, _p);
+
+    // Samples [first(t), first(t+1)) for thread t
+    auto first = [this, nb_threads](int t)
+    {
+        return static_cast<int>(static_cast<long long>(_p) * t / nb_threads);
+    };
+    auto sample_range = [this, &points](int begin, int end)
+    {
+        for (int j = begin; j < end; j++)
+        {
+            Sample(j, points.row(j));
+        }
+    };
+
+    // A thread that cannot be started samples its range here
+    std::vector<std::thread> threads;
+    threads.reserve(nb_threads);
+    for (int t = 1; t < nb_threads; t++)
+    {
+        try
+        {
+            threads.push_back(std::thread(sample_range, first(t), first(t + 1)));
+        }
+        catch (const std::system_error &)
+        {
+            sample_range(first(t), first(t + 1));
+        }
+    }
+    sample_range(0, first(1));
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+}
+
+bool NOMAD::LHS::Stream::next(NOMAD::Point &x)
+{
+    if (done())
+    {
+        return false;
+    }
+    Sample(_next++, x);
+    return true;
+}
+
+int NOMAD::LHS::Stream::next(NOMAD::PointSet &block)
+{
+    if (block.get_dimension() != _n)
+    {
+        throw NOMAD::Exception("LHS.cpp", __LINE__, "NOMAD::LHS::Stream::next(): bad dimension");
+    }
+    int nb = std::min(block.get_nb_points(), _p - _next);
+    for (int k = 0; k < nb; k++)
+    {
+        Sample(_next++, block.row(k));
+    }
+    return nb;
+}
@@ -3,7 +3,8 @@
 //
 // Input: 
 // n dimension
-// l and u vectors of R^n indicating lower and upper bounds
+// l and u vectors of R^n indicating lower and upper bounds, as integers
+//   (set_l() and set_u()) or as reals (set_bounds())
 // p number of desired samples
 // seed (optional)
 //
@@ -15,6 +16,7 @@
 #include <vector>
 #include "Math/Double.hpp"
 #include "Math/Point.hpp"
+#include "Math/PointSet.hpp"
 using namespace std;
 
 #include "nomad_nsbegin.hpp"
@@ -26,8 +28,13 @@ private:
     int _p;
     std::vector<int> _l;
     std::vector<int> _u;
+    std::vector<double> _lb;    // Bounds used by the sampling: _l and _u,
+    std::vector<double> _ub;    // or the real bounds of set_bounds()
     int _seed;
 
+    // Check that the bounds are set
+    void check_bounds(void) const;
+
 public:
     // Constructor
     explicit LHS(int n = 1, int p = 1, int seed = 2920);
@@ -47,16 +54,122 @@ public:
 
     // Get/Set lower and upper limits
     std::vector<int>    get_l(void) const     { return _l; }
-    void    set_l(const std::vector<int> l)   { _l = l;    }
+    void    set_l(const std::vector<int> l)   { _l = l; _lb.assign(l.begin(), l.end()); }
     std::vector<int>    get_u(void) const     { return _u; }
-    void    set_u(const std::vector<int> u)   { _u = u;    }
+    void    set_u(const std::vector<int> u)   { _u = u; _ub.assign(u.begin(), u.end()); }
+
+    // Get/Set real lower and upper limits.
+    // They replace the limits of set_l() and set_u() for the sampling;
+    // get_l() and get_u() are not changed. Point bounds must be defined.
+    const std::vector<double>&  get_lb(void) const { return _lb; }
+    const std::vector<double>&  get_ub(void) const { return _ub; }
+    void    set_bounds(const std::vector<double> &l, const std::vector<double> &u);
+    void    set_bounds(const NOMAD::Point &l, const NOMAD::Point &u);
 
     // Do the sampling
+    // The caller owns the points.
     std::vector<NOMAD::Point*> Sample() const;
 
+    // Do the sampling into a PointSet of p points of dimension n, with
+    // no allocation per point. The layout of points is kept.
+    // Same permutations and random values as Sample() for the same random
+    // state, but the coordinates are computed in double, with a scale
+    // factor (u_i - l_i) / p per dimension, and kept in [l_i,u_i]: they
+    // may differ from the ones of Sample() in the last bits. The samples
+    // are computed by blocks so that the permutations are read by lines
+    // of cache.
+    void Sample(NOMAD::PointSet &points) const;
+
+    // Do the sampling of the samples of Stream into a PointSet of p points
+    // of dimension n, with nb_threads threads (0 for one per core).
+    // The samples are the same, bit by bit, for any number of threads.
+    void SampleParallel(NOMAD::PointSet &points, int nb_threads = 0) const;
+
+    // Do the sampling with an optimized space filling (maximin), into a
+    // PointSet of p points of dimension n. The samples are at the centers
+    // of their cells.
+    // Starting from random Latin hypercubes, simulated annealing exchanges
+    // the cells of two samples in one coordinate, which keeps the Latin
+    // hypercube, to minimize the Morris-Mitchell criterion
+    // phi = (sum_{j<k} d_jk^-20)^(1/20), a smooth version of the minimum
+    // distance between the samples scaled to [0,1]^n. An exchange only
+    // changes the distances to the two samples: its effect is computed in
+    // O(p) from the matrix of squared distances, and the memory is O(p^2)
+    // per thread.
+    // Budget of each restart: max_iterations exchanges, and max_time
+    // seconds (0 for no limit). The restarts are distributed on nb_threads
+    // threads (0 for one per core), and the best design is kept. With no
+    // limit on time, the result only depends on the seed.
+    // Returns the minimum distance between the samples scaled to [0,1]^n.
+    double SampleMaximin(NOMAD::PointSet &points, int max_iterations,
+                         double max_time = 0.0, int nb_restarts = 1,
+                         int nb_threads = 0) const;
+
     // Input: p
     // Output: Random permutation of the vector (1, 2, .., p)
     static std::vector<int> Permutation(const int p);
+
+    // Generator of the samples, one at a time or by blocks, with memory
+    // O(n) instead of the O(n*p) of Sample().
+    // The permutation of each coordinate is a bijection of (0, 1, .., p-1)
+    // computed on demand: a Feistel network keyed by the seed and the
+    // coordinate, with cycle walking. The position in each cell is a hash
+    // of the seed, the coordinate and the sample index.
+    // Sample j only depends on the seed and j, not on the global random
+    // state or on the order of the calls, so the samples are not those of
+    // Sample().
+    class Stream
+    {
+    private:
+        int _n;
+        int _p;
+        std::vector<double> _l;
+        std::vector<double> _scale;     // (u_i - l_i) / p
+        std::vector<double> _u;
+        std::vector<uint64_t> _keys;    // Keys of the rounds of the permutation of each coordinate
+        int _half_bits;                 // Half the bits of the Feistel network
+        int _next;                      // Index of the next sample
+
+        // Cell of sample j for coordinate i, in (0, 1, .., p-1)
+        int cell(int i, int j) const;
+
+        // Random position of sample j in its cell for coordinate i, in [0,1)
+        double jitter(int i, int j) const;
+
+    public:
+        // Constructor, with the dimensions, bounds and seed of the LHS.
+        // The bounds must be set.
+        explicit Stream(const LHS& lhs);
+
+        // Get the number of samples
+        int get_nb_samples(void) const { return _p; }
+
+        // Get/Set the index of the next sample
+        int     get_index(void) const { return _next; }
+        void    seek(const int j);
+
+        // Are all the samples generated?
+        bool    done(void) const { return _next >= _p; }
+
+        // Sample j, in a point or a row of dimension n
+        void    Sample(const int j, NOMAD::Point &x) const;
+        void    Sample(const int j, NOMAD::PointSet::Slice x) const;
+
+        // Next sample. Returns false if all the samples are generated.
+        bool    next(NOMAD::Point &x);
+
+        // All the samples, in a PointSet of p points of dimension n, with
+        // nb_threads threads (0 for one per core). Each thread computes a
+        // contiguous range of samples, and the samples do not depend on
+        // the range: the result is the same for any number of threads.
+        // The index of the next sample is not changed.
+        void    Sample(NOMAD::PointSet &points, int nb_threads = 0) const;
+
+        // Next samples, in the rows of a block of dimension n.
+        // Returns the number of samples, less than the number of rows of
+        // the block at the end.
+        int     next(NOMAD::PointSet &block);
+    };
 };
 
 #include "nomad_nsend.hpp"
@@ -0,0 +1,29 @@
+/**
+ \file   MeshFrame.cpp
+ \brief  Frame of a mesh: reference point and mesh sizes (implementation)
+ \see    MeshFrame.hpp
+ */
+
+#include "Math/MeshFrame.hpp"
+#include "Util/Exception.hpp"
+
+/*-----------------------------------------------------------*/
+/*                         constructor                       */
+/*-----------------------------------------------------------*/
+NOMAD::MeshFrame::MeshFrame ( const NOMAD::PointView & ref , const NOMAD::PointView & delta )
+  : _ref   ( ref.to_point()   ) ,
+    _delta ( delta.to_point() )
+{
+    if ( ref.get_size() != delta.get_size() )
+        throw NOMAD::Exception ( "MeshFrame.cpp" , __LINE__ ,
+                                "NOMAD::MeshFrame::MeshFrame(): bad dimensions" );
+
+    for ( int i = 0 ; i < _delta.get_size() ; ++i )
+    {
+        if ( !_delta[i].is_defined() || _delta[i] <= 0.0 )
+            throw NOMAD::Exception ( "MeshFrame.cpp" , __LINE__ ,
+                                    "NOMAD::MeshFrame::MeshFrame(): mesh sizes must be positive" );
+        if ( !_ref[i].is_defined() )
+            _ref[i] = 0.0;
+    }
+}
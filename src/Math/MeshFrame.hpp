@@ -0,0 +1,77 @@
+/**
+ \file   MeshFrame.hpp
+ \brief  Frame of a mesh: reference point and mesh sizes
+ \see    MeshFrame.cpp
+ */
+
+#ifndef __NOMAD400_MESHFRAME__
+#define __NOMAD400_MESHFRAME__
+
+#include "Math/Double.hpp"
+#include "Math/Point.hpp"
+#include "Math/PointView.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the frame of a mesh.
+    /**
+     The points of the mesh are \c ref \c + \c k*delta, with integer indices
+     \c k, as in NOMAD::Double::project_to_mesh(). An undefined coordinate
+     of \c ref is 0. The frame is shared by the NOMAD::MeshPoint objects
+     built on it.
+    */
+    class MeshFrame {
+    private:
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        NOMAD::Point _ref;      // Reference point
+        NOMAD::Point _delta;    // Mesh sizes
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /**
+         \param ref   The reference point -- \b IN.
+         \param delta The mesh sizes, defined and positive -- \b IN.
+         */
+        MeshFrame ( const NOMAD::PointView & ref , const NOMAD::PointView & delta );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the dimension of the mesh.
+        int get_size ( void ) const { return _delta.get_size(); }
+
+        /// Access to the reference point.
+        const NOMAD::Point & get_ref ( void ) const { return _ref; }
+
+        /// Access to the mesh sizes.
+        const NOMAD::Point & get_delta ( void ) const { return _delta; }
+
+        /// Coordinate \c i of the mesh point of index \c k.
+        /**
+         \param i The index of the coordinate -- \b IN.
+         \param k The index on the mesh -- \b IN.
+         \return  \c ref[i] \c + \c k*delta[i].
+         */
+        NOMAD::Double coord ( int i , int k ) const
+        {
+            return _ref[i] + static_cast<double> ( k ) * _delta[i];
+        }
+
+        /// Comparison operator \c ==.
+        /**
+         \param f The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if the frames are equal.
+         */
+        bool operator == ( const MeshFrame & f ) const
+        {
+            return this == &f || ( _ref == f._ref && _delta == f._delta );
+        }
+    };
+
+#include "nomad_nsend.hpp"
+#endif
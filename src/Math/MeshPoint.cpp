@@ -0,0 +1,242 @@
+/**
+ \file   MeshPoint.cpp
+ \brief  Point of a mesh, stored as integer indices (implementation)
+ \see    MeshPoint.hpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include "Math/MeshPoint.hpp"
+#include "Util/Exception.hpp"
+
+const int     NOMAD::MeshPoint::SMALL_SIZE;
+const int32_t NOMAD::MeshPoint::UNDEF_INDEX;
+
+std::ostream& NOMAD::operator<<(std::ostream& out, const NOMAD::MeshPoint& point)
+{
+    point.display(out);
+    return out;
+}
+
+/*-----------------------------------------------------------*/
+/*                     allocation of indices                 */
+/*-----------------------------------------------------------*/
+void NOMAD::MeshPoint::allocate ( void )
+{
+    if ( _n <= 0 )
+    {
+        _n = 0;
+        _k = NULL;
+    }
+    else
+        _k = ( is_on_heap() ) ? new int32_t [_n] : _small;
+}
+
+void NOMAD::MeshPoint::release ( void )
+{
+    if ( is_on_heap() )
+        delete [] _k;
+    _k = NULL;
+}
+
+/*-----------------------------------------------------------*/
+/*                         constructors                      */
+/*-----------------------------------------------------------*/
+NOMAD::MeshPoint::MeshPoint ( const NOMAD::MeshFrame & frame )
+  : _frame ( &frame ) ,
+    _n     ( frame.get_size() ) ,
+    _k     ( NULL )
+{
+    allocate();
+    std::fill ( _k , _k + _n , 0 );
+}
+
+NOMAD::MeshPoint::MeshPoint ( const NOMAD::MeshFrame & frame , const NOMAD::PointView & x )
+  : _frame ( &frame ) ,
+    _n     ( frame.get_size() ) ,
+    _k     ( NULL )
+{
+    if ( x.get_size() != _n )
+        throw NOMAD::Exception ( "MeshPoint.cpp" , __LINE__ ,
+                                "NOMAD::MeshPoint::MeshPoint(): bad dimensions" );
+    allocate();
+
+    const NOMAD::Point & ref   = frame.get_ref();
+    const NOMAD::Point & delta = frame.get_delta();
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        if ( !x[i].is_defined() )
+        {
+            _k[i] = UNDEF_INDEX;
+            continue;
+        }
+
+        // Same rounding as NOMAD::Double::project_to_mesh()
+        double t = ( ( x[i] - ref[i] ) / delta[i] ).roundd().todouble();
+        if ( !( fabs ( t ) <= INT32_MAX ) )
+        {
+            release();
+            throw NOMAD::Exception ( "MeshPoint.cpp" , __LINE__ ,
+                                    "NOMAD::MeshPoint::MeshPoint(): index out of range" );
+        }
+        _k[i] = static_cast<int32_t> ( t );
+
+        if ( frame.coord ( i , _k[i] ) != x[i] )
+        {
+            release();
+            throw NOMAD::Exception ( "MeshPoint.cpp" , __LINE__ ,
+                                    "NOMAD::MeshPoint::MeshPoint(): point not on the mesh" );
+        }
+    }
+}
+
+NOMAD::MeshPoint::MeshPoint ( const NOMAD::MeshPoint & p )
+  : _frame ( p._frame ) ,
+    _n     ( p._n     ) ,
+    _k     ( NULL     )
+{
+    allocate();
+    std::copy ( p._k , p._k + _n , _k );
+}
+
+NOMAD::MeshPoint::MeshPoint ( NOMAD::MeshPoint && p ) noexcept
+  : _frame ( p._frame ) ,
+    _n     ( p._n     ) ,
+    _k     ( NULL     )
+{
+    if ( is_on_heap() )
+    {
+        _k   = p._k;
+        p._k = NULL;
+        p._n = 0;
+    }
+    else
+    {
+        // No allocation for small points.
+        allocate();
+        std::copy ( p._k , p._k + _n , _k );
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                    affectation operators                  */
+/*-----------------------------------------------------------*/
+NOMAD::MeshPoint & NOMAD::MeshPoint::operator = ( const NOMAD::MeshPoint & p )
+{
+    if ( this == &p )
+        return *this;
+
+    if ( _n != p._n )
+    {
+        release();
+        _n = p._n;
+        allocate();
+    }
+    _frame = p._frame;
+    std::copy ( p._k , p._k + _n , _k );
+    return *this;
+}
+
+NOMAD::MeshPoint & NOMAD::MeshPoint::operator = ( NOMAD::MeshPoint && p ) noexcept
+{
+    if ( this == &p )
+        return *this;
+
+    // Small points are copied, without allocation.
+    if ( !p.is_on_heap() )
+    {
+        *this = p;
+        return *this;
+    }
+
+    release();
+    _frame = p._frame;
+    _n     = p._n;
+    _k     = p._k;
+    p._k   = NULL;
+    p._n   = 0;
+    return *this;
+}
+
+/*-----------------------------------------------------------*/
+/*                            swap                           */
+/*-----------------------------------------------------------*/
+void NOMAD::MeshPoint::swap ( NOMAD::MeshPoint & p ) noexcept
+{
+    if ( this == &p )
+        return;
+
+    if ( is_on_heap() && p.is_on_heap() )
+        std::swap ( _k , p._k );
+    else
+    {
+        MeshPoint tmp ( std::move ( p ) );
+        p     = std::move ( *this );
+        *this = std::move ( tmp );
+        return;
+    }
+    std::swap ( _frame , p._frame );
+    std::swap ( _n     , p._n     );
+}
+
+/*-----------------------------------------------------------*/
+/*                      coordinates of the point             */
+/*-----------------------------------------------------------*/
+NOMAD::Point NOMAD::MeshPoint::to_point ( void ) const
+{
+    NOMAD::Point x ( _n );
+    for ( int i = 0 ; i < _n ; ++i )
+        if ( _k[i] != UNDEF_INDEX )
+            x[i] = _frame->coord ( i , _k[i] );
+    return x;
+}
+
+/*-----------------------------------------------------------*/
+/*                          comparisons                      */
+/*-----------------------------------------------------------*/
+bool NOMAD::MeshPoint::operator == ( const NOMAD::MeshPoint & p ) const
+{
+    return _frame == p._frame && _n == p._n && std::equal ( _k , _k + _n , p._k );
+}
+
+bool NOMAD::MeshPoint::operator < ( const NOMAD::MeshPoint & p ) const
+{
+    if ( _frame != p._frame )
+        return std::less<const NOMAD::MeshFrame *>() ( _frame , p._frame );
+    if ( _n != p._n )
+        return _n < p._n;
+    return std::lexicographical_compare ( _k , _k + _n , p._k , p._k + p._n );
+}
+
+/*-----------------------------------------------------------*/
+/*                              hash                         */
+/*-----------------------------------------------------------*/
+uint64_t NOMAD::MeshPoint::hash ( void ) const
+{
+    uint64_t h = static_cast<uint64_t> ( _n );
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        h = ( h ^ static_cast<uint32_t> ( _k[i] ) ) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+    }
+
+    return NOMAD::mix ( h );
+}
+
+/*-----------------------------------------------------------*/
+/*                             display                       */
+/*-----------------------------------------------------------*/
+void NOMAD::MeshPoint::display ( std::ostream & out , const std::string & sep ) const
+{
+    for ( int i = 0 ; i < _n ; ++i )
+    {
+        if ( i > 0 )
+            out << sep;
+        if ( _k[i] == UNDEF_INDEX )
+            out << NOMAD::Double::get_undef_str();
+        else
+            out << _k[i];
+    }
+}
@@ -0,0 +1,221 @@
+/**
+ \file   MeshPoint.hpp
+ \brief  Point of a mesh, stored as integer indices
+ \see    MeshPoint.cpp
+ */
+
+#ifndef __NOMAD400_MESHPOINT__
+#define __NOMAD400_MESHPOINT__
+
+#include "Math/MeshFrame.hpp"
+#include "Math/Point.hpp"
+#include "Math/PointView.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the representation of a point of a mesh.
+    /**
+     - The point \c ref \c + \c k*delta is stored as its indices \c k and a
+       pointer to the NOMAD::MeshFrame (\c ref, \c delta). The frame is
+       shared and not owned: it must outlive the point.
+     - Comparisons and hash are exact integer operations, without epsilon.
+       Two points are equal if they have the same frame object and the
+       same indices.
+     - Up to \c SMALL_SIZE indices are stored inside the object, in half the
+       space of the coordinates of a NOMAD::Point.
+     - An undefined coordinate has the index \c UNDEF_INDEX.
+    */
+    class MeshPoint {
+    public:
+        /// Max dimension of the points stored without heap allocation.
+        static const int SMALL_SIZE = POINT_SMALL_SIZE;
+
+        /// Index of an undefined coordinate.
+        static const int32_t UNDEF_INDEX = INT32_MIN;
+
+    private:
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        const NOMAD::MeshFrame * _frame;    // Frame of the mesh, not owned
+        int                      _n;        // Dimension of the point
+        int32_t                * _k;        // Indices: NULL, _small or heap
+        int32_t                  _small[SMALL_SIZE];
+
+        /// Allocate \c _n indices.
+        void allocate ( void );
+
+        /// Free the indices.
+        void release ( void );
+
+        /// Are the indices stored on the heap ?
+        bool is_on_heap ( void ) const { return _n > SMALL_SIZE; }
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /// Constructor of an empty point, without frame.
+        MeshPoint ( void ) : _frame ( NULL ) , _n ( 0 ) , _k ( NULL ) {}
+
+        /// Constructor of the reference point of a mesh (all indices are 0).
+        /**
+         \param frame The frame of the mesh -- \b IN.
+         */
+        explicit MeshPoint ( const NOMAD::MeshFrame & frame );
+
+        /// Constructor from the coordinates of a point.
+        /**
+         Each coordinate must be equal to \c ref[i] \c + \c k[i]*delta[i] for an
+         integer \c k[i], as after NOMAD::Point::project_to_mesh() with the same
+         frame.
+         \param frame The frame of the mesh -- \b IN.
+         \param x     The point, of dimension \c frame.get_size() -- \b IN.
+         */
+        MeshPoint ( const NOMAD::MeshFrame & frame , const NOMAD::PointView & x );
+
+        /// Copy constructor.
+        /**
+         \param p The copied object -- \b IN.
+         */
+        MeshPoint ( const MeshPoint & p );
+
+        /// Move constructor.
+        /**
+         \param p The moved object -- \b IN/OUT.
+         */
+        MeshPoint ( MeshPoint && p ) noexcept;
+
+        /// Affectation operator.
+        /**
+         \param p The right-hand side object -- \b IN.
+         \return \c *this as the result of the affectation.
+         */
+        MeshPoint & operator = ( const MeshPoint & p );
+
+        /// Move affectation operator.
+        /**
+         \param p The right-hand side object -- \b IN/OUT.
+         \return \c *this as the result of the affectation.
+         */
+        MeshPoint & operator = ( MeshPoint && p ) noexcept;
+
+        /// Swap the content of two points.
+        /**
+         \param p The other point -- \b IN/OUT.
+         */
+        void swap ( MeshPoint & p ) noexcept;
+
+        /// Destructor.
+        ~MeshPoint ( void ) { release(); }
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the index of the coordinate \c i.
+        /**
+         \param i The index of the coordinate -- \b IN.
+         \return  The index on the mesh.
+         */
+        const int32_t & operator [] ( int i ) const { return _k[i]; }
+        int32_t       & operator [] ( int i )       { return _k[i]; }
+
+        /// Access to the dimension of the point.
+        int get_size ( void ) const { return _n; }
+
+        /// Access to the frame of the mesh.
+        const NOMAD::MeshFrame * get_frame ( void ) const { return _frame; }
+
+        /// Access to the coordinate \c i.
+        /**
+         \param i The index of the coordinate -- \b IN.
+         \return  The coordinate \c ref[i] \c + \c k[i]*delta[i].
+         */
+        NOMAD::Double get_coord ( int i ) const
+        {
+            return ( _k[i] == UNDEF_INDEX ) ? NOMAD::Double() : _frame->coord ( i , _k[i] );
+        }
+
+        /// Coordinates of the point.
+        /**
+         \return The point \c ref \c + \c k*delta.
+         */
+        NOMAD::Point to_point ( void ) const;
+
+        /*------------*/
+        /* Comparison */
+        /*------------*/
+        /// Comparison operator \c ==.
+        /**
+         \param p The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if the points have the same frame
+                 object and the same indices.
+         */
+        bool operator == ( const MeshPoint & p ) const;
+
+        /// Comparison operator \c !=.
+        /**
+         \param p The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if  \c *this \c != \c p.
+         */
+        bool operator != ( const MeshPoint & p ) const { return !(*this == p); }
+
+        /// Comparison operator \c <.
+        /**
+         Points are sorted by frame object, then by dimension, then by
+         lexicographic order of the indices. On the same frame, this is the
+         order of NOMAD::Point::operator<().
+         \param p The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if  \c *this \c < \c p.
+         */
+        bool operator <  ( const MeshPoint & p ) const;
+
+        /// Hash of the indices.
+        /**
+         \return A hash, the same for equal points.
+         */
+        uint64_t hash ( void ) const;
+
+        /*---------*/
+        /* Display */
+        /*---------*/
+        /// Display of the indices.
+        /**
+         \param out The stream -- \b IN/OUT.
+         \param sep A string that is used as a separator between the indices
+         -- \b IN --\b optional (default = one space).
+         */
+        void display ( std::ostream & out , const std::string & sep = " " ) const;
+
+        /// Size of the point in memory.
+        /**
+         \return Size of the point in memory, in bytes, including the
+         indices stored on the heap, but not the frame.
+         */
+        int mem_sizeof ( void ) const
+        {
+            return static_cast<int> ( sizeof(MeshPoint) ) +
+                   ( is_on_heap() ? _n * static_cast<int> ( sizeof(int32_t) ) : 0 );
+        }
+    };
+
+    std::ostream& operator<< (std::ostream& out, const NOMAD::MeshPoint& point);
+
+    /// Swap the content of two points.
+    inline void swap ( NOMAD::MeshPoint & p1 , NOMAD::MeshPoint & p2 ) noexcept { p1.swap ( p2 ); }
+
+    /// Hash operator of the mesh points, for the unordered containers.
+    struct MeshPointHash {
+        /**
+         \param p The point -- \b IN.
+         \return  The hash of \c p.
+         */
+        size_t operator () ( const NOMAD::MeshPoint & p ) const
+        {
+            return static_cast<size_t> ( p.hash() );
+        }
+    };
+
+#include "nomad_nsend.hpp"
+#endif
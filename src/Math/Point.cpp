@@ -6,8 +6,13 @@
  \see    Point.hpp
  */
 
-#include <iomanip>
+#include <algorithm>
+#include <new>
+#include <utility>
 #include "Math/Point.hpp"
+#include "Math/Reduction.hpp"
+
+const int NOMAD::Point::SMALL_SIZE;
 
 std::ostream& NOMAD::operator<<(std::ostream& out, const NOMAD::Point& point)
 {
@@ -16,20 +21,48 @@ std::ostream& NOMAD::operator<<(std::ostream& out, const NOMAD::Point& point)
 }
 
 /*-----------------------------------------------------------*/
-/*                         constructor                       */
+/*                   allocation of coordinates               */
 /*-----------------------------------------------------------*/
-NOMAD::Point::Point ( int n , const NOMAD::Double & d )
-  : _n (n),
-    _coords (NULL)
+void NOMAD::Point::allocate ( void )
 {
-    if (_n > 0)
+    if ( _n <= 0 )
     {
+        _n      = 0;
+        _coords = NULL;
+    }
+    else if ( is_on_heap() )
         _coords = new NOMAD::Double [_n];
-        if ( d.is_defined() )
-            std::fill ( _coords , _coords+_n , d );
+    else
+    {
+        _coords = reinterpret_cast<NOMAD::Double *> ( _small );
+        for ( int k = 0 ; k < _n ; ++k )
+            new ( _coords + k ) NOMAD::Double;
     }
+}
+
+void NOMAD::Point::release ( void )
+{
+    if ( is_on_heap() )
+        delete [] _coords;
     else
-        _n = 0;
+        for ( int k = 0 ; k < _n ; ++k )
+            _coords[k].~Double();
+    _coords = NULL;
+}
+
+/*-----------------------------------------------------------*/
+/*                         constructor                       */
+/*-----------------------------------------------------------*/
+NOMAD::Point::Point ( int n , const NOMAD::Double & d )
+  : _n (n),
+    _coords (NULL)
+{
+    allocate();
+    if ( _n > 0 && d.is_defined() )
+        std::fill ( _coords , _coords+_n , d );
+#ifdef MEMORY_DEBUG
+    NOMAD::MemoryCounter::construct ( NOMAD::MemoryCounter::POINT , mem_sizeof() );
+#endif
 }
 
 /*-----------------------------------------------------------*/
@@ -39,15 +72,39 @@ NOMAD::Point::Point ( const NOMAD::Point & p )
   : _n (p._n),
     _coords (NULL)
 {
-    if ( _n > 0 )
+    allocate();
+    std::copy ( p._coords , p._coords+_n , _coords );
+#ifdef MEMORY_DEBUG
+    NOMAD::MemoryCounter::construct ( NOMAD::MemoryCounter::POINT , mem_sizeof() );
+#endif
+}
+
+/*-----------------------------------------------------------*/
+/*                        move constructor                   */
+/*-----------------------------------------------------------*/
+NOMAD::Point::Point ( NOMAD::Point && p ) noexcept
+  : _n (p._n),
+    _coords (NULL)
+{
+    if ( is_on_heap() )
+    {
+        _coords   = p._coords;
+        p._coords = NULL;
+        p._n      = 0;
+#ifdef MEMORY_DEBUG
+        NOMAD::MemoryCounter::resize ( NOMAD::MemoryCounter::POINT ,
+                                       -static_cast<long> ( _n * sizeof(NOMAD::Double) ) );
+#endif
+    }
+    else
     {
-        NOMAD::Double       * p1 =   _coords = new NOMAD::Double [_n];
-        const NOMAD::Double * p2 = p._coords;
-        for ( int k = 0 ; k < _n ; ++k , ++p1 , ++p2 )
-        {
-            *p1 = *p2;
-        }
+        // No allocation for small points.
+        allocate();
+        std::copy ( p._coords , p._coords+_n , _coords );
     }
+#ifdef MEMORY_DEBUG
+    NOMAD::MemoryCounter::construct ( NOMAD::MemoryCounter::POINT , mem_sizeof() );
+#endif
 }
 
 /*-----------------------------------------------*/
@@ -55,7 +112,10 @@ NOMAD::Point::Point ( const NOMAD::Point & p )
 /*-----------------------------------------------*/
 NOMAD::Point::~Point ( void )
 {
-    delete [] _coords;
+#ifdef MEMORY_DEBUG
+    NOMAD::MemoryCounter::destruct ( NOMAD::MemoryCounter::POINT , mem_sizeof() );
+#endif
+    release();
 }
 
 /*-----------------------------------------------------------*/
@@ -85,12 +145,15 @@ const NOMAD::Point & NOMAD::Point::operator = ( const NOMAD::Point & p )
 
     if ( _n != p._n )
     {
-        delete [] _coords;
+#ifdef MEMORY_DEBUG
+        long old_size = mem_sizeof();
+#endif
+        release();
         _n = p._n;
-        if (_n > 0)
-            _coords = new NOMAD::Double [_n];
-        else
-            _coords = NULL;
+        allocate();
+#ifdef MEMORY_DEBUG
+        NOMAD::MemoryCounter::resize ( NOMAD::MemoryCounter::POINT , mem_sizeof() - old_size );
+#endif
     }
 
     NOMAD::Double       * p1 =   _coords;
@@ -102,52 +165,152 @@ const NOMAD::Point & NOMAD::Point::operator = ( const NOMAD::Point & p )
 }
 
 /*-----------------------------------------------------------*/
-/*                           operator ==                     */
+/*                  move affectation operator                */
 /*-----------------------------------------------------------*/
-bool NOMAD::Point::operator == ( const NOMAD::Point & p ) const
+NOMAD::Point & NOMAD::Point::operator = ( NOMAD::Point && p ) noexcept
 {
     if ( this == &p )
-        return true;
-    if ( p._n != _n )
-        return false;
+        return *this;
 
-    const NOMAD::Double * p1 =   _coords;
-    const NOMAD::Double * p2 = p._coords;
-    for ( int k = 0 ; k < _n ; ++k , ++p1 , ++p2 )
-        if ( *p1 != *p2 )
-            return false;
+    // Small points are copied, without allocation.
+    if ( !p.is_on_heap() )
+    {
+        *this = p;
+        return *this;
+    }
 
-    return true;
+#ifdef MEMORY_DEBUG
+    long old_size = mem_sizeof();
+#endif
+    release();
+    _n        = p._n;
+    _coords   = p._coords;
+    p._coords = NULL;
+    p._n      = 0;
+#ifdef MEMORY_DEBUG
+    NOMAD::MemoryCounter::resize ( NOMAD::MemoryCounter::POINT , mem_sizeof() - old_size );
+    NOMAD::MemoryCounter::resize ( NOMAD::MemoryCounter::POINT ,
+                                   -static_cast<long> ( _n * sizeof(NOMAD::Double) ) );
+#endif
+
+    return *this;
+}
+
+/*-----------------------------------------------------------*/
+/*                            swap                           */
+/*-----------------------------------------------------------*/
+void NOMAD::Point::swap ( NOMAD::Point & p ) noexcept
+{
+    if ( is_on_heap() && p.is_on_heap() )
+    {
+        std::swap ( _n      , p._n      );
+        std::swap ( _coords , p._coords );
+        return;
+    }
+
+    // At least one small point: the moves do not allocate.
+    NOMAD::Point tmp ( std::move ( p ) );
+    p     = std::move ( *this );
+    *this = std::move ( tmp );
+}
+
+/*-----------------------------------------------------------*/
+/*                           operator ==                     */
+/*-----------------------------------------------------------*/
+bool NOMAD::Point::operator == ( const NOMAD::PointView & p ) const
+{
+    return NOMAD::PointView ( *this ) == p;
 }
 
 /*--------------------------------------------------------------------------*/
 /* comparison operator '<': it is used to find and store the points         */
 /*                           in the cache/database                          */
 /*--------------------------------------------------------------------------*/
-bool NOMAD::Point::operator < ( const NOMAD::Point & p ) const
+bool NOMAD::Point::operator < ( const NOMAD::PointView & p ) const
 {
-    if ( this == &p )
-        return false;
+    return NOMAD::PointView ( *this ) < p;
+}
 
-    if ( _n < p._n )
-        return true;
-    if ( _n > p._n )
-        return false;
+/*-----------------------------------------------------------*/
+/*                            norms                          */
+/*-----------------------------------------------------------*/
+NOMAD::Double NOMAD::Point::squared_norm ( void ) const
+{
+    return NOMAD::Reduction::squared_norm ( _coords , _n );
+}
 
-    const NOMAD::Double * p1 =   _coords;
-    const NOMAD::Double * p2 = p._coords;
+NOMAD::Double NOMAD::Point::norm ( NOMAD::hnorm_type type ) const
+{
+    return NOMAD::Reduction::norm ( _coords , _n , type );
+}
 
-    for ( int k = 0 ; k < _n ; ++k , ++p1 , ++p2 )
-    {
+NOMAD::Double NOMAD::Point::dist ( const NOMAD::PointView & p , NOMAD::hnorm_type type ) const
+{
+    if ( p.get_size() != _n )
+        throw NOMAD::Exception ( "Point.cpp" , __LINE__ ,
+                                "NOMAD::Point::dist(): bad dimensions" );
+    return NOMAD::Reduction::dist ( _coords , 1 , p.data() , p.get_stride() , _n , type );
+}
+
+NOMAD::Double NOMAD::Point::dot_product ( const NOMAD::PointView & p ) const
+{
+    if ( p.get_size() != _n )
+        throw NOMAD::Exception ( "Point.cpp" , __LINE__ ,
+                                "NOMAD::Point::dot_product(): bad dimensions" );
+    return NOMAD::Reduction::dot ( _coords , 1 , p.data() , p.get_stride() , _n );
+}
 
-        if ( *p1 < *p2 )
-            return true;
+/*-----------------------------------------------------------*/
+/*                     projection to the mesh                */
+/*-----------------------------------------------------------*/
+void NOMAD::Point::project_to_mesh ( const NOMAD::PointView & ref   ,
+                                     const NOMAD::PointView & delta ,
+                                     const NOMAD::PointView & lb    ,
+                                     const NOMAD::PointView & ub      )
+{
+    NOMAD::Point::project_to_mesh ( this , 1 , ref , delta , lb , ub );
+}
 
-        if ( *p1 > *p2 )
-            return false;
+void NOMAD::Point::project_to_mesh ( NOMAD::Point           * points    ,
+                                     int                      nb_points ,
+                                     const NOMAD::PointView & ref       ,
+                                     const NOMAD::PointView & delta     ,
+                                     const NOMAD::PointView & lb        ,
+                                     const NOMAD::PointView & ub          )
+{
+    if ( nb_points <= 0 )
+        return;
+
+    int n = points[0]._n;
+    if ( delta.get_size() != n                             ||
+         ( ref.get_size() != n && ref.get_size() != 0 )    ||
+         ( lb.get_size()  != n && lb.get_size()  != 0 )    ||
+         ( ub.get_size()  != n && ub.get_size()  != 0 )       )
+        throw NOMAD::Exception ( "Point.cpp" , __LINE__ ,
+                                "NOMAD::Point::project_to_mesh(): bad dimensions" );
+
+    // The projection reads contiguous arrays: the other views are copied.
+    if ( !ref.is_contiguous() || !delta.is_contiguous() ||
+         !lb.is_contiguous()  || !ub.is_contiguous()       )
+    {
+        NOMAD::Point::project_to_mesh ( points , nb_points ,
+                                        ref.to_point() , delta.to_point() ,
+                                        lb.to_point()  , ub.to_point()      );
+        return;
     }
 
-    return false;
+    for ( int k = 0 ; k < nb_points ; ++k )
+    {
+        if ( points[k]._n != n )
+            throw NOMAD::Exception ( "Point.cpp" , __LINE__ ,
+                                    "NOMAD::Point::project_to_mesh(): bad dimensions" );
+        NOMAD::Double::project_to_mesh ( points[k]._coords ,
+                                         n                 ,
+                                         ref.data()        ,
+                                         delta.data()      ,
+                                         lb.data()         ,
+                                         ub.data()           );
+    }
 }
 
 /*-----------------------------------------------------------*/
@@ -158,37 +321,5 @@ void NOMAD::Point::display ( std::ostream &out,
                             int                    w   ,
                             int                    lim   ) const
 {
-    int nm1 = _n-1;
-
-    // for a limited display of maximum lim elements:
-    if ( lim > 0 && lim < _n )
-    {
-
-        int l1 = (lim + 1) / 2 , l2 = lim / 2 , i;
-
-        // first coordinates:
-        for ( i = 0 ; i < l1 ; ++i )
-            out << std::setw ( w ) << _coords[i] << sep;
-
-        // separator:
-        out << "..." << sep;
-
-        // last coordinates:
-        for ( i = _n - l2 ; i < nm1 ; ++i )
-            out << std::setw ( w ) << _coords[i] << sep;
-    }
-
-    // normal display (lim <= 0 or lim >= _n):
-    else
-    {
-        const NOMAD::Double * p = _coords;
-        for ( int i = 0 ; i < nm1 ; ++i , ++p )
-            out << std::setw ( w ) << *p << sep;
-    }
-
-    // last coordinate (different because there is no separator after that):
-    if ( _n > 0 )
-        out << std::setw ( w ) << _coords[nm1];
+    NOMAD::PointView ( *this ).display ( out , sep , w , lim );
 }
-
-
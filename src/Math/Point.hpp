@@ -11,6 +11,7 @@
 
 #include <numeric>
 #include "Math/Double.hpp"
+#include "Math/PointView.hpp"
 
 #include "nomad_nsbegin.hpp"
 
@@ -31,15 +32,36 @@
     /// Class for the representation of a point.
     /**
      A point is defined by its size and its coordinates.
+     Up to \c SMALL_SIZE coordinates are stored inside the object, without
+     heap allocation (see \c POINT_SMALL_SIZE in defines.hpp).
+     A point converts to a NOMAD::PointView without copy, and the functions
+     that read another point take views.
     */
     class Point {
+    public:
+        /// Max dimension of the points stored without heap allocation.
+        static const int SMALL_SIZE = POINT_SMALL_SIZE;
+
     private:
         /*---------*/
         /* Members */
         /*---------*/
 
         int _n;                     // Dimension of the point
-        NOMAD::Double* _coords;     // Coordinates of the point
+        NOMAD::Double* _coords;     // Coordinates of the point: NULL, _small or heap
+
+        // Storage of the coordinates of small points. The NOMAD::Double
+        // objects are constructed in place for the first _n values only.
+        double _small[SMALL_SIZE];
+
+        /// Allocate and construct \c _n undefined coordinates.
+        void allocate ( void );
+
+        /// Destroy and free the coordinates.
+        void release ( void );
+
+        /// Are the coordinates stored on the heap ?
+        bool is_on_heap ( void ) const { return _n > SMALL_SIZE; }
 
     public:
         /*-------------*/
@@ -58,6 +80,14 @@
          */
         Point ( const Point & p );
 
+        /// Move constructor.
+        /**
+         The coordinates of a point on the heap are moved, and \c p becomes
+         empty. Small points are copied.
+         \param p The moved object -- \b IN/OUT.
+         */
+        Point ( Point && p ) noexcept;
+
         /// Affectation operator.
         /**
          \param p The right-hand side object -- \b IN.
@@ -65,6 +95,19 @@
          */
         const Point & operator = ( const Point & p );
 
+        /// Move affectation operator.
+        /**
+         \param p The right-hand side object -- \b IN/OUT.
+         \return \c *this as the result of the affectation.
+         */
+        Point & operator = ( Point && p ) noexcept;
+
+        /// Swap the content of two points.
+        /**
+         \param p The other point -- \b IN/OUT.
+         */
+        void swap ( Point & p ) noexcept;
+
         /// Destructor.
         ~Point ( void );
 
@@ -91,6 +134,12 @@
          */
         int get_size ( void ) const { return _n; }
 
+        /// Conversion to a view, without copy.
+        /**
+         \return A view on the coordinates.
+         */
+        operator NOMAD::PointView ( void ) const { return NOMAD::PointView ( _coords , _n ); }
+
         /*------------*/
         /* Comparison */
         /*------------*/
@@ -99,21 +148,88 @@
          \param p The right-hand side object -- \b IN.
          \return A boolean equal to \c true if  \c *this \c == \c p.
          */
-        bool operator == ( const Point & p ) const;
+        bool operator == ( const NOMAD::PointView & p ) const;
 
         /// Comparison operator \c !=.
         /**
          \param p The right-hand side object -- \b IN.
          \return A boolean equal to \c true if  \c *this \c != \c p.
          */
-        bool operator != ( const Point & p ) const { return !(*this == p); }
+        bool operator != ( const NOMAD::PointView & p ) const { return !(*this == p); }
 
         /// Comparison operator \c <.
         /**
          \param p The right-hand side object -- \b IN.
          \return A boolean equal to \c true if  \c *this \c < \c p.
          */
-        bool operator <  ( const Point & p ) const;
+        bool operator <  ( const NOMAD::PointView & p ) const;
+
+        /*-------*/
+        /* Norms */
+        /*-------*/
+        /// Squared L2 norm.
+        /**
+         \return The squared L2 norm of the point.
+         */
+        NOMAD::Double squared_norm ( void ) const;
+
+        /// Norm.
+        /**
+         \param type The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         \return The norm of the point.
+         */
+        NOMAD::Double norm ( NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /// Distance to another point.
+        /**
+         \param p    The other point -- \b IN.
+         \param type The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         \return The norm of \c p \c - \c *this.
+         */
+        NOMAD::Double dist ( const NOMAD::PointView & p , NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /// Dot product with another point.
+        /**
+         \param p The other point -- \b IN.
+         \return The dot product of \c *this and \c p.
+         */
+        NOMAD::Double dot_product ( const NOMAD::PointView & p ) const;
+
+        /*------------*/
+        /* Projection */
+        /*------------*/
+        /// Projection to the mesh.
+        /**
+         Each coordinate is projected as with NOMAD::Double::project_to_mesh().
+         A point of size 0 for \c ref, \c lb or \c ub stands for undefined
+         values. The other points must have the dimension of \c *this.
+         Views that are not contiguous are copied.
+         \param ref    Reference for projection -- \b IN.
+         \param delta  Mesh size parameters -- \b IN.
+         \param lb     Lower bounds -- \b IN -- \b optional (default=empty point).
+         \param ub     Upper bounds -- \b IN -- \b optional (default=empty point).
+         */
+        void project_to_mesh ( const NOMAD::PointView & ref                      ,
+                               const NOMAD::PointView & delta                    ,
+                               const NOMAD::PointView & lb = NOMAD::PointView()  ,
+                               const NOMAD::PointView & ub = NOMAD::PointView()    );
+
+        /// Projection to the mesh of a block of points.
+        /**
+         Same as \c project_to_mesh() on each point of the block.
+         \param points     The points to project -- \b IN/OUT.
+         \param nb_points  Number of points -- \b IN.
+         \param ref        Reference for projection -- \b IN.
+         \param delta      Mesh size parameters -- \b IN.
+         \param lb         Lower bounds -- \b IN -- \b optional (default=empty point).
+         \param ub         Upper bounds -- \b IN -- \b optional (default=empty point).
+         */
+        static void project_to_mesh ( Point                  * points                     ,
+                                      int                      nb_points                  ,
+                                      const NOMAD::PointView & ref                        ,
+                                      const NOMAD::PointView & delta                      ,
+                                      const NOMAD::PointView & lb = NOMAD::PointView()    ,
+                                      const NOMAD::PointView & ub = NOMAD::PointView()      );
 
         /*---------*/
         /* Display */
@@ -139,20 +255,21 @@
         /*---------------*/
         /// Size of the point in memory.
         /**
-         \return Size of the point in memory, in bytes.
+         \return Size of the point in memory, in bytes, including the
+         coordinates stored on the heap.
          */
         int mem_sizeof ( void ) const
         {
-            return std::accumulate ( _coords,
-                                    _coords+_n,
-                                    static_cast<int>(sizeof(_n)),
-                                    memsize_of_op());
-
+            return static_cast<int> ( sizeof(Point) ) +
+                   ( is_on_heap() ? _n * static_cast<int> ( sizeof(NOMAD::Double) ) : 0 );
         }
 
     };
 
     std::ostream& operator<< (std::ostream& out, const NOMAD::Point& point);
 
+    /// Swap the content of two points.
+    inline void swap ( NOMAD::Point & p1 , NOMAD::Point & p2 ) noexcept { p1.swap ( p2 ); }
+
 #include "nomad_nsend.hpp"
 #endif
@@ -0,0 +1,154 @@
+/**
+ \file   PointHash.cpp
+ \brief  Hash of points, consistent with the comparison of NOMAD::Double (implementation)
+ \see    PointHash.hpp
+ */
+
+#include <cfloat>
+#include <cmath>
+#include "Math/PointHash.hpp"
+#include "Util/Exception.hpp"
+
+const int NOMAD::PointHash::MAX_AMBIGUOUS;
+const int NOMAD::PointHash::MAX_KEYS;
+
+namespace {
+
+    // Cell of the undefined coordinates
+    const int64_t UNDEF_CELL = INT64_MIN;
+
+    // Cells beyond this index are merged
+    const double MAX_CELL = 4611686018427387904.0;  // 2^62
+
+    // Offset of the cells of the coordinate i, in (-1/4,1/4): a Weyl
+    // sequence, so that the boundaries of the cells are far from the
+    // mesh points and from the points of the finer meshes
+    inline double offset ( int i )
+    {
+        double u = ( i + 1 ) * 0.6180339887498949;
+        return 0.5 * ( u - floor ( u ) ) - 0.25;
+    }
+
+    // Mixed value of the cell k of the coordinate i (splitmix64 finalizer)
+    inline uint64_t cell_mix ( int i , int64_t k )
+    {
+        return NOMAD::mix ( static_cast<uint64_t> ( k ) + static_cast<uint64_t> ( i + 1 ) * 0x9E3779B97F4A7C15ULL );
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                         constructors                      */
+/*-----------------------------------------------------------*/
+NOMAD::PointHash::PointHash ( double quantum )
+  : _ref     ( ) ,
+    _delta   ( ) ,
+    _quantum ( quantum )
+{
+    if ( !( quantum > 2 * NOMAD::Double::get_epsilon() ) || NOMAD::Double::is_undef_value ( quantum ) )
+        throw NOMAD::Exception ( "PointHash.cpp" , __LINE__ ,
+                                "NOMAD::PointHash::PointHash(): quantum must be larger than 2*epsilon" );
+}
+
+NOMAD::PointHash::PointHash ( const NOMAD::PointView & ref , const NOMAD::PointView & delta )
+  : _ref     ( ref.to_point() ) ,
+    _delta   ( delta.to_point() ) ,
+    _quantum ( NOMAD::DEFAULT_HASH_QUANTUM )
+{
+    if ( ref.get_size() != delta.get_size() )
+        throw NOMAD::Exception ( "PointHash.cpp" , __LINE__ ,
+                                "NOMAD::PointHash::PointHash(): bad dimensions" );
+
+    for ( int i = 0 ; i < delta.get_size() ; ++i )
+    {
+        if ( !ref[i].is_defined() || !delta[i].is_defined() ||
+             !( delta[i].todouble() > 2 * NOMAD::Double::get_epsilon() ) )
+            throw NOMAD::Exception ( "PointHash.cpp" , __LINE__ ,
+                                    "NOMAD::PointHash::PointHash(): mesh sizes must be larger than 2*epsilon" );
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                     cell of one coordinate                */
+/*-----------------------------------------------------------*/
+int64_t NOMAD::PointHash::cell ( int i , const NOMAD::Double & x , int & side ) const
+{
+    side = 0;
+    double v = *reinterpret_cast<const double*> ( &x );
+    if ( NOMAD::Double::is_undef_value ( v ) )
+        return UNDEF_CELL;
+
+    double ref = 0.0 , delta = _quantum;
+    if ( i < _delta.get_size() )
+    {
+        ref   = _ref  [i].todouble();
+        delta = _delta[i].todouble();
+    }
+
+    double t = ( v - ref ) / delta - offset ( i );
+    if ( fabs ( t ) > MAX_CELL )
+        return ( t > 0 ) ? static_cast<int64_t> ( MAX_CELL ) : -static_cast<int64_t> ( MAX_CELL );
+
+    // Cells are near ref + k*delta; two values that are equal
+    // for NOMAD::Double differ by less than epsilon, plus the rounding
+    // errors of the division
+    double k      = floor ( t + 0.5 );
+    double r      = t - k;
+    double margin = NOMAD::Double::get_epsilon() / delta
+                  + 4 * DBL_EPSILON * ( fabs ( t ) + ( fabs ( v ) + fabs ( ref ) ) / delta + 1.0 );
+
+    if ( margin >= 0.5 )
+        side = 2;
+    else if ( r > 0.5 - margin )
+        side = 1;
+    else if ( r < margin - 0.5 )
+        side = -1;
+
+    return static_cast<int64_t> ( k );
+}
+
+/*-----------------------------------------------------------*/
+/*                            hash                           */
+/*-----------------------------------------------------------*/
+uint64_t NOMAD::PointHash::operator () ( const NOMAD::PointView & x ) const
+{
+    uint64_t h = static_cast<uint64_t> ( x.get_size() );
+    int side;
+    for ( int i = 0 ; i < x.get_size() ; ++i )
+        h += cell_mix ( i , cell ( i , x[i] , side ) );
+    return h;
+}
+
+/*-----------------------------------------------------------*/
+/*              all the hashes of the equal points           */
+/*-----------------------------------------------------------*/
+int NOMAD::PointHash::keys ( const NOMAD::PointView & x , uint64_t * keys ) const
+{
+    uint64_t h  = static_cast<uint64_t> ( x.get_size() );
+    int      nb = 1;
+    int      side;
+
+    // Each coordinate near a boundary doubles the number of hashes:
+    // the alternatives differ from the base hash by one term, and
+    // keys[s] holds the offset from the base hash until the end
+    keys[0] = 0;
+    for ( int i = 0 ; i < x.get_size() ; ++i )
+    {
+        int64_t  k = cell ( i , x[i] , side );
+        uint64_t m = cell_mix ( i , k );
+        h += m;
+        if ( side == 0 )
+            continue;
+        if ( side == 2 || nb == MAX_KEYS )
+            return -1;
+
+        uint64_t d = cell_mix ( i , k + side ) - m;
+        for ( int s = 0 ; s < nb ; ++s )
+            keys[nb+s] = keys[s] + d;
+        nb *= 2;
+    }
+
+    for ( int s = 0 ; s < nb ; ++s )
+        keys[s] += h;
+
+    return nb;
+}
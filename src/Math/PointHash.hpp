@@ -0,0 +1,119 @@
+/**
+ \file   PointHash.hpp
+ \brief  Hash of points, consistent with the comparison of NOMAD::Double
+ \see    PointHash.cpp
+ */
+
+#ifndef __NOMAD400_POINTHASH__
+#define __NOMAD400_POINTHASH__
+
+#include "Math/Double.hpp"
+#include "Math/Point.hpp"
+#include "Math/PointView.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the hash of points, consistent with the epsilon of NOMAD::Double.
+    /**
+     - Each coordinate \c x_i is quantized to the cell
+       \c k_i \c = \c round((x_i-ref_i)/delta_i-u_i), with a fixed offset
+       \c u_i in \c (-1/4,1/4). With a mesh frame (\c ref, \c delta), the
+       mesh points are at least \c delta_i/4 away from the boundaries of
+       the cells, and the points of the finer meshes are never on them.
+       Without it, \c ref is 0 and \c delta is the same quantum for all
+       coordinates.
+     - The hash is the sum of one mixed value per coordinate. Points
+       that are equal for NOMAD::Double::operator==() may fall in
+       neighbour cells when a coordinate is within epsilon of a cell
+       boundary: keys() gives the hashes of all these cells, so that a
+       lookup is exact, and each alternative hash costs one subtraction
+       and one addition.
+     - The hash of a point is computed with the current epsilon, and is
+       the same for all epsilons smaller than half the quantum.
+    */
+    class PointHash {
+    public:
+
+        /// Maximal number of coordinates near a cell boundary in keys().
+        /**
+         Up to \c 2^MAX_AMBIGUOUS hashes are enumerated.
+         */
+        static const int MAX_AMBIGUOUS = 8;
+
+        /// Maximal number of hashes given by keys().
+        static const int MAX_KEYS = 1 << MAX_AMBIGUOUS;
+
+    private:
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        NOMAD::Point _ref;      // Origin of the cells (empty: 0)
+        NOMAD::Point _delta;    // Widths of the cells (empty: _quantum)
+        double       _quantum;  // Width of the cells without mesh frame
+
+        /// Cell of one coordinate.
+        /**
+         \param i    The index of the coordinate -- \b IN.
+         \param x    The coordinate -- \b IN.
+         \param side -1 or 1 if the coordinate is within epsilon of the lower
+                     or upper boundary of the cell, 0 otherwise -- \b OUT.
+         \return     The index of the cell.
+         */
+        int64_t cell ( int i , const NOMAD::Double & x , int & side ) const;
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /// Constructor with the same quantum for all coordinates.
+        /**
+         \param quantum The width of the cells, larger than twice the epsilon
+                        -- \b IN -- \b optional (default = DEFAULT_HASH_QUANTUM).
+         */
+        explicit PointHash ( double quantum = NOMAD::DEFAULT_HASH_QUANTUM );
+
+        /// Constructor with a mesh frame.
+        /**
+         \param ref   The reference point of the mesh -- \b IN.
+         \param delta The mesh sizes, larger than twice the epsilon -- \b IN.
+         */
+        PointHash ( const NOMAD::PointView & ref , const NOMAD::PointView & delta );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the quantum used without mesh frame.
+        double get_quantum ( void ) const { return _quantum; }
+
+        /// Access to the reference point of the mesh (empty without mesh frame).
+        const NOMAD::Point & get_ref ( void ) const { return _ref; }
+
+        /// Access to the mesh sizes (empty without mesh frame).
+        const NOMAD::Point & get_delta ( void ) const { return _delta; }
+
+        /*------*/
+        /* Hash */
+        /*------*/
+        /// Hash of a point.
+        /**
+         Equal points have the same hash, except when a coordinate is within
+         epsilon of a cell boundary. Use keys() for lookups.
+         \param x The point -- \b IN.
+         \return  The hash.
+         */
+        uint64_t operator () ( const NOMAD::PointView & x ) const;
+
+        /// All the hashes of the points equal to a point.
+        /**
+         The first hash is \c (*this)(x).
+         \param x    The point -- \b IN.
+         \param keys The hashes, an array of \c MAX_KEYS values -- \b OUT.
+         \return     The number of hashes, or \c -1 if more than \c MAX_AMBIGUOUS
+                     coordinates are near a cell boundary.
+         */
+        int keys ( const NOMAD::PointView & x , uint64_t * keys ) const;
+    };
+
+#include "nomad_nsend.hpp"
+#endif
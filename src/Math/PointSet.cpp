@@ -0,0 +1,542 @@
+/**
+ \file   PointSet.cpp
+ \brief  Set of points stored in one contiguous array (implementation)
+ \see    PointSet.hpp
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#ifdef WINDOWS
+#include <malloc.h>
+#endif
+#include "Math/PointSet.hpp"
+#include "Math/Reduction.hpp"
+
+const int NOMAD::PointSet::ALIGNMENT;
+
+std::ostream& NOMAD::operator<<(std::ostream& out, const NOMAD::PointSet& ps)
+{
+    ps.display(out);
+    return out;
+}
+
+namespace {
+
+    // Aligned allocation of nb NOMAD::Double, not constructed.
+    NOMAD::Double * aligned_allocate ( int nb )
+    {
+        if ( nb <= 0 )
+            return NULL;
+        size_t bytes = static_cast<size_t> ( nb ) * sizeof(NOMAD::Double);
+        void * p = NULL;
+#ifdef WINDOWS
+        p = _aligned_malloc ( bytes , NOMAD::PointSet::ALIGNMENT );
+#else
+        if ( posix_memalign ( &p , NOMAD::PointSet::ALIGNMENT , bytes ) != 0 )
+            p = NULL;
+#endif
+        if ( !p )
+            throw std::bad_alloc();
+        return static_cast<NOMAD::Double *> ( p );
+    }
+
+    void aligned_free ( NOMAD::Double * p )
+    {
+#ifdef WINDOWS
+        _aligned_free ( p );
+#else
+        std::free ( p );
+#endif
+    }
+
+    // Leading dimension of the SOA layout: the capacity rounded up so that
+    // each column is aligned.
+    int soa_ld ( int capacity )
+    {
+        const int k = NOMAD::PointSet::ALIGNMENT / static_cast<int> ( sizeof(NOMAD::Double) );
+        return ( ( capacity + k - 1 ) / k ) * k;
+    }
+
+    // Raw values of an array of NOMAD::Double.
+    inline const double * raw ( const NOMAD::Double * x )
+    {
+        return reinterpret_cast<const double *> ( x );
+    }
+
+    // Accumulation of one term of a norm. NaN terms propagate, except
+    // for LINF: see sweep_columns().
+    template < NOMAD::hnorm_type TYPE >
+    inline double accumulate ( double r , double t )
+    {
+        switch ( TYPE )
+        {
+            case NOMAD::L1:
+                return r + std::fabs ( t );
+            case NOMAD::LINF:
+            {
+                double a = std::fabs ( t );
+                return ( a > r ) ? a : r;
+            }
+            default:
+                return r + t * t;
+        }
+    }
+
+    // Terms of the norms, for the point k of a block: x, y-x with y a
+    // point, or y-x with y a SOA matrix.
+    struct No_Y
+    {
+        static double term ( const double * xj , const double * , double , int k ) { return xj[k]; }
+    };
+    struct Point_Y
+    {
+        static double term ( const double * xj , const double * , double yj , int k ) { return yj - xj[k]; }
+    };
+    struct Matrix_Y
+    {
+        static double term ( const double * xj , const double * yj , double , int k ) { return yj[k] - xj[k]; }
+    };
+
+    // Norms of the points of a SOA matrix x, or norms of y-x, by blocks of
+    // W points: the W norms of a block are accumulated in registers while
+    // sweeping the columns, and the loop over the block vectorizes.
+    // The columns are padded to a multiple of W values, so the last block
+    // may read padding values, whose results are not stored.
+    const int W = 8;
+
+    // With LINF, the comparisons ignore the NaN terms, which are detected
+    // by the sums of the absolute values of the terms.
+    template < NOMAD::hnorm_type TYPE , typename T >
+    void sweep_columns ( const double * x , int ldx , const double * y , int ldy ,
+                         int nb_points , int n , double * r )
+    {
+        for ( int b = 0 ; b < nb_points ; b += W )
+        {
+            // W=8 accumulators, explicit so that they stay in registers.
+            double a0 = 0.0 , a1 = 0.0 , a2 = 0.0 , a3 = 0.0;
+            double a4 = 0.0 , a5 = 0.0 , a6 = 0.0 , a7 = 0.0;
+            double s0 = 0.0 , s1 = 0.0 , s2 = 0.0 , s3 = 0.0;
+            double s4 = 0.0 , s5 = 0.0 , s6 = 0.0 , s7 = 0.0;
+
+            for ( int j = 0 ; j < n ; ++j )
+            {
+                const double * __restrict xj = x + static_cast<size_t> ( j ) * ldx + b;
+                const double * __restrict yj = ( ldy > 0 ) ? y + static_cast<size_t> ( j ) * ldy + b : y;
+                const double              yv = ( y && ldy == 0 ) ? y[j] : 0.0;
+                const double t0 = T::term ( xj , yj , yv , 0 ) , t1 = T::term ( xj , yj , yv , 1 );
+                const double t2 = T::term ( xj , yj , yv , 2 ) , t3 = T::term ( xj , yj , yv , 3 );
+                const double t4 = T::term ( xj , yj , yv , 4 ) , t5 = T::term ( xj , yj , yv , 5 );
+                const double t6 = T::term ( xj , yj , yv , 6 ) , t7 = T::term ( xj , yj , yv , 7 );
+                a0 = accumulate<TYPE> ( a0 , t0 );
+                a1 = accumulate<TYPE> ( a1 , t1 );
+                a2 = accumulate<TYPE> ( a2 , t2 );
+                a3 = accumulate<TYPE> ( a3 , t3 );
+                a4 = accumulate<TYPE> ( a4 , t4 );
+                a5 = accumulate<TYPE> ( a5 , t5 );
+                a6 = accumulate<TYPE> ( a6 , t6 );
+                a7 = accumulate<TYPE> ( a7 , t7 );
+                if ( TYPE == NOMAD::LINF )
+                {
+                    s0 = accumulate<NOMAD::L1> ( s0 , t0 );
+                    s1 = accumulate<NOMAD::L1> ( s1 , t1 );
+                    s2 = accumulate<NOMAD::L1> ( s2 , t2 );
+                    s3 = accumulate<NOMAD::L1> ( s3 , t3 );
+                    s4 = accumulate<NOMAD::L1> ( s4 , t4 );
+                    s5 = accumulate<NOMAD::L1> ( s5 , t5 );
+                    s6 = accumulate<NOMAD::L1> ( s6 , t6 );
+                    s7 = accumulate<NOMAD::L1> ( s7 , t7 );
+                }
+            }
+
+            const double acc[W] = { a0 , a1 , a2 , a3 , a4 , a5 , a6 , a7 };
+            const double sum[W] = { s0 , s1 , s2 , s3 , s4 , s5 , s6 , s7 };
+            int m = std::min ( W , nb_points - b );
+            for ( int k = 0 ; k < m ; ++k )
+            {
+                if ( TYPE == NOMAD::L2 )
+                    r[b+k] = std::sqrt ( acc[k] );
+                else if ( TYPE == NOMAD::LINF && sum[k] != sum[k] )
+                    r[b+k] = NOMAD::NaN;
+                else
+                    r[b+k] = acc[k];
+            }
+        }
+    }
+
+    // y is NULL, a point (ldy=0), or a SOA matrix with leading dimension ldy.
+    template < typename T >
+    void sweep_columns ( const double * x , int ldx , const double * y , int ldy ,
+                         int nb_points , int n , NOMAD::hnorm_type type , double * r )
+    {
+        switch ( type )
+        {
+            case NOMAD::L1:
+                sweep_columns<NOMAD::L1  ,T> ( x , ldx , y , ldy , nb_points , n , r );
+                break;
+            case NOMAD::LINF:
+                sweep_columns<NOMAD::LINF,T> ( x , ldx , y , ldy , nb_points , n , r );
+                break;
+            default:
+                sweep_columns<NOMAD::L2  ,T> ( x , ldx , y , ldy , nb_points , n , r );
+                break;
+        }
+    }
+
+    // Is one of the n values x[0], x[stride], ... undefined ?
+    bool has_undef ( const double * x , int n , int stride )
+    {
+        if ( !x )
+            return false;
+        for ( int j = 0 ; j < n ; ++j )
+            if ( NOMAD::Double::is_undef_value ( x[j*stride] ) )
+                return true;
+        return false;
+    }
+
+    // Check the NaN results of sweep_columns() for undefined arguments.
+    void check_results ( const double * x , int ldx , const double * y , int ldy ,
+                         int nb_points , int n , double * r )
+    {
+        for ( int i = 0 ; i < nb_points ; ++i )
+        {
+            if ( r[i] == r[i] )
+                continue;
+            bool undef = has_undef ( x + i , n , ldx ) ||
+                         ( ( ldy == 0 ) ? has_undef ( y , n , 1 ) : has_undef ( y + i , n , ldy ) );
+            if ( undef )
+            {
+#ifdef UNCHECKED_DOUBLE
+                reinterpret_cast<NOMAD::Double *> ( r )[i] = NOMAD::Double();
+#else
+                throw NOMAD::Double::Not_Defined ( "PointSet.cpp" , __LINE__ ,
+                                                   "NOMAD::PointSet: value not defined" );
+#endif
+            }
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                  allocation of the buffer                 */
+/*-----------------------------------------------------------*/
+void NOMAD::PointSet::reallocate ( int capacity , NOMAD::storage_layout layout )
+{
+    // The values are indexed with int products such as i*_ld+j, which are
+    // valid only if the buffer holds at most INT_MAX values.
+    const long long k  = NOMAD::PointSet::ALIGNMENT / static_cast<int> ( sizeof(NOMAD::Double) );
+    const long long nb = ( layout == NOMAD::AOS ) ? capacity : ( ( capacity + k - 1 ) / k ) * k;
+    if ( capacity < 0 || nb > INT_MAX || nb * _n > INT_MAX )
+        throw NOMAD::Exception ( "PointSet.cpp" , __LINE__ ,
+                                "NOMAD::PointSet::reallocate(): capacity too large" );
+
+    int ld   = ( layout == NOMAD::AOS ) ? _n : soa_ld ( capacity );
+    int size = ( layout == NOMAD::AOS ) ? capacity * _n : _n * ld;
+
+    NOMAD::Double * data = aligned_allocate ( size );
+    for ( int k = 0 ; k < size ; ++k )
+        new ( data + k ) NOMAD::Double;
+
+    // Copy of the points.
+    if ( layout == _layout && layout == NOMAD::AOS )
+        std::copy ( _data , _data + _nb_points * _n , data );
+    else
+        for ( int i = 0 ; i < _nb_points ; ++i )
+            for ( int j = 0 ; j < _n ; ++j )
+                data[ ( layout == NOMAD::AOS ) ? i*ld+j : j*ld+i ] = (*this)(i,j);
+
+    release();
+    _data     = data;
+    _capacity = capacity;
+    _layout   = layout;
+    _ld       = ld;
+}
+
+void NOMAD::PointSet::release ( void )
+{
+    if ( !_data )
+        return;
+    int size = buffer_size();
+    for ( int k = 0 ; k < size ; ++k )
+        _data[k].~Double();
+    aligned_free ( _data );
+    _data = NULL;
+}
+
+/*-----------------------------------------------------------*/
+/*                         constructor                       */
+/*-----------------------------------------------------------*/
+NOMAD::PointSet::PointSet ( int                     nb_points ,
+                            int                     n         ,
+                            NOMAD::storage_layout   layout    ,
+                            const NOMAD::Double   & val         )
+  : _nb_points (0),
+    _n (std::max ( n , 0 )),
+    _layout (layout),
+    _capacity (0),
+    _ld (0),
+    _data (NULL)
+{
+    reallocate ( std::max ( nb_points , 0 ) , layout );
+    _nb_points = _capacity;
+    if ( val.is_defined() )
+        std::fill ( _data , _data + buffer_size() , val );
+}
+
+/*-----------------------------------------------------------*/
+/*                        copy constructor                   */
+/*-----------------------------------------------------------*/
+NOMAD::PointSet::PointSet ( const NOMAD::PointSet & ps )
+  : _nb_points (0),
+    _n (ps._n),
+    _layout (ps._layout),
+    _capacity (0),
+    _ld (0),
+    _data (NULL)
+{
+    reallocate ( ps._nb_points , ps._layout );
+    _nb_points = ps._nb_points;
+    if ( _layout == NOMAD::AOS )
+        std::copy ( ps._data , ps._data + _nb_points * _n , _data );
+    else
+        for ( int j = 0 ; j < _n ; ++j )
+            std::copy ( ps._data + j*ps._ld , ps._data + j*ps._ld + _nb_points , _data + j*_ld );
+}
+
+/*-----------------------------------------------------------*/
+/*                        move constructor                   */
+/*-----------------------------------------------------------*/
+NOMAD::PointSet::PointSet ( NOMAD::PointSet && ps ) noexcept
+  : _nb_points (ps._nb_points),
+    _n (ps._n),
+    _layout (ps._layout),
+    _capacity (ps._capacity),
+    _ld (ps._ld),
+    _data (ps._data)
+{
+    ps._nb_points = 0;
+    ps._n         = 0;
+    ps._capacity  = 0;
+    ps._ld        = 0;
+    ps._data      = NULL;
+}
+
+/*-----------------------------------------------*/
+/*                    destructor                 */
+/*-----------------------------------------------*/
+NOMAD::PointSet::~PointSet ( void )
+{
+    release();
+}
+
+/*-----------------------------------------------------------*/
+/*                     affectation operators                 */
+/*-----------------------------------------------------------*/
+NOMAD::PointSet & NOMAD::PointSet::operator = ( const NOMAD::PointSet & ps )
+{
+    if ( this == &ps )
+        return *this;
+
+    // Keep the buffer when it is large enough.
+    if ( _n == ps._n && _layout == ps._layout && _capacity >= ps._nb_points )
+    {
+        _nb_points = ps._nb_points;
+        for ( int i = 0 ; i < _nb_points ; ++i )
+            for ( int j = 0 ; j < _n ; ++j )
+                (*this)(i,j) = ps(i,j);
+        return *this;
+    }
+
+    NOMAD::PointSet tmp ( ps );
+    swap ( tmp );
+    return *this;
+}
+
+NOMAD::PointSet & NOMAD::PointSet::operator = ( NOMAD::PointSet && ps ) noexcept
+{
+    if ( this != &ps )
+    {
+        release();
+        _nb_points = ps._nb_points;
+        _n         = ps._n;
+        _layout    = ps._layout;
+        _capacity  = ps._capacity;
+        _ld        = ps._ld;
+        _data      = ps._data;
+        ps._nb_points = 0;
+        ps._n         = 0;
+        ps._capacity  = 0;
+        ps._ld        = 0;
+        ps._data      = NULL;
+    }
+    return *this;
+}
+
+/*-----------------------------------------------------------*/
+/*                            swap                           */
+/*-----------------------------------------------------------*/
+void NOMAD::PointSet::swap ( NOMAD::PointSet & ps ) noexcept
+{
+    std::swap ( _nb_points , ps._nb_points );
+    std::swap ( _n         , ps._n         );
+    std::swap ( _layout    , ps._layout    );
+    std::swap ( _capacity  , ps._capacity  );
+    std::swap ( _ld        , ps._ld        );
+    std::swap ( _data      , ps._data      );
+}
+
+/*-----------------------------------------------------------*/
+/*                     points and layout                     */
+/*-----------------------------------------------------------*/
+void NOMAD::PointSet::set_point ( int i , const NOMAD::PointView & p )
+{
+    if ( i < 0 || i >= _nb_points )
+        throw NOMAD::Exception ( "PointSet.cpp" , __LINE__ ,
+                                "NOMAD::PointSet::set_point(): bad index" );
+    if ( p.get_size() != _n )
+        throw NOMAD::Exception ( "PointSet.cpp" , __LINE__ ,
+                                "NOMAD::PointSet::set_point(): bad dimensions" );
+    Slice r = row ( i );
+    for ( int j = 0 ; j < _n ; ++j )
+        r[j] = p[j];
+}
+
+void NOMAD::PointSet::add_point ( const NOMAD::PointView & p )
+{
+    // The first point sets the dimension of an empty set.
+    if ( _nb_points == 0 && _n == 0 && p.get_size() > 0 )
+    {
+        release();
+        _n        = p.get_size();
+        _capacity = 0;
+        _ld       = 0;
+    }
+    if ( p.get_size() != _n )
+        throw NOMAD::Exception ( "PointSet.cpp" , __LINE__ ,
+                                "NOMAD::PointSet::add_point(): bad dimensions" );
+    if ( _nb_points == _capacity )
+        reallocate ( ( _capacity > INT_MAX / 2 ) ? INT_MAX : std::max ( 2 * _capacity , 4 ) , _layout );
+    ++_nb_points;
+    set_point ( _nb_points - 1 , p );
+}
+
+void NOMAD::PointSet::reserve ( int capacity )
+{
+    if ( capacity > _capacity )
+        reallocate ( capacity , _layout );
+}
+
+void NOMAD::PointSet::resize ( int nb_points )
+{
+    if ( nb_points < 0 )
+        nb_points = 0;
+    reserve ( nb_points );
+
+    // The new points may hold the values of removed points.
+    for ( int i = _nb_points ; i < nb_points ; ++i )
+        for ( int j = 0 ; j < _n ; ++j )
+            (*this)(i,j) = NOMAD::Double();
+    _nb_points = nb_points;
+}
+
+void NOMAD::PointSet::set_layout ( NOMAD::storage_layout layout )
+{
+    if ( layout != _layout )
+        reallocate ( _capacity , layout );
+}
+
+/*-----------------------------------------------------------*/
+/*                            norms                          */
+/*-----------------------------------------------------------*/
+void NOMAD::PointSet::norms ( NOMAD::Double * result , NOMAD::hnorm_type type ) const
+{
+    if ( _layout == NOMAD::AOS )
+    {
+        for ( int i = 0 ; i < _nb_points ; ++i )
+            result[i] = NOMAD::Reduction::norm ( _data + i*_ld , _n , type );
+        return;
+    }
+
+    double * r = reinterpret_cast<double *> ( result );
+    sweep_columns<No_Y> ( raw ( _data ) , _ld , NULL , 0 , _nb_points , _n , type , r );
+    check_results ( raw ( _data ) , _ld , NULL , 0 , _nb_points , _n , r );
+}
+
+void NOMAD::PointSet::dists ( const NOMAD::PointView & x , NOMAD::Double * result ,
+                              NOMAD::hnorm_type type ) const
+{
+    if ( x.get_size() != _n )
+        throw NOMAD::Exception ( "PointSet.cpp" , __LINE__ ,
+                                "NOMAD::PointSet::dists(): bad dimensions" );
+    if ( _n == 0 )
+    {
+        std::fill ( result , result + _nb_points , NOMAD::Double ( 0.0 ) );
+        return;
+    }
+
+    if ( _layout == NOMAD::AOS )
+    {
+        for ( int i = 0 ; i < _nb_points ; ++i )
+            result[i] = NOMAD::Reduction::dist ( _data + i*_ld , 1 , x.data() , x.get_stride() , _n , type );
+        return;
+    }
+
+    // The sweep of the columns reads a contiguous point.
+    if ( !x.is_contiguous() )
+    {
+        dists ( x.to_point() , result , type );
+        return;
+    }
+    const NOMAD::Double * y = x.data();
+
+    double * r = reinterpret_cast<double *> ( result );
+    sweep_columns<Point_Y> ( raw ( _data ) , _ld , raw ( y ) , 0 , _nb_points , _n , type , r );
+    check_results ( raw ( _data ) , _ld , raw ( y ) , 0 , _nb_points , _n , r );
+}
+
+void NOMAD::PointSet::dists ( const NOMAD::PointSet & ps , NOMAD::Double * result ,
+                              NOMAD::hnorm_type type ) const
+{
+    if ( ps._n != _n || ps._nb_points != _nb_points )
+        throw NOMAD::Exception ( "PointSet.cpp" , __LINE__ ,
+                                "NOMAD::PointSet::dists(): bad dimensions" );
+
+    if ( ps._layout != _layout )
+    {
+        NOMAD::PointSet tmp ( ps );
+        tmp.set_layout ( _layout );
+        dists ( tmp , result , type );
+        return;
+    }
+
+    if ( _layout == NOMAD::AOS )
+    {
+        for ( int i = 0 ; i < _nb_points ; ++i )
+            result[i] = NOMAD::Reduction::dist ( _data + i*_ld , ps._data + i*ps._ld , _n , type );
+        return;
+    }
+
+    double * r = reinterpret_cast<double *> ( result );
+    sweep_columns<Matrix_Y> ( raw ( _data ) , _ld , raw ( ps._data ) , ps._ld , _nb_points , _n , type , r );
+    check_results ( raw ( _data ) , _ld , raw ( ps._data ) , ps._ld , _nb_points , _n , r );
+}
+
+/*-----------------------------------------------------------*/
+/*                             display                       */
+/*-----------------------------------------------------------*/
+void NOMAD::PointSet::display ( std::ostream & out ) const
+{
+    for ( int i = 0 ; i < _nb_points ; ++i )
+    {
+        for ( int j = 0 ; j < _n ; ++j )
+        {
+            if ( j > 0 )
+                out << " ";
+            out << (*this)(i,j);
+        }
+        out << std::endl;
+    }
+}
@@ -0,0 +1,359 @@
+/**
+ \file   PointSet.hpp
+ \brief  Set of points stored in one contiguous array
+ \see    PointSet.cpp
+ */
+
+#ifndef __NOMAD400_POINTSET__
+#define __NOMAD400_POINTSET__
+
+#include "Math/Double.hpp"
+#include "Math/Point.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the representation of a set of points of the same dimension.
+    /**
+     - The coordinates of all the points are stored in one buffer, aligned
+       on \c ALIGNMENT bytes, with no allocation per point.
+     - With the \c AOS layout, the coordinates of a point (a row) are
+       contiguous. With the \c SOA layout, the values of a coordinate (a
+       column) are contiguous, and each column is aligned, so that the
+       kernels that sweep one coordinate over all the points vectorize.
+     - Rows and columns are accessed through strided slices, without copy.
+     - Points can be added at the end, as in a \c std::vector.
+    */
+    class PointSet {
+    public:
+
+        /// Alignment of the buffer and of the columns, in bytes.
+        static const int ALIGNMENT = 64;
+
+        /// Strided access to a row (point) or a column (coordinate).
+        /**
+         The slice does not own its values, and is invalidated when the
+         point set is reallocated or destroyed.
+         */
+        template < typename T >
+        class Strided_Slice {
+        private:
+            T * _data;      ///< First value.
+            int _size;      ///< Number of values.
+            int _stride;    ///< Distance between two values.
+
+        public:
+            /// Constructor.
+            /**
+             \param data   First value -- \b IN.
+             \param size   Number of values -- \b IN.
+             \param stride Distance between two values -- \b IN.
+             */
+            Strided_Slice ( T * data , int size , int stride )
+              : _data ( data ) , _size ( size ) , _stride ( stride ) {}
+
+            /// Conversion from a slice of non-const values.
+            /**
+             \param s The slice -- \b IN.
+             */
+            template < typename U >
+            Strided_Slice ( const Strided_Slice<U> & s )
+              : _data ( s.data() ) , _size ( s.get_size() ) , _stride ( s.get_stride() ) {}
+
+            /// Access to the \c (i+1)th value.
+            /**
+             \param i The index (0 for the first value) -- \b IN.
+             \return  The value.
+             */
+            T & operator [] ( int i ) const { return _data[i*_stride]; }
+
+            /// Access to the number of values.
+            int get_size ( void ) const { return _size; }
+
+            /// Access to the distance between two values.
+            int get_stride ( void ) const { return _stride; }
+
+            /// Access to the first value.
+            T * data ( void ) const { return _data; }
+
+            /// Are the values contiguous ?
+            bool is_contiguous ( void ) const { return _stride == 1 || _size <= 1; }
+
+            /// Conversion to a view, without copy.
+            /**
+             \return A view on the values.
+             */
+            operator NOMAD::PointView ( void ) const { return NOMAD::PointView ( _data , _size , _stride ); }
+
+            /// Copy of the values in a point.
+            /**
+             \return A point of dimension \c get_size().
+             */
+            NOMAD::Point to_point ( void ) const
+            {
+                NOMAD::Point p ( _size );
+                for ( int i = 0 ; i < _size ; ++i )
+                    p[i] = _data[i*_stride];
+                return p;
+            }
+        };
+
+        typedef Strided_Slice<NOMAD::Double>       Slice;       ///< Modifiable row or column.
+        typedef Strided_Slice<const NOMAD::Double> Const_Slice; ///< Constant row or column.
+
+    private:
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        int                   _nb_points;   // Number of points
+        int                   _n;           // Dimension of the points
+        NOMAD::storage_layout _layout;      // AOS or SOA
+        int                   _capacity;    // Number of points that fit in the buffer
+        int                   _ld;          // Leading dimension: distance between two
+                                            // rows (AOS) or two columns (SOA)
+        NOMAD::Double *       _data;        // Buffer of _capacity points
+
+        /// Size of the buffer, in number of values.
+        int buffer_size ( void ) const { return ( _layout == NOMAD::AOS ) ? _capacity * _n : _n * _ld; }
+
+        /// Reallocate the buffer for \c capacity points, keeping the points.
+        /**
+         \param capacity The new capacity -- \b IN.
+         \param layout   The new layout -- \b IN.
+         */
+        void reallocate ( int capacity , NOMAD::storage_layout layout );
+
+        /// Destroy and free the buffer.
+        void release ( void );
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /**
+         \param nb_points Number of points -- \b IN -- \b optional (default = 0).
+         \param n         Dimension of the points -- \b IN -- \b optional (default = 0).
+         \param layout    AOS or SOA -- \b IN -- \b optional (default = AOS).
+         \param val       Initial value for all coordinates
+         -- \b IN -- \b optional (default = undefined real).
+         */
+        explicit PointSet ( int                     nb_points = 0               ,
+                            int                     n         = 0               ,
+                            NOMAD::storage_layout   layout    = NOMAD::AOS      ,
+                            const NOMAD::Double   & val       = NOMAD::Double()   );
+
+        /// Copy constructor.
+        /**
+         \param ps The copied object -- \b IN.
+         */
+        PointSet ( const PointSet & ps );
+
+        /// Move constructor.
+        /**
+         \param ps The moved object, which becomes empty -- \b IN/OUT.
+         */
+        PointSet ( PointSet && ps ) noexcept;
+
+        /// Affectation operator.
+        /**
+         \param ps The right-hand side object -- \b IN.
+         \return \c *this as the result of the affectation.
+         */
+        PointSet & operator = ( const PointSet & ps );
+
+        /// Move affectation operator.
+        /**
+         \param ps The right-hand side object, which becomes empty -- \b IN/OUT.
+         \return \c *this as the result of the affectation.
+         */
+        PointSet & operator = ( PointSet && ps ) noexcept;
+
+        /// Swap the content of two point sets.
+        /**
+         \param ps The other point set -- \b IN/OUT.
+         */
+        void swap ( PointSet & ps ) noexcept;
+
+        /// Destructor.
+        ~PointSet ( void );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the number of points.
+        int get_nb_points ( void ) const { return _nb_points; }
+
+        /// Access to the dimension of the points.
+        int get_dimension ( void ) const { return _n; }
+
+        /// Access to the layout.
+        NOMAD::storage_layout get_layout ( void ) const { return _layout; }
+
+        /// Access to the number of points that fit without reallocation.
+        int get_capacity ( void ) const { return _capacity; }
+
+        /// Access to the buffer.
+        /**
+         The value \c (i,j) is at \c i*get_ld()+j with the AOS layout, and
+         at \c j*get_ld()+i with the SOA layout.
+         */
+        const NOMAD::Double * data ( void ) const { return _data; }
+        NOMAD::Double       * data ( void )       { return _data; }
+
+        /// Access to the leading dimension.
+        /**
+         \return The distance between two rows (AOS) or two columns (SOA).
+         */
+        int get_ld ( void ) const { return _ld; }
+
+        /// Access to the coordinate \c j of the point \c i.
+        /**
+         \param i The index of the point -- \b IN.
+         \param j The index of the coordinate -- \b IN.
+         \return  The coordinate.
+         */
+        const NOMAD::Double & operator () ( int i , int j ) const
+        {
+            return ( _layout == NOMAD::AOS ) ? _data[i*_ld+j] : _data[j*_ld+i];
+        }
+        NOMAD::Double & operator () ( int i , int j )
+        {
+            return ( _layout == NOMAD::AOS ) ? _data[i*_ld+j] : _data[j*_ld+i];
+        }
+
+        /// Access to the point \c i.
+        /**
+         \param i The index of the point -- \b IN.
+         \return  The coordinates of the point.
+         */
+        Const_Slice row ( int i ) const
+        {
+            return ( _layout == NOMAD::AOS ) ? Const_Slice ( _data + i*_ld , _n , 1   )
+                                             : Const_Slice ( _data + i     , _n , _ld );
+        }
+        Slice row ( int i )
+        {
+            return ( _layout == NOMAD::AOS ) ? Slice ( _data + i*_ld , _n , 1   )
+                                             : Slice ( _data + i     , _n , _ld );
+        }
+
+        /// Access to the coordinate \c j of all the points.
+        /**
+         \param j The index of the coordinate -- \b IN.
+         \return  The values of the coordinate.
+         */
+        Const_Slice column ( int j ) const
+        {
+            return ( _layout == NOMAD::AOS ) ? Const_Slice ( _data + j     , _nb_points , _ld )
+                                             : Const_Slice ( _data + j*_ld , _nb_points , 1   );
+        }
+        Slice column ( int j )
+        {
+            return ( _layout == NOMAD::AOS ) ? Slice ( _data + j     , _nb_points , _ld )
+                                             : Slice ( _data + j*_ld , _nb_points , 1   );
+        }
+
+        /// Copy of the point \c i.
+        /**
+         \param i The index of the point -- \b IN.
+         \return  The point.
+         */
+        NOMAD::Point get_point ( int i ) const { return row ( i ).to_point(); }
+
+        /// Set the point \c i.
+        /**
+         \param i The index of the point -- \b IN.
+         \param p The point, of dimension \c get_dimension() -- \b IN.
+         */
+        void set_point ( int i , const NOMAD::PointView & p );
+
+        /// Add a point at the end.
+        /**
+         The first point added to an empty set of dimension 0 sets the
+         dimension.
+         \param p The point -- \b IN.
+         */
+        void add_point ( const NOMAD::PointView & p );
+
+        /// Reserve space for points.
+        /**
+         A NOMAD::Exception is thrown if the buffer would hold more than
+         \c INT_MAX values.
+         \param capacity The number of points -- \b IN.
+         */
+        void reserve ( int capacity );
+
+        /// Change the number of points.
+        /**
+         The new points are undefined.
+         \param nb_points The number of points -- \b IN.
+         */
+        void resize ( int nb_points );
+
+        /// Change the layout.
+        /**
+         \param layout AOS or SOA -- \b IN.
+         */
+        void set_layout ( NOMAD::storage_layout layout );
+
+        /// Remove all points.
+        void clear ( void ) { resize ( 0 ); }
+
+        /*-------*/
+        /* Norms */
+        /*-------*/
+        /// Norms of all the points.
+        /**
+         \param norms The norms, an array of \c get_nb_points() values -- \b OUT.
+         \param type  The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         */
+        void norms ( NOMAD::Double * norms , NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /// Distances of all the points to one point.
+        /**
+         \param x     The point, of dimension \c get_dimension() -- \b IN.
+         \param dists The distances, an array of \c get_nb_points() values -- \b OUT.
+         \param type  The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         */
+        void dists ( const NOMAD::PointView & x , NOMAD::Double * dists ,
+                     NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /// Distances between the points of two sets.
+        /**
+         The distance \c i is the norm of the vector from the point \c i of
+         \c *this to the point \c i of \c ps, as in NOMAD::Vector::norm().
+         \param ps    The other points, with the same number of points and
+                      the same dimension -- \b IN.
+         \param dists The distances, an array of \c get_nb_points() values -- \b OUT.
+         \param type  The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         */
+        void dists ( const PointSet & ps , NOMAD::Double * dists ,
+                     NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /*---------*/
+        /* Display */
+        /*---------*/
+        /// Display, one point per line.
+        /**
+         \param out The stream -- \b IN/OUT.
+         */
+        void display ( std::ostream & out ) const;
+
+        /// Size of the point set in memory.
+        /**
+         \return Size in memory, in bytes, including the buffer.
+         */
+        int mem_sizeof ( void ) const
+        {
+            return static_cast<int> ( sizeof(PointSet) ) +
+                   buffer_size() * static_cast<int> ( sizeof(NOMAD::Double) );
+        }
+    };
+
+    std::ostream& operator<< (std::ostream& out, const NOMAD::PointSet& ps);
+
+    /// Swap the content of two point sets.
+    inline void swap ( NOMAD::PointSet & ps1 , NOMAD::PointSet & ps2 ) noexcept { ps1.swap ( ps2 ); }
+
+#include "nomad_nsend.hpp"
+#endif
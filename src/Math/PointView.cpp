@@ -0,0 +1,174 @@
+/**
+ \file   PointView.cpp
+ \brief  Non-owning view on the coordinates of a point (implementation)
+ \see    PointView.hpp
+ */
+
+#include <iomanip>
+#include "Math/Compare.hpp"
+#include "Math/Point.hpp"
+#include "Math/PointView.hpp"
+#include "Math/Reduction.hpp"
+
+std::ostream& NOMAD::operator<<(std::ostream& out, const NOMAD::PointView& point)
+{
+    point.display(out);
+    return out;
+}
+
+/*-----------------------------------------------------------*/
+/*                      copy in a point                      */
+/*-----------------------------------------------------------*/
+NOMAD::Point NOMAD::PointView::to_point ( void ) const
+{
+    NOMAD::Point p ( _n );
+    for ( int k = 0 ; k < _n ; ++k )
+        p[k] = _coords[k*_stride];
+    return p;
+}
+
+/*-----------------------------------------------------------*/
+/*                           operator ==                     */
+/*-----------------------------------------------------------*/
+bool NOMAD::PointView::operator == ( const NOMAD::PointView & p ) const
+{
+    if ( p._n != _n )
+        return false;
+    if ( _coords == p._coords && _stride == p._stride )
+        return true;
+
+    const NOMAD::Double * p1 =   _coords;
+    const NOMAD::Double * p2 = p._coords;
+
+    // Contiguous coordinates: vectorized search of the first coordinates
+    // that are not equal, or undefined. NOMAD::Double::operator!=() then
+    // returns true, or throws as the loop below.
+    if ( is_contiguous() && p.is_contiguous() )
+    {
+        int k = NOMAD::Compare::first_not_equal ( p1 , p2 , _n , NOMAD::Double::get_epsilon() );
+        return k == _n || !( p1[k] != p2[k] );
+    }
+
+    for ( int k = 0 ; k < _n ; ++k , p1 += _stride , p2 += p._stride )
+        if ( *p1 != *p2 )
+            return false;
+
+    return true;
+}
+
+/*--------------------------------------------------------------------------*/
+/* comparison operator '<': it is used to find and store the points         */
+/*                           in the cache/database                          */
+/*--------------------------------------------------------------------------*/
+bool NOMAD::PointView::operator < ( const NOMAD::PointView & p ) const
+{
+    if ( _n < p._n )
+        return true;
+    if ( _n > p._n )
+        return false;
+    if ( _coords == p._coords && _stride == p._stride )
+        return false;
+
+    const NOMAD::Double * p1 =   _coords;
+    const NOMAD::Double * p2 = p._coords;
+
+    // Contiguous coordinates: vectorized search of the first coordinates
+    // that are ordered, or NaN. NaN values that are not undefined are
+    // skipped, as in the loop below.
+    if ( is_contiguous() && p.is_contiguous() )
+    {
+        const double eps = NOMAD::Double::get_epsilon();
+        for ( int k = 0 ; k < _n ; ++k )
+        {
+            k += NOMAD::Compare::first_ordered ( p1 + k , p2 + k , _n - k , eps );
+            if ( k == _n )
+                break;
+            if ( p1[k] < p2[k] )
+                return true;
+            if ( p1[k] > p2[k] )
+                return false;
+        }
+        return false;
+    }
+
+    for ( int k = 0 ; k < _n ; ++k , p1 += _stride , p2 += p._stride )
+    {
+
+        if ( *p1 < *p2 )
+            return true;
+
+        if ( *p1 > *p2 )
+            return false;
+    }
+
+    return false;
+}
+
+/*-----------------------------------------------------------*/
+/*                            norms                          */
+/*-----------------------------------------------------------*/
+NOMAD::Double NOMAD::PointView::squared_norm ( void ) const
+{
+    return NOMAD::Reduction::squared_norm ( _coords , _stride , _n );
+}
+
+NOMAD::Double NOMAD::PointView::norm ( NOMAD::hnorm_type type ) const
+{
+    return NOMAD::Reduction::norm ( _coords , _stride , _n , type );
+}
+
+NOMAD::Double NOMAD::PointView::dist ( const NOMAD::PointView & p , NOMAD::hnorm_type type ) const
+{
+    if ( p._n != _n )
+        throw NOMAD::Exception ( "PointView.cpp" , __LINE__ ,
+                                "NOMAD::PointView::dist(): bad dimensions" );
+    return NOMAD::Reduction::dist ( _coords , _stride , p._coords , p._stride , _n , type );
+}
+
+NOMAD::Double NOMAD::PointView::dot_product ( const NOMAD::PointView & p ) const
+{
+    if ( p._n != _n )
+        throw NOMAD::Exception ( "PointView.cpp" , __LINE__ ,
+                                "NOMAD::PointView::dot_product(): bad dimensions" );
+    return NOMAD::Reduction::dot ( _coords , _stride , p._coords , p._stride , _n );
+}
+
+/*-----------------------------------------------------------*/
+/*                             display                       */
+/*-----------------------------------------------------------*/
+void NOMAD::PointView::display ( std::ostream       & out ,
+                                 const std::string  & sep ,
+                                 int                  w   ,
+                                 int                  lim   ) const
+{
+    int nm1 = _n-1;
+
+    // for a limited display of maximum lim elements:
+    if ( lim > 0 && lim < _n )
+    {
+
+        int l1 = (lim + 1) / 2 , l2 = lim / 2 , i;
+
+        // first coordinates:
+        for ( i = 0 ; i < l1 ; ++i )
+            out << std::setw ( w ) << (*this)[i] << sep;
+
+        // separator:
+        out << "..." << sep;
+
+        // last coordinates:
+        for ( i = _n - l2 ; i < nm1 ; ++i )
+            out << std::setw ( w ) << (*this)[i] << sep;
+    }
+
+    // normal display (lim <= 0 or lim >= _n):
+    else
+    {
+        for ( int i = 0 ; i < nm1 ; ++i )
+            out << std::setw ( w ) << (*this)[i] << sep;
+    }
+
+    // last coordinate (different because there is no separator after that):
+    if ( _n > 0 )
+        out << std::setw ( w ) << (*this)[nm1];
+}
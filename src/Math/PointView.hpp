@@ -0,0 +1,161 @@
+/**
+ \file   PointView.hpp
+ \brief  Non-owning view on the coordinates of a point
+ \see    PointView.cpp
+ */
+
+#ifndef __NOMAD400_POINTVIEW__
+#define __NOMAD400_POINTVIEW__
+
+#include "Math/Double.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    class Point;
+
+    /// Class for a view on the coordinates of a point, without copy.
+    /**
+     - A view is a pointer to the first coordinate, a dimension and a
+       stride. It does not own the coordinates, and is invalidated when
+       they are moved or destroyed.
+     - NOMAD::Point, the rows of a NOMAD::PointSet and the records of a
+       point file convert to views for free.
+     - Norms, comparisons and display work directly on the view. With a
+       stride of 1, the coordinates are contiguous, as for a NOMAD::Point.
+    */
+    class PointView {
+    private:
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        const NOMAD::Double * _coords;  // First coordinate
+        int                   _n;       // Dimension
+        int                   _stride;  // Distance between two coordinates
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /// Constructor of an empty view.
+        PointView ( void ) : _coords ( NULL ) , _n ( 0 ) , _stride ( 1 ) {}
+
+        /// Constructor.
+        /**
+         \param coords First coordinate -- \b IN.
+         \param n      Dimension -- \b IN.
+         \param stride Distance between two coordinates
+         -- \b IN -- \b optional (default = 1).
+         */
+        PointView ( const NOMAD::Double * coords , int n , int stride = 1 )
+          : _coords ( ( n > 0 ) ? coords : NULL ) , _n ( ( n > 0 ) ? n : 0 ) , _stride ( stride ) {}
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Const operator \c [].
+        /**
+         \param i The index (0 for the first element) -- \b IN.
+         \return The \c (i+1)th coordinate.
+         */
+        const NOMAD::Double & operator [] ( int i ) const { return _coords[i*_stride]; }
+
+        /// Access to the dimension of the point.
+        int get_size ( void ) const { return _n; }
+
+        /// Access to the distance between two coordinates.
+        int get_stride ( void ) const { return _stride; }
+
+        /// Access to the first coordinate.
+        const NOMAD::Double * data ( void ) const { return _coords; }
+
+        /// Are the coordinates contiguous ?
+        bool is_contiguous ( void ) const { return _stride == 1 || _n <= 1; }
+
+        /// Copy of the coordinates in a point.
+        /**
+         \return A point of dimension \c get_size().
+         */
+        NOMAD::Point to_point ( void ) const;
+
+        /*------------*/
+        /* Comparison */
+        /*------------*/
+        /// Comparison operator \c ==.
+        /**
+         Same as NOMAD::Point::operator==().
+         \param p The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if  \c *this \c == \c p.
+         */
+        bool operator == ( const PointView & p ) const;
+
+        /// Comparison operator \c !=.
+        /**
+         \param p The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if  \c *this \c != \c p.
+         */
+        bool operator != ( const PointView & p ) const { return !(*this == p); }
+
+        /// Comparison operator \c <.
+        /**
+         Same as NOMAD::Point::operator<().
+         \param p The right-hand side object -- \b IN.
+         \return A boolean equal to \c true if  \c *this \c < \c p.
+         */
+        bool operator <  ( const PointView & p ) const;
+
+        /*-------*/
+        /* Norms */
+        /*-------*/
+        /// Squared L2 norm.
+        /**
+         \return The squared L2 norm of the point.
+         */
+        NOMAD::Double squared_norm ( void ) const;
+
+        /// Norm.
+        /**
+         \param type The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         \return The norm of the point.
+         */
+        NOMAD::Double norm ( NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /// Distance to another point.
+        /**
+         \param p    The other point -- \b IN.
+         \param type The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         \return The norm of \c p \c - \c *this.
+         */
+        NOMAD::Double dist ( const PointView & p , NOMAD::hnorm_type type = NOMAD::L2 ) const;
+
+        /// Dot product with another point.
+        /**
+         \param p The other point -- \b IN.
+         \return The dot product of \c *this and \c p.
+         */
+        NOMAD::Double dot_product ( const PointView & p ) const;
+
+        /*---------*/
+        /* Display */
+        /*---------*/
+        /// Display.
+        /**
+         \param out The stream -- \b IN/OUT.
+         \param sep A string that is used as a separator between the coordinates
+         -- \b IN --\b optional (default = one space).
+         \param w   An integer indicating a width for the display of
+         each coordinate -- \b IN -- \b optional
+         (default = -1, no limit).
+         \param lim Max number of coordinates to display -- \b IN
+         -- \b optional (default = -1, no limit).
+         */
+        void display ( std::ostream       & out       ,
+                       const std::string  & sep = " " ,
+                       int                  w   = -1  ,
+                       int                  lim = -1    ) const;
+    };
+
+    std::ostream& operator<< (std::ostream& out, const NOMAD::PointView& point);
+
+#include "nomad_nsend.hpp"
+#endif
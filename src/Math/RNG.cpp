@@ -7,58 +7,368 @@
  */
 
 #include "Math/RNG.hpp"
+#include <algorithm>
+#include <cstring>
 #include <math.h>
 
-//** Default values for the provided number seed  */
-int NOMAD::RNG::_s = 0;
+namespace {
 
+    // State of xorshift96, as a vector of 96 bits over GF(2).
+    struct State {
+        uint32_t x, y, z;
+    };
 
-uint32_t NOMAD::RNG::x_def = 123456789;
-uint32_t NOMAD::RNG::y_def = 362436069;
-uint32_t NOMAD::RNG::z_def = 521288629;
-uint32_t NOMAD::RNG::_x = x_def;
-uint32_t NOMAD::RNG::_y = y_def;
-uint32_t NOMAD::RNG::_z = z_def;
+    // One draw: the state is multiplied by the transition matrix.
+    inline void xorshift96 ( uint32_t & x , uint32_t & y , uint32_t & z )
+    {
+        uint32_t t;
+        x ^= x << 16;
+        x ^= x >> 5;
+        x ^= x << 1;
 
+        t = x;
+        x = y;
+        y = z;
+        z = t ^ x ^ y;
+    }
 
-void NOMAD::RNG::set_seed(int s)
+    // Matrix over GF(2), by columns: column i is the image of bit i of the
+    // state (bits 0-31 of x, 32-63 of y, 64-95 of z).
+    struct Matrix {
+        State col[96];
+
+        State operator * ( const State & s ) const
+        {
+            State r = { 0 , 0 , 0 };
+            const uint32_t w[3] = { s.x , s.y , s.z };
+            for ( int i = 0 ; i < 96 ; ++i )
+                if ( ( w[i/32] >> ( i % 32 ) ) & 1 )
+                {
+                    r.x ^= col[i].x;
+                    r.y ^= col[i].y;
+                    r.z ^= col[i].z;
+                }
+            return r;
+        }
+    };
+
+    // Transition matrix to the power 2^j, for j=0..95.
+    struct Powers {
+        Matrix pow2[96];
+
+        Powers ( void )
+        {
+            for ( int i = 0 ; i < 96 ; ++i )
+            {
+                State & c = pow2[0].col[i];
+                c.x = ( i <  32 ) ? 1U << i : 0;
+                c.y = ( i >= 32 && i < 64 ) ? 1U << ( i - 32 ) : 0;
+                c.z = ( i >= 64 ) ? 1U << ( i - 64 ) : 0;
+                xorshift96 ( c.x , c.y , c.z );
+            }
+            for ( int j = 1 ; j < 96 ; ++j )
+                for ( int i = 0 ; i < 96 ; ++i )
+                    pow2[j].col[i] = pow2[j-1] * pow2[j-1].col[i];
+        }
+    };
+
+    // Built once, on the first jump (thread-safe initialization).
+    const Powers & powers ( void )
+    {
+        static const Powers p;
+        return p;
+    }
+
+    // splitmix64
+    inline uint64_t splitmix64 ( uint64_t & s )
+    {
+        return NOMAD::mix ( s += 0x9E3779B97F4A7C15ULL );
+    }
+
+    /*----------------------------------------*/
+    /*              bulk draws                */
+    /*----------------------------------------*/
+    // Interleaved xorshift96 generators: the lanes are independent, and the
+    // loop over the lanes vectorizes. Draws are made by blocks. One more
+    // generator gives the draws of the rejections of the ziggurat.
+    class Lanes {
+    public:
+        static const int NB_LANES = 8;
+        static const int BLOCK    = 32 * NB_LANES;
+
+    private:
+        uint32_t _x[NB_LANES+1], _y[NB_LANES+1], _z[NB_LANES+1];
+        uint32_t _buffer[BLOCK];
+
+    public:
+        explicit Lanes ( uint64_t seed )
+        {
+            for ( int l = 0 ; l <= NB_LANES ; ++l )
+                do
+                {
+                    uint64_t a = splitmix64 ( seed );
+                    uint64_t b = splitmix64 ( seed );
+                    _x[l] = static_cast<uint32_t> ( a );
+                    _y[l] = static_cast<uint32_t> ( a >> 32 );
+                    _z[l] = static_cast<uint32_t> ( b );
+                } while ( _x[l] == 0 && _y[l] == 0 && _z[l] == 0 );
+        }
+
+        // Next BLOCK draws
+        const uint32_t * block ( void )
+        {
+            for ( int k = 0 ; k < BLOCK ; k += NB_LANES )
+                for ( int l = 0 ; l < NB_LANES ; ++l )
+                {
+                    uint32_t x = _x[l];
+                    x ^= x << 16;
+                    x ^= x >> 5;
+                    x ^= x << 1;
+                    _x[l] = _y[l];
+                    _y[l] = _z[l];
+                    _z[l] = x ^ _x[l] ^ _y[l];
+                    _buffer[k+l] = _z[l];
+                }
+            return _buffer;
+        }
+
+        // One draw of the last generator
+        uint32_t next ( void )
+        {
+            xorshift96 ( _x[NB_LANES] , _y[NB_LANES] , _z[NB_LANES] );
+            return _z[NB_LANES];
+        }
+
+        // Uniform in (0,1), from the last generator
+        double uniform ( void )
+        {
+            return ( next() + 0.5 ) * ( 1.0 / 4294967296.0 );
+        }
+    };
+
+    // Tables of the ziggurat with 128 layers of equal area, for the half
+    // normal density f(x)=exp(-x^2/2) (Marsaglia and Tsang, 2000), scaled
+    // for draws of 32 bits.
+    struct Ziggurat {
+        static const int NB_LAYERS = 128;
+        uint32_t k[NB_LAYERS];  // Limits of the fast path
+        double   w[NB_LAYERS];  // Width of the layers, over 2^32
+        double   f[NB_LAYERS];  // Density at the right of the layers
+
+        Ziggurat ( void )
+        {
+            const double m  = 4294967296.0;
+            const double vn = 9.91256303526217e-3;
+            double       dn = 3.442619855899;
+            double       tn = dn;
+            const double q  = vn / exp ( -0.5 * dn * dn );
+
+            k[0] = static_cast<uint32_t> ( ( dn / q ) * m );
+            k[1] = 0;
+            w[0] = q / m;
+            w[NB_LAYERS-1] = dn / m;
+            f[0] = 1.0;
+            f[NB_LAYERS-1] = exp ( -0.5 * dn * dn );
+            for ( int i = NB_LAYERS - 2 ; i >= 1 ; --i )
+            {
+                dn     = sqrt ( -2.0 * log ( vn / dn + exp ( -0.5 * dn * dn ) ) );
+                k[i+1] = static_cast<uint32_t> ( ( dn / tn ) * m );
+                tn     = dn;
+                f[i]   = exp ( -0.5 * dn * dn );
+                w[i]   = dn / m;
+            }
+        }
+    };
+
+    const Ziggurat & ziggurat ( void )
+    {
+        static const Ziggurat z;
+        return z;
+    }
+
+    // Standard normal variate. The layer and the sign come from one draw,
+    // the abscissa from another one. The fast path, without rejection, has
+    // a probability of 0.988.
+    inline double normal ( Lanes & lanes , const Ziggurat & z , uint32_t u , uint32_t v )
+    {
+        const double r = 3.442619855899;  // Start of the tail
+        for ( ;; )
+        {
+            const int    i    = u & ( Ziggurat::NB_LAYERS - 1 );
+            const double sign = ( u & Ziggurat::NB_LAYERS ) ? -1.0 : 1.0;
+            if ( v < z.k[i] )
+                return sign * v * z.w[i];
+
+            double x;
+            if ( i == 0 )
+            {
+                // Tail: x>r with density exp(-x^2/2)
+                double y;
+                do
+                {
+                    x = -log ( lanes.uniform() ) / r;
+                    y = -log ( lanes.uniform() );
+                } while ( y + y < x * x );
+                return sign * ( r + x );
+            }
+            // Wedge
+            x = v * z.w[i];
+            if ( z.f[i] + lanes.uniform() * ( z.f[i-1] - z.f[i] ) < exp ( -0.5 * x * x ) )
+                return sign * x;
+            u = lanes.next();
+            v = lanes.next();
+        }
+    }
+
+    // Values of type double or NOMAD::Double
+    template < typename T >
+    void uniform ( Lanes & lanes , T * v , int nb , double a , double b )
+    {
+        const double scale = ( b - a ) / UINT32_MAX;
+        for ( int i = 0 ; i < nb ; i += Lanes::BLOCK )
+        {
+            const uint32_t * u = lanes.block();
+            const int        m = std::min ( nb - i , static_cast<int> ( Lanes::BLOCK ) );
+            for ( int j = 0 ; j < m ; ++j )
+            {
+                // Exact conversion of u[j] to double, without the scalar
+                // conversion of unsigned integers: 2^52+u[j] minus 2^52
+                double         d;
+                const uint64_t bits = 0x4330000000000000ULL | u[j];
+                std::memcpy ( &d , &bits , sizeof ( d ) );
+                v[i+j] = a + scale * ( d - 4503599627370496.0 );
+            }
+        }
+    }
+
+    template < typename T >
+    void normal ( Lanes & lanes , T * v , int nb , double mean , double sigma )
+    {
+        const Ziggurat & z = ziggurat();
+        for ( int i = 0 ; i < nb ; i += Lanes::BLOCK / 2 )
+        {
+            const uint32_t * u = lanes.block();
+            const int        m = std::min ( nb - i , static_cast<int> ( Lanes::BLOCK / 2 ) );
+            for ( int j = 0 ; j < m ; ++j )
+            {
+                const uint32_t l = u[2*j] & ( Ziggurat::NB_LAYERS - 1 );
+                double         x;
+                if ( u[2*j+1] < z.k[l] )
+                    x = ( ( u[2*j] & Ziggurat::NB_LAYERS ) ? -1.0 : 1.0 ) * u[2*j+1] * z.w[l];
+                else
+                    x = normal ( lanes , z , u[2*j] , u[2*j+1] );
+                v[i+j] = mean + sigma * x;
+            }
+        }
+    }
+
+    // Contiguous rows (AOS) or columns (SOA) of a set of points
+    template < typename F >
+    void for_each_segment ( NOMAD::PointSet & points , F fill )
+    {
+        if ( points.get_layout() == NOMAD::AOS )
+            for ( int i = 0 ; i < points.get_nb_points() ; ++i )
+                fill ( points.row ( i ).data() , points.get_dimension() );
+        else
+            for ( int j = 0 ; j < points.get_dimension() ; ++j )
+                fill ( points.column ( j ).data() , points.get_nb_points() );
+    }
+}
+
+const uint32_t NOMAD::RandomGenerator::X_DEF;
+const uint32_t NOMAD::RandomGenerator::Y_DEF;
+const uint32_t NOMAD::RandomGenerator::Z_DEF;
+
+NOMAD::RandomGenerator NOMAD::RNG::_rng;
+bool NOMAD::RNG::_compatibility = false;
+
+
+/*----------------------------------------*/
+/*                  seeds                 */
+/*----------------------------------------*/
+NOMAD::RandomGenerator::RandomGenerator ( int s , bool compatibility )
+  : _x(X_DEF) , _y(Y_DEF) , _z(Z_DEF) , _s(0)
+{
+    set_seed ( s , compatibility );
+}
+
+void NOMAD::RandomGenerator::set_seed ( int s , bool compatibility )
 {
-    
     if( s<=INT_MAX && s>=0 )
         _s=s;
     else
         throw NOMAD::Exception ( "RNG.cpp" , __LINE__ ,
-                                "NOMAD::RNG::set_seed(): invalid seed. Seed should be in [0,INT_MAX]" );
-    
-    reset_private_seed_to_default();
-    for ( int i=0 ; i<_s ; i++)
-        NOMAD::RNG::rand();
+                                "NOMAD::RandomGenerator::set_seed(): invalid seed. Seed should be in [0,INT_MAX]" );
     
+    reset_to_default();
+    if ( compatibility )
+    {
+        // Previous versions: s draws from the default state
+        jump ( static_cast<uint64_t>(_s) );
+        return;
+    }
     
+    // The state must not be zero
+    uint64_t sm = static_cast<uint64_t>(_s);
+    do
+    {
+        uint64_t a = splitmix64 ( sm );
+        uint64_t b = splitmix64 ( sm );
+        _x = static_cast<uint32_t>( a );
+        _y = static_cast<uint32_t>( a >> 32 );
+        _z = static_cast<uint32_t>( b );
+    } while ( _x == 0 && _y == 0 && _z == 0 );
 }
 
-uint32_t NOMAD::RNG::rand ( void )
+void NOMAD::RNG::set_seed(int s)
 {
-    // http://madrabbit.org/~ray/code/xorshf96.c //period 2^96-1
-    
-    uint32_t t;
-    _x ^= _x << 16;
-    _x ^= _x >> 5;
-    _x ^= _x << 1;
-    
-    t = _x;
-    _x = _y;
-    _y = _z;
-    _z = t ^ _x ^ _y;
+    _rng.set_seed ( s , _compatibility );
+}
+
+
+/*----------------------------------------*/
+/*               jump ahead               */
+/*----------------------------------------*/
+void NOMAD::RandomGenerator::jump ( uint64_t nb_draws )
+{
+    // Few draws are faster one by one
+    if ( nb_draws < 256 )
+    {
+        for ( uint64_t i = 0 ; i < nb_draws ; ++i )
+            rand();
+        return;
+    }
     
-    return _z;
+    const Powers & p = powers();
+    State s = { _x , _y , _z };
+    for ( int j = 0 ; nb_draws ; ++j , nb_draws >>= 1 )
+        if ( nb_draws & 1 )
+            s = p.pow2[j] * s;
+    _x = s.x;
+    _y = s.y;
+    _z = s.z;
+}
+
+NOMAD::RandomGenerator NOMAD::RandomGenerator::substream ( uint32_t k ) const
+{
+    // k*2^64 draws
+    const Powers & p = powers();
+    NOMAD::RandomGenerator g ( *this );
+    State s = { _x , _y , _z };
+    for ( int j = 64 ; k ; ++j , k >>= 1 )
+        if ( k & 1 )
+            s = p.pow2[j] * s;
+    g._x = s.x;
+    g._y = s.y;
+    g._z = s.z;
+    return g;
 }
 
 
 /*----------------------------------------*/
 /*          normal random generators       */
 /*----------------------------------------*/
-double NOMAD::RNG::normal_rand( double mean , double var )
+double NOMAD::RandomGenerator::normal_rand( double mean , double var )
 {
     // Box-Muller transformation~\cite{BoMu58}
     
@@ -66,8 +376,8 @@ double NOMAD::RNG::normal_rand( double mean , double var )
     
     do
     {
-        x1 = NOMAD::RNG::rand(-1.0,1.0);
-        x2 = NOMAD::RNG::rand(-1.0,1.0);
+        x1 = rand(-1.0,1.0);
+        x2 = rand(-1.0,1.0);
         w  = x1 * x1 + x2 * x2;
     } while ( w >= 1.0 );
     
@@ -75,11 +385,51 @@ double NOMAD::RNG::normal_rand( double mean , double var )
     
     return pow ( var,0.5) * x1 * w + mean;
 }
-double NOMAD::RNG::normal_rand_mean_0 ( double Var , int Nsample )
+double NOMAD::RandomGenerator::normal_rand_mean_0 ( double Var , int Nsample )
 {
     double sum = 0.0;
     double a=pow( 3.0*Var,0.5 );
     for ( int i=0 ; i<Nsample ; i++ )
-        sum+=NOMAD::RNG::rand(-a,a);
+        sum+=rand(-a,a);
     return sum / pow( Nsample,0.5 );
 }
+
+
+/*----------------------------------------*/
+/*               bulk fills               */
+/*----------------------------------------*/
+namespace {
+
+    // Seed of the lanes of a bulk fill: two draws, the high bits first.
+    uint64_t lanes_seed ( NOMAD::RandomGenerator & rng )
+    {
+        uint64_t hi = rng.rand();
+        uint64_t lo = rng.rand();
+        return ( hi << 32 ) | lo;
+    }
+}
+
+void NOMAD::RandomGenerator::fill_uniform ( double * v , int nb , double a , double b )
+{
+    Lanes lanes ( lanes_seed ( *this ) );
+    uniform ( lanes , v , nb , a , b );
+}
+
+void NOMAD::RandomGenerator::fill_uniform ( NOMAD::PointSet & points , double a , double b )
+{
+    Lanes lanes ( lanes_seed ( *this ) );
+    for_each_segment ( points , [&]( NOMAD::Double * v , int nb ) { uniform ( lanes , v , nb , a , b ); } );
+}
+
+void NOMAD::RandomGenerator::fill_normal ( double * v , int nb , double mean , double var )
+{
+    Lanes lanes ( lanes_seed ( *this ) );
+    normal ( lanes , v , nb , mean , sqrt ( var ) );
+}
+
+void NOMAD::RandomGenerator::fill_normal ( NOMAD::PointSet & points , double mean , double var )
+{
+    Lanes lanes ( lanes_seed ( *this ) );
+    const double sigma = sqrt ( var );
+    for_each_segment ( points , [&]( NOMAD::Double * v , int nb ) { normal ( lanes , v , nb , mean , sigma ); } );
+}
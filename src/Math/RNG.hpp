@@ -9,6 +9,7 @@
 #ifndef __NOMAD400_RNG__
 #define __NOMAD400_RNG__
 
+#include "Math/PointSet.hpp"
 #include "Util/defines.hpp"
 #include "Util/Exception.hpp"
 
@@ -17,10 +18,175 @@ using namespace std;
 #include "nomad_nsbegin.hpp"
 
     
+    /// Class for a random number generator object
+	/**
+     Value type with the generator of NOMAD::RNG: each thread or algorithm
+     owns its generator, without data race.
+     - The generator is xorshift96, linear over GF(2), with a period of
+       2^96-1.
+     - set_seed() maps the seed to a state with the splitmix64 mixing
+       function, in O(1). In compatibility mode, set_seed(s) gives the
+       state of the previous versions, the default state advanced by \c s
+       draws, in O(log(s)).
+     - Stream splitting: substream(k) is the generator advanced by
+       \c k*2^64 draws, in O(log(k)). The substreams of one master seed
+       do not overlap before 2^64 draws each.
+     - Bulk fills: fill_uniform() and fill_normal() draw from 8
+       interleaved xorshift96 generators, seeded by two draws of this
+       generator, so that the loops vectorize. The normal variates use
+       the ziggurat method (Marsaglia and Tsang, 2000).
+	 */
+	class RandomGenerator {
+		
+	public:
+        
+        /// Default state
+        static const uint32_t X_DEF = 123456789;
+        static const uint32_t Y_DEF = 362436069;
+        static const uint32_t Z_DEF = 521288629;
+        
+		/// Constructor, with the default state and the seed 0
+        RandomGenerator ( void ) : _x(X_DEF) , _y(Y_DEF) , _z(Z_DEF) , _s(0) {}
+        
+		/// Constructor, with a seed
+		/*
+		 /param s             The seed, in [0,INT_MAX] -- \b IN.
+		 /param compatibility Sequence of the previous versions -- \b IN -- \b optional (default = false).
+		 */
+        explicit RandomGenerator ( int s , bool compatibility = false );
+        
+ 		/// Get current seed
+        int get_seed ( void ) const { return _s; }
+        
+		/// Set seed
+		/*  O(1), or O(log(s)) in compatibility mode.
+		 /param s             The seed, in [0,INT_MAX] -- \b IN.
+		 /param compatibility Sequence of the previous versions -- \b IN -- \b optional (default = false).
+		 */
+		void set_seed ( int s , bool compatibility = false );
+        
+        /// Reset the state to its default value, without changing the seed
+        void reset_to_default ( void )
+        {
+            _x=X_DEF;
+            _y=Y_DEF;
+            _z=Z_DEF;
+        }
+        
+		/// Advance the generator by a number of draws
+		/** Same state as \c nb_draws calls to rand(), in O(log(nb_draws)):
+		 the state is multiplied by the powers of two of the transition
+		 matrix of the generator over GF(2).
+		 /param nb_draws The number of draws -- \b IN.
+		 */
+		void jump ( uint64_t nb_draws );
+        
+		/// Get a substream
+		/*
+		 /param k The index of the substream -- \b IN.
+		 /return A copy of the generator advanced by \c k*2^64 draws.
+		 */
+		RandomGenerator substream ( uint32_t k ) const;
+        
+		/// Get a random integer as uint32
+		/*
+		 /return An integer in the interval [0,UINT32_MAX].
+		 */
+		uint32_t rand ( void )
+        {
+            // http://madrabbit.org/~ray/code/xorshf96.c
+            uint32_t t;
+            _x ^= _x << 16;
+            _x ^= _x >> 5;
+            _x ^= _x << 1;
+            
+            t = _x;
+            _x = _y;
+            _y = _z;
+            _z = t ^ _x ^ _y;
+            
+            return _z;
+        }
+        
+		/// Get a random number uniformly distributed as double
+		/*
+         /param a Lower bound  -- \b IN.
+         /param b Upper bound  -- \b IN.
+         /return A double in the interval [a,b].
+		 */
+		double rand ( double a , double b )
+        {
+            return a+((b-a)*rand())/UINT32_MAX;
+        }
+        
+		/// Get a random number approaching a normal distribution (N(0,Var)) as double
+		/*  Average of Nsample uniform random numbers (central limit theorem).
+         /param Var		Variance of the target normal distribution	-- \b IN.
+         /param Nsample	Number of samples for averaging				-- \b IN.
+         /return A double in the interval [-sqrt(3*Var*Nsample);+sqrt(3*Var*Nsample)].
+		 */
+		double normal_rand_mean_0 ( double Var=1 , int Nsample=12 );
+        
+        /// Get a random number with a normal distribution ( N(Mean,Var) ) as double
+		/*
+         /param Mean	Mean of the target normal distribution		-- \b IN.
+         /param Var		Variance of the target normal distribution	-- \b IN.
+         /return A random number.
+		 */
+        double normal_rand ( double Mean=0 , double Var=1 );
+        
+		/// Fill an array with random numbers uniformly distributed
+		/*  Same distribution as rand(a,b). Two draws of the generator.
+         /param v  The array -- \b OUT.
+         /param nb The number of values -- \b IN.
+         /param a  Lower bound -- \b IN.
+         /param b  Upper bound -- \b IN.
+		 */
+		void fill_uniform ( double * v , int nb , double a , double b );
+        
+		/// Fill a set of points with random numbers uniformly distributed
+		/*
+         /param points The points -- \b OUT.
+         /param a      Lower bound -- \b IN.
+         /param b      Upper bound -- \b IN.
+		 */
+		void fill_uniform ( NOMAD::PointSet & points , double a , double b );
+        
+		/// Fill an array with random numbers with a normal distribution ( N(Mean,Var) )
+		/*  Two draws of the generator.
+         /param v    The array -- \b OUT.
+         /param nb   The number of values -- \b IN.
+         /param Mean Mean of the target normal distribution -- \b IN.
+         /param Var  Variance of the target normal distribution -- \b IN.
+		 */
+		void fill_normal ( double * v , int nb , double Mean=0 , double Var=1 );
+        
+		/// Fill a set of points with random numbers with a normal distribution ( N(Mean,Var) )
+		/*
+         /param points The points -- \b OUT.
+         /param Mean   Mean of the target normal distribution -- \b IN.
+         /param Var    Variance of the target normal distribution -- \b IN.
+		 */
+		void fill_normal ( NOMAD::PointSet & points , double Mean=0 , double Var=1 );
+        
+	private:
+        
+        uint32_t _x,_y,_z;  ///< State of the generator.
+        
+        int _s;             ///< Seed.
+        
+	};
+    
+    
     /// Class for random number generator
 	/**
      This class is used to set a seed for the random number generator and
      get a random integer or a random double between two values.
+     - Thin wrapper of a global NOMAD::RandomGenerator: not thread-safe.
+       Threads and algorithms that draw in parallel should own a
+       NOMAD::RandomGenerator, for example a substream() of get_generator().
+     - Compatibility mode: set_seed(s) gives the sequences of the previous
+       versions.
 	 */
 	class RNG {
 		
@@ -33,21 +199,62 @@ using namespace std;
 		 */
         static int get_seed ( void )
         {
-            return static_cast<int>(_s);
+            return _rng.get_seed();
         }
         
 		/// Set seed
-		/*
-		 /param s The seed -- \b IN.
+		/*  O(1), or O(log(s)) in compatibility mode.
+		 /param s The seed, in [0,INT_MAX] -- \b IN.
 		 */
 		static void set_seed(int s);
     
 		
+		/// Set the compatibility mode of set_seed()
+		/*
+		 /param compatibility Seeds give the sequences of the previous versions -- \b IN.
+		 */
+		static void set_compatibility_mode ( bool compatibility )
+        {
+            _compatibility = compatibility;
+        }
+
+		/// Get the compatibility mode of set_seed()
+		/*
+		 /return A boolean equal to \c true if seeds give the sequences of the previous versions.
+		 */
+		static bool get_compatibility_mode ( void )
+        {
+            return _compatibility;
+        }
+
+		/// Advance the generator by a number of draws
+		/** Same state as \c nb_draws calls to rand(), in O(log(nb_draws)):
+		 the state is multiplied by the powers of two of the transition
+		 matrix of the generator over GF(2).
+		 /param nb_draws The number of draws -- \b IN.
+		 */
+		static void jump ( uint64_t nb_draws )
+        {
+            _rng.jump ( nb_draws );
+        }
+        
+		/// Get the global generator
+		/*
+		 /return The generator used by the static functions.
+		 */
+        static NOMAD::RandomGenerator & get_generator ( void )
+        {
+            return _rng;
+        }
+
 		/// Get a random integer as uint32
 		/** This function serves to obtain a random number \c
 		 /return An integer in the interval [0,UINT32_MAX].
 		 */
-		static uint32_t rand();
+		static uint32_t rand()
+        {
+            return _rng.rand();
+        }
         
 		
 		/// Get a random number having a normal distribution as double
@@ -58,7 +265,7 @@ using namespace std;
 		 */
 		static double rand(double a, double b)
         {
-            return a+((b-a)*NOMAD::RNG::rand())/UINT32_MAX;
+            return _rng.rand(a,b);
         }
 		
 		/// Get a random number approaching a normal distribution (N(0,Var)) as double
@@ -69,7 +276,10 @@ using namespace std;
          /param Var		Variance of the target normal distribution	-- \b IN.
          /return A double in the interval [-sqrt(3*Var);+sqrt(3*Var)].
 		 */
-		static double normal_rand_mean_0( double Var=1 , int Nsample=12 ) ;
+		static double normal_rand_mean_0( double Var=1 , int Nsample=12 )
+        {
+            return _rng.normal_rand_mean_0(Var,Nsample);
+        }
         
         
         /// Get a random number approaching a normal distribution ( N(Mean,Var) ) as double
@@ -78,23 +288,70 @@ using namespace std;
          /param Var		Variance of the target normal distribution	-- \b IN.
          /return A random number.
 		 */
-        static double normal_rand( double Mean=0 , double Var=1 ) ;
+        static double normal_rand( double Mean=0 , double Var=1 )
+        {
+            return _rng.normal_rand(Mean,Var);
+        }
+        
+        /// Fill an array with random numbers uniformly distributed
+		/*
+         /param v  The array -- \b OUT.
+         /param nb The number of values -- \b IN.
+         /param a  Lower bound -- \b IN.
+         /param b  Upper bound -- \b IN.
+		 */
+        static void fill_uniform ( double * v , int nb , double a , double b )
+        {
+            _rng.fill_uniform(v,nb,a,b);
+        }
+        
+        /// Fill a set of points with random numbers uniformly distributed
+		/*
+         /param points The points -- \b OUT.
+         /param a      Lower bound -- \b IN.
+         /param b      Upper bound -- \b IN.
+		 */
+        static void fill_uniform ( NOMAD::PointSet & points , double a , double b )
+        {
+            _rng.fill_uniform(points,a,b);
+        }
+        
+        /// Fill an array with random numbers with a normal distribution ( N(Mean,Var) )
+		/*
+         /param v    The array -- \b OUT.
+         /param nb   The number of values -- \b IN.
+         /param Mean Mean of the target normal distribution -- \b IN.
+         /param Var  Variance of the target normal distribution -- \b IN.
+		 */
+        static void fill_normal ( double * v , int nb , double Mean=0 , double Var=1 )
+        {
+            _rng.fill_normal(v,nb,Mean,Var);
+        }
+        
+        /// Fill a set of points with random numbers with a normal distribution ( N(Mean,Var) )
+		/*
+         /param points The points -- \b OUT.
+         /param Mean   Mean of the target normal distribution -- \b IN.
+         /param Var    Variance of the target normal distribution -- \b IN.
+		 */
+        static void fill_normal ( NOMAD::PointSet & points , double Mean=0 , double Var=1 )
+        {
+            _rng.fill_normal(points,Mean,Var);
+        }
         
         /// Reset seed to its default value
         static void reset_private_seed_to_default ( void )
         {
-            _x=x_def;
-            _y=y_def;
-            _z=z_def;
+            _rng.reset_to_default();
         }
 
         
         
 	private:
         
-        static uint32_t x_def,y_def,z_def,_x,_y,_z;  ///< Default parameter value for the random number generator (_s used as the seed).
+        static NOMAD::RandomGenerator _rng;  ///< Global generator.
         
-        static int _s;
+        static bool _compatibility;  ///< Seeds give the sequences of the previous versions.
         
 
 	};
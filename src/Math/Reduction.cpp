@@ -0,0 +1,291 @@
+/**
+ \file   Reduction.cpp
+ \brief  Sums and norms of arrays of reals (implementation)
+ \see    Reduction.hpp
+ */
+#include "Math/Reduction.hpp"
+
+const int NOMAD::Reduction::BLOCK_SIZE;
+const int NOMAD::Reduction::NB_ACCUMULATORS;
+
+/*-----------------------------------------------------------*/
+/*                        kernels                            */
+/*-----------------------------------------------------------*/
+// The kernels work on the raw values of the NOMAD::Double, including the
+// undefined values, which are NaN and propagate to the result.
+namespace {
+
+    // Access to the values: contiguous, or with a stride.
+    struct Unit
+    {
+        static double get ( const double * x , int     , int i ) { return x[i]; }
+    };
+    struct Strided
+    {
+        static double get ( const double * x , int inc , int i ) { return x[i*inc]; }
+    };
+
+    // Terms of the sums. The unary terms ignore y.
+    struct Value
+    {
+        static double term ( double x , double ) { return x; }
+    };
+    struct Abs
+    {
+        static double term ( double x , double ) { return std::fabs ( x ); }
+    };
+    struct Square
+    {
+        static double term ( double x , double ) { return x * x; }
+    };
+    struct Product
+    {
+        static double term ( double x , double y ) { return x * y; }
+    };
+    struct Diff_Abs
+    {
+        static double term ( double x , double y ) { return std::fabs ( y - x ); }
+    };
+    struct Diff_Square
+    {
+        static double term ( double x , double y )
+        {
+            double d = y - x;
+            return d * d;
+        }
+    };
+
+    // Pairwise sum of the terms.
+    template < typename T , typename A >
+    double pairwise_sum ( const double * x , int incx , const double * y , int incy , int n )
+    {
+        if ( n > NOMAD::Reduction::BLOCK_SIZE )
+        {
+            int half = n / 2;
+            return pairwise_sum<T,A> ( x , incx , y , incy , half ) +
+                   pairwise_sum<T,A> ( x + half*incx , incx , y + half*incy , incy , n - half );
+        }
+
+        // One block, with NB_ACCUMULATORS independent sums.
+        const int nb = NOMAD::Reduction::NB_ACCUMULATORS;
+        double s[nb];
+        for ( int k = 0 ; k < nb ; ++k )
+            s[k] = 0.0;
+        int i = 0;
+        for ( ; i + nb - 1 < n ; i += nb )
+            for ( int k = 0 ; k < nb ; ++k )
+                s[k] += T::term ( A::get ( x , incx , i+k ) , A::get ( y , incy , i+k ) );
+        for ( ; i < n ; ++i )
+            s[0] += T::term ( A::get ( x , incx , i ) , A::get ( y , incy , i ) );
+
+        // Pairwise sum of the accumulators: ( s0 + s2 ) + ( s1 + s3 ) for 4.
+        for ( int w = nb / 2 ; w > 0 ; w /= 2 )
+            for ( int k = 0 ; k < w ; ++k )
+                s[k] += s[k+w];
+        return s[0];
+    }
+
+    // Max of the terms. NaN terms are ignored by the comparisons, and
+    // reported in nan.
+    template < typename T , typename A >
+    double max_term ( const double * x , int incx , const double * y , int incy , int n , bool & nan )
+    {
+        double m0 = 0.0 , m1 = 0.0;
+        int    n0 = 0   , n1 = 0;
+        int i = 0;
+        for ( ; i + 1 < n ; i += 2 )
+        {
+            double t0 = T::term ( A::get ( x , incx , i   ) , A::get ( y , incy , i   ) );
+            double t1 = T::term ( A::get ( x , incx , i+1 ) , A::get ( y , incy , i+1 ) );
+            m0 = ( t0 > m0 ) ? t0 : m0;
+            m1 = ( t1 > m1 ) ? t1 : m1;
+            n0 |= ( t0 != t0 );
+            n1 |= ( t1 != t1 );
+        }
+        for ( ; i < n ; ++i )
+        {
+            double t0 = T::term ( A::get ( x , incx , i ) , A::get ( y , incy , i ) );
+            m0 = ( t0 > m0 ) ? t0 : m0;
+            n0 |= ( t0 != t0 );
+        }
+        nan = ( n0 | n1 ) != 0;
+        return ( m0 > m1 ) ? m0 : m1;
+    }
+
+    // Sum and max of the terms, with the contiguous kernels when possible.
+    // For the unary terms, y is x.
+    template < typename T >
+    double sum_terms ( const double * x , int incx , const double * y , int incy , int n )
+    {
+        return ( incx == 1 && incy == 1 ) ? pairwise_sum<T,Unit>    ( x , incx , y , incy , n )
+                                          : pairwise_sum<T,Strided> ( x , incx , y , incy , n );
+    }
+
+    template < typename T >
+    double max_terms ( const double * x , int incx , const double * y , int incy , int n )
+    {
+        bool nan;
+        double r = ( incx == 1 && incy == 1 ) ? max_term<T,Unit>    ( x , incx , y , incy , n , nan )
+                                              : max_term<T,Strided> ( x , incx , y , incy , n , nan );
+        return ( nan ) ? NOMAD::NaN : r;
+    }
+
+    // Raw values of an array of NOMAD::Double.
+    inline const double * raw ( const NOMAD::Double * x )
+    {
+        return reinterpret_cast<const double *> ( x );
+    }
+
+    // Is one of the values undefined ?
+    bool has_undef ( const double * x , int incx , int n )
+    {
+        if ( !x )
+            return false;
+        for ( int i = 0 ; i < n ; ++i )
+            if ( NOMAD::Double::is_undef_value ( x[i*incx] ) )
+                return true;
+        return false;
+    }
+
+    // Result of a reduction: a NaN result is checked for undefined arguments.
+    NOMAD::Double result ( double r , const double * x , int incx , const double * y , int incy , int n )
+    {
+        if ( r != r && ( has_undef ( x , incx , n ) || has_undef ( y , incy , n ) ) )
+        {
+#ifdef UNCHECKED_DOUBLE
+            return NOMAD::Double();
+#else
+            throw NOMAD::Double::Not_Defined ( "Reduction.cpp" , __LINE__ ,
+                                               "NOMAD::Reduction: value not defined" );
+#endif
+        }
+        return r;
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*                           sums                            */
+/*-----------------------------------------------------------*/
+NOMAD::Double NOMAD::Reduction::sum ( const NOMAD::Double * x , int n )
+{
+    const double * v = raw ( x );
+    return result ( sum_terms<Value> ( v , 1 , v , 1 , n ) , v , 1 , NULL , 0 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::sum_compensated ( const NOMAD::Double * x , int n )
+{
+    const double * v = raw ( x );
+
+    // Neumaier compensation, on 2 independent sums.
+    double s[2] = { 0.0 , 0.0 };
+    double c[2] = { 0.0 , 0.0 };
+    for ( int i = 0 ; i < n ; ++i )
+    {
+        int    k = i & 1;
+        double t = s[k] + v[i];
+        if ( std::fabs ( s[k] ) >= std::fabs ( v[i] ) )
+            c[k] += ( s[k] - t ) + v[i];
+        else
+            c[k] += ( v[i] - t ) + s[k];
+        s[k] = t;
+    }
+
+    // Combine the 2 sums with the same compensation.
+    double t = s[0] + s[1];
+    double e = ( std::fabs ( s[0] ) >= std::fabs ( s[1] ) ) ? ( s[0] - t ) + s[1] : ( s[1] - t ) + s[0];
+
+    return result ( t + ( e + c[0] + c[1] ) , v , 1 , NULL , 0 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::dot ( const NOMAD::Double * x , const NOMAD::Double * y , int n )
+{
+    return dot ( x , 1 , y , 1 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::dot ( const NOMAD::Double * x , int incx ,
+                                      const NOMAD::Double * y , int incy , int n )
+{
+    const double * v = raw ( x );
+    const double * w = raw ( y );
+    return result ( sum_terms<Product> ( v , incx , w , incy , n ) , v , incx , w , incy , n );
+}
+
+NOMAD::Double NOMAD::Reduction::squared_norm ( const NOMAD::Double * x , int n )
+{
+    return squared_norm ( x , 1 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::squared_norm ( const NOMAD::Double * x , int incx , int n )
+{
+    const double * v = raw ( x );
+    return result ( sum_terms<Square> ( v , incx , v , incx , n ) , v , incx , NULL , 0 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::squared_dist ( const NOMAD::Double * x , const NOMAD::Double * y , int n )
+{
+    return squared_dist ( x , 1 , y , 1 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::squared_dist ( const NOMAD::Double * x , int incx ,
+                                               const NOMAD::Double * y , int incy , int n )
+{
+    const double * v = raw ( x );
+    const double * w = raw ( y );
+    return result ( sum_terms<Diff_Square> ( v , incx , w , incy , n ) , v , incx , w , incy , n );
+}
+
+/*-----------------------------------------------------------*/
+/*                           norms                           */
+/*-----------------------------------------------------------*/
+NOMAD::Double NOMAD::Reduction::norm ( const NOMAD::Double * x , int n , NOMAD::hnorm_type type )
+{
+    return norm ( x , 1 , n , type );
+}
+
+NOMAD::Double NOMAD::Reduction::norm ( const NOMAD::Double * x , int incx , int n ,
+                                       NOMAD::hnorm_type type )
+{
+    const double * v = raw ( x );
+    double r;
+    switch ( type )
+    {
+        case NOMAD::L1:
+            r = sum_terms<Abs> ( v , incx , v , incx , n );
+            break;
+        case NOMAD::LINF:
+            r = max_terms<Abs> ( v , incx , v , incx , n );
+            break;
+        default:
+            r = std::sqrt ( sum_terms<Square> ( v , incx , v , incx , n ) );
+            break;
+    }
+    return result ( r , v , incx , NULL , 0 , n );
+}
+
+NOMAD::Double NOMAD::Reduction::dist ( const NOMAD::Double * x , const NOMAD::Double * y , int n ,
+                                       NOMAD::hnorm_type type )
+{
+    return dist ( x , 1 , y , 1 , n , type );
+}
+
+NOMAD::Double NOMAD::Reduction::dist ( const NOMAD::Double * x , int incx ,
+                                       const NOMAD::Double * y , int incy , int n ,
+                                       NOMAD::hnorm_type type )
+{
+    const double * v = raw ( x );
+    const double * w = raw ( y );
+    double r;
+    switch ( type )
+    {
+        case NOMAD::L1:
+            r = sum_terms<Diff_Abs> ( v , incx , w , incy , n );
+            break;
+        case NOMAD::LINF:
+            r = max_terms<Diff_Abs> ( v , incx , w , incy , n );
+            break;
+        default:
+            r = std::sqrt ( sum_terms<Diff_Square> ( v , incx , w , incy , n ) );
+            break;
+    }
+    return result ( r , v , incx , w , incy , n );
+}
@@ -0,0 +1,162 @@
+/**
+ \file   Reduction.hpp
+ \brief  Sums and norms of arrays of reals (headers)
+ \see    Reduction.cpp
+ */
+
+#ifndef __NOMAD400_REDUCTION__
+#define __NOMAD400_REDUCTION__
+
+#include "Math/Double.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Sums, dot products and norms of arrays of NOMAD::Double.
+    /**
+     - Sums are pairwise: the array is split in halves down to blocks of
+       \c BLOCK_SIZE values, which keeps the rounding error in O(log n)
+       instead of O(n) for a serial loop.
+     - Each block is accumulated in \c NB_ACCUMULATORS independent sums, so
+       that the additions are not serialized and can be vectorized.
+     - \c sum_compensated() uses Kahan-Babuska (Neumaier) compensation, for
+       an error that does not grow with n.
+     - Values are not checked one by one. If an argument is undefined, a
+       NOMAD::Double::Not_Defined exception is thrown, or the result is
+       undefined when \c UNCHECKED_DOUBLE is defined.
+     - The overloads with \c incx and \c incy read the values \c x[i*incx]
+       and \c y[i*incy], as in BLAS, for the rows and columns of matrices.
+     */
+    class Reduction {
+
+    public:
+
+        /// Size of the blocks summed serially.
+        static const int BLOCK_SIZE = 128;
+
+        /// Number of independent sums in a block (a power of 2).
+        static const int NB_ACCUMULATORS = 4;
+
+        /// Sum.
+        /**
+         \param x The values -- \b IN.
+         \param n Number of values -- \b IN.
+         \return  The sum of the \c x[i].
+         */
+        static NOMAD::Double sum ( const NOMAD::Double * x , int n );
+
+        /// Compensated sum.
+        /**
+         \param x The values -- \b IN.
+         \param n Number of values -- \b IN.
+         \return  The sum of the \c x[i].
+         */
+        static NOMAD::Double sum_compensated ( const NOMAD::Double * x , int n );
+
+        /// Dot product.
+        /**
+         \param x The first values -- \b IN.
+         \param y The second values -- \b IN.
+         \param n Number of values -- \b IN.
+         \return  The sum of the \c x[i]*y[i].
+         */
+        static NOMAD::Double dot ( const NOMAD::Double * x , const NOMAD::Double * y , int n );
+
+        /// Dot product, with strides.
+        /**
+         \param x    The first values -- \b IN.
+         \param incx Stride of \c x -- \b IN.
+         \param y    The second values -- \b IN.
+         \param incy Stride of \c y -- \b IN.
+         \param n    Number of values -- \b IN.
+         \return     The sum of the \c x[i*incx]*y[i*incy].
+         */
+        static NOMAD::Double dot ( const NOMAD::Double * x , int incx ,
+                                   const NOMAD::Double * y , int incy , int n );
+
+        /// Squared L2 norm.
+        /**
+         \param x The values -- \b IN.
+         \param n Number of values -- \b IN.
+         \return  The sum of the \c x[i]^2.
+         */
+        static NOMAD::Double squared_norm ( const NOMAD::Double * x , int n );
+
+        /// Squared L2 norm, with a stride.
+        /**
+         \param x    The values -- \b IN.
+         \param incx Stride of \c x -- \b IN.
+         \param n    Number of values -- \b IN.
+         \return     The sum of the \c x[i*incx]^2.
+         */
+        static NOMAD::Double squared_norm ( const NOMAD::Double * x , int incx , int n );
+
+        /// Squared L2 distance.
+        /**
+         \param x The first values -- \b IN.
+         \param y The second values -- \b IN.
+         \param n Number of values -- \b IN.
+         \return  The sum of the \c (y[i]-x[i])^2.
+         */
+        static NOMAD::Double squared_dist ( const NOMAD::Double * x , const NOMAD::Double * y , int n );
+
+        /// Squared L2 distance, with strides.
+        /**
+         \param x    The first values -- \b IN.
+         \param incx Stride of \c x -- \b IN.
+         \param y    The second values -- \b IN.
+         \param incy Stride of \c y -- \b IN.
+         \param n    Number of values -- \b IN.
+         \return     The sum of the \c (y[i*incy]-x[i*incx])^2.
+         */
+        static NOMAD::Double squared_dist ( const NOMAD::Double * x , int incx ,
+                                            const NOMAD::Double * y , int incy , int n );
+
+        /// Norm.
+        /**
+         \param x    The values -- \b IN.
+         \param n    Number of values -- \b IN.
+         \param type The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         \return     The norm of \c x.
+         */
+        static NOMAD::Double norm ( const NOMAD::Double * x , int n ,
+                                    NOMAD::hnorm_type type = NOMAD::L2 );
+
+        /// Norm, with a stride.
+        /**
+         \param x    The values -- \b IN.
+         \param incx Stride of \c x -- \b IN.
+         \param n    Number of values -- \b IN.
+         \param type The norm, L1, L2 or LINF -- \b IN.
+         \return     The norm of \c x.
+         */
+        static NOMAD::Double norm ( const NOMAD::Double * x , int incx , int n ,
+                                    NOMAD::hnorm_type type );
+
+        /// Distance.
+        /**
+         \param x    The first values -- \b IN.
+         \param y    The second values -- \b IN.
+         \param n    Number of values -- \b IN.
+         \param type The norm, L1, L2 or LINF -- \b IN -- \b optional (default = L2).
+         \return     The norm of \c y-x.
+         */
+        static NOMAD::Double dist ( const NOMAD::Double * x , const NOMAD::Double * y , int n ,
+                                    NOMAD::hnorm_type type = NOMAD::L2 );
+
+        /// Distance, with strides.
+        /**
+         \param x    The first values -- \b IN.
+         \param incx Stride of \c x -- \b IN.
+         \param y    The second values -- \b IN.
+         \param incy Stride of \c y -- \b IN.
+         \param n    Number of values -- \b IN.
+         \param type The norm, L1, L2 or LINF -- \b IN.
+         \return     The norm of \c y-x.
+         */
+        static NOMAD::Double dist ( const NOMAD::Double * x , int incx ,
+                                    const NOMAD::Double * y , int incy , int n ,
+                                    NOMAD::hnorm_type type );
+    };
+
+#include "nomad_nsend.hpp"
+#endif
@@ -0,0 +1,177 @@
+/**
+ \file   Sobol.hpp
+ \brief  Scrambled Sobol sequence (headers)
+ \see    Sobol.cpp
+ */
+
+#ifndef __NOMAD400_SOBOL__
+#define __NOMAD400_SOBOL__
+
+#include <vector>
+
+#include "Math/Point.hpp"
+#include "Math/PointSet.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Class for the Sobol low-discrepancy sequence, with the interface of NOMAD::LHS.
+    /**
+     - Dimension \c n, at most NOMAD::MAX_DIMENSION, \c p samples, a seed,
+       and bounds: \c [0,1]^n by default, or set_bounds().
+     - Coordinate 0 is the van der Corput sequence. Coordinates \c i>0 use
+       the primitive polynomials and initial direction numbers of Joe and
+       Kuo (table new-joe-kuo-6.21201): without scrambling, the samples are
+       the standard Sobol sequence. Each coordinate is stratified: the first
+       \c 2^m samples have one value in each interval of width \c 2^-m.
+     - The samples are generated in Gray code order: each sample costs one
+       \c xor per coordinate. Sample \c k is also available directly, in
+       \c O(n*log(k)), to shard the samples between workers with seek().
+     - Scrambling (default): each coordinate is scrambled by a hash-based
+       nested uniform (Owen) scrambling of its 32 bits, keyed by the seed
+       and the coordinate. It keeps the stratification. Without scrambling,
+       sample 0 is the lower bound.
+     */
+    class Sobol {
+    public:
+
+        /// Number of bits of the integer samples.
+        static const int NB_BITS = 32;
+
+    private:
+
+        /*---------*/
+        /* Members */
+        /*---------*/
+
+        int                     _n;           // Dimension
+        int                     _p;           // Number of samples
+        int                     _seed;        // Seed of the scrambling
+        bool                    _scrambling;  // Scrambling of the samples
+        std::vector<double>     _lb;          // Lower bounds
+        std::vector<double>     _ub;          // Upper bounds
+        std::vector<uint32_t>   _v;           // Direction numbers: _v[j*n+i], bit j of coordinate i
+        std::vector<uint32_t>   _keys;        // Scrambling keys of the coordinates
+        std::vector<uint32_t>   _x;           // Integer sample of index _next
+        int                     _next;        // Index of the next sample
+
+        /// Integer sample \c k, without scrambling.
+        /**
+         \param k The index -- \b IN.
+         \param x The \c n integers -- \b OUT.
+         */
+        void integer_sample ( int k , uint32_t * x ) const;
+
+        /// Scaling of an integer sample.
+        /**
+         \param x The \c n integers -- \b IN.
+         \param y The sample -- \b OUT.
+         */
+        void scale ( const uint32_t * x , NOMAD::PointSet::Slice y ) const;
+
+        /// Keys of the scrambling, from the seed.
+        void set_keys ( void );
+
+    public:
+        /*-------------*/
+        /* Constructor */
+        /*-------------*/
+        /**
+         \param n    Dimension -- \b IN -- \b optional (default = 1).
+         \param p    Number of samples -- \b IN -- \b optional (default = 1).
+         \param seed Seed of the scrambling -- \b IN -- \b optional (default = 2920).
+         */
+        explicit Sobol ( int n = 1 , int p = 1 , int seed = 2920 );
+
+        /*---------*/
+        /* Get/Set */
+        /*---------*/
+        /// Access to the dimension.
+        int get_dimension ( void ) const { return _n; }
+
+        /// Access to the number of samples.
+        int get_nb_samples ( void ) const { return _p; }
+
+        /// Access to the seed.
+        int get_seed ( void ) const { return _seed; }
+
+        /// Set the seed of the scrambling.
+        /**
+         \param seed The seed -- \b IN.
+         */
+        void set_seed ( int seed );
+
+        /// Access to the scrambling.
+        bool get_scrambling ( void ) const { return _scrambling; }
+
+        /// Set the scrambling.
+        /**
+         \param scrambling Scramble the samples -- \b IN.
+         */
+        void set_scrambling ( bool scrambling ) { _scrambling = scrambling; }
+
+        /// Access to the lower bounds.
+        const std::vector<double> & get_lb ( void ) const { return _lb; }
+
+        /// Access to the upper bounds.
+        const std::vector<double> & get_ub ( void ) const { return _ub; }
+
+        /// Set the bounds.
+        /**
+         \param l The lower bounds -- \b IN.
+         \param u The upper bounds, with \c l<=u, finite -- \b IN.
+         */
+        void set_bounds ( const std::vector<double> & l , const std::vector<double> & u );
+
+        /// Set the bounds.
+        /**
+         \param l The lower bounds, defined -- \b IN.
+         \param u The upper bounds, defined -- \b IN.
+         */
+        void set_bounds ( const NOMAD::Point & l , const NOMAD::Point & u );
+
+        /// Access to the index of the next sample.
+        int get_index ( void ) const { return _next; }
+
+        /// Set the index of the next sample (skip-ahead).
+        /**
+         \param k The index, in \c [0,p] -- \b IN.
+         */
+        void seek ( int k );
+
+        /// Are all the samples generated ?
+        bool done ( void ) const { return _next >= _p; }
+
+        /*----------*/
+        /* Sampling */
+        /*----------*/
+        /// Sample \c k.
+        /**
+         \param k The index, in \c [0,INT_MAX] -- \b IN.
+         \param x The sample -- \b OUT.
+         */
+        void Sample ( int k , NOMAD::Point & x ) const;
+
+        /// All the samples.
+        /**
+         \param points A set of \c p points of dimension \c n -- \b OUT.
+         */
+        void Sample ( NOMAD::PointSet & points ) const;
+
+        /// Next sample.
+        /**
+         \param x The sample -- \b OUT.
+         \return  A boolean equal to \c false if all the samples are generated.
+         */
+        bool next ( NOMAD::Point & x );
+
+        /// Next samples.
+        /**
+         \param block A set of points of dimension \c n -- \b OUT.
+         \return      The number of samples in the first rows of \c block,
+                      less than its number of points at the end.
+         */
+        int next ( NOMAD::PointSet & block );
+    };
+
+#include "nomad_nsend.hpp"
+#endif
@@ -5,7 +5,7 @@
  \date   April 2017
  \see    Vector.hpp
  */
-#include <math.h>
+#include <utility>
 
 #include "Vector.hpp"
 
@@ -37,6 +37,15 @@ _endPoint (v._endPoint)
 {
 }
 
+/*-----------------------------------------------------------*/
+/*                        move constructor                   */
+/*-----------------------------------------------------------*/
+NOMAD::Vector::Vector ( NOMAD::Vector && v ) noexcept :
+_initialPoint (std::move(v._initialPoint)),
+_endPoint (std::move(v._endPoint))
+{
+}
+
 /*-----------------------------------------------*/
 /*                    destructor                 */
 /*-----------------------------------------------*/
@@ -55,6 +64,26 @@ const NOMAD::Vector & NOMAD::Vector::operator = ( const NOMAD::Vector & v )
     return *this;
 }
 
+/*-----------------------------------------------------------*/
+/*                  move affectation operator                */
+/*-----------------------------------------------------------*/
+NOMAD::Vector & NOMAD::Vector::operator = ( NOMAD::Vector && v ) noexcept
+{
+    _initialPoint   = std::move(v._initialPoint);
+    _endPoint       = std::move(v._endPoint);
+
+    return *this;
+}
+
+/*-----------------------------------------------------------*/
+/*                            swap                           */
+/*-----------------------------------------------------------*/
+void NOMAD::Vector::swap ( NOMAD::Vector & v ) noexcept
+{
+    _initialPoint.swap(v._initialPoint);
+    _endPoint.swap(v._endPoint);
+}
+
 /*-----------------------------------------------------------*/
 /*                     class methods                         */
 /*-----------------------------------------------------------*/
@@ -68,14 +97,10 @@ NOMAD::Double NOMAD::Vector::norm () const
     // vector changes (ex. scalar multiplication).
     //
 
-    int size = _endPoint.get_size();
-
-    for (int i = 0; i < size; i++)
-    {
-        NOMAD::Double diff = _endPoint[i]-_initialPoint[i];
-        norm += diff * diff;
-    }
-    norm = sqrt(norm.todouble());
+    // The pairwise sum of NOMAD::Reduction is faster and more accurate
+    // than a serial loop on NOMAD::Double. Undefined coordinates are
+    // checked on the result.
+    norm = _initialPoint.dist ( _endPoint , NOMAD::L2 );
 
     return norm;
 }
@@ -56,6 +56,12 @@
          */
         Vector ( const Vector & v );
 
+        /// Move constructor.
+        /**
+         \param v The moved object -- \b IN/OUT.
+         */
+        Vector ( Vector && v ) noexcept;
+
         /// Affectation operator.
         /**
          \param p The right-hand side object -- \b IN.
@@ -63,6 +69,19 @@
          */
         const Vector & operator = ( const Vector & v );
 
+        /// Move affectation operator.
+        /**
+         \param v The right-hand side object -- \b IN/OUT.
+         \return \c *this as the result of the affectation.
+         */
+        Vector & operator = ( Vector && v ) noexcept;
+
+        /// Swap the content of two vectors.
+        /**
+         \param v The other vector -- \b IN/OUT.
+         */
+        void swap ( Vector & v ) noexcept;
+
         /// Destructor.
         ~Vector ( void );
 
@@ -73,13 +92,13 @@
         /**
          \return Initial point of the vector
          */
-        NOMAD::Point get_initialPoint () const { return _initialPoint; }
+        const NOMAD::Point & get_initialPoint () const { return _initialPoint; }
 
         /// Access to the second point
         /**
          \return End point of the vector
          */
-        NOMAD::Point get_endPoint () const { return _endPoint; }
+        const NOMAD::Point & get_endPoint () const { return _endPoint; }
 
         /*---------------*/
         /* Class methods */
@@ -97,5 +116,8 @@
 
     };
 
+    /// Swap the content of two vectors.
+    inline void swap ( NOMAD::Vector & v1 , NOMAD::Vector & v2 ) noexcept { v1.swap ( v2 ); }
+
 #include "nomad_nsend.hpp"
 #endif
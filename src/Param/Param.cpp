@@ -8,9 +8,9 @@ NOMAD::Param::Param(std::string param_name,
              std::string type_string,
              std::string category,
              bool value_is_const)
-  : m_name(param_name),
+  : m_name(std::move(param_name)),
     m_paramvalue(type_string, value_string),
-    m_category(category),
+    m_category(std::move(category)),
     m_value_is_const(value_is_const)
 {
     init();
@@ -21,9 +21,9 @@ NOMAD::Param::Param(std::string param_name,
              ParamValue paramvalue,
              std::string category,
              bool value_is_const)
-  : m_name(param_name),
-    m_paramvalue(paramvalue),
-    m_category(category),
+  : m_name(std::move(param_name)),
+    m_paramvalue(std::move(paramvalue)),
+    m_category(std::move(category)),
     m_value_is_const(value_is_const)
 {
     init();
@@ -47,7 +47,7 @@ void NOMAD::Param::init()
     }
 }
 
-std::string NOMAD::Param::get_name() const
+const std::string & NOMAD::Param::get_name() const
 {
     return m_name;
 }
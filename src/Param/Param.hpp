@@ -3,6 +3,7 @@
 #define __RUNNER400_PARAM__
 
 #include <string>
+#include <utility>
 
 #include <Util/Exception.hpp>
 
@@ -39,24 +40,39 @@ public:
           std::string category = "USER",
           bool value_is_const = false);
 
+    // Copy and move
+    Param(const NOMAD::Param &p) = default;
+    Param(NOMAD::Param &&p) noexcept = default;
+    Param & operator= (const NOMAD::Param &p) = default;
+    Param & operator= (NOMAD::Param &&p) noexcept = default;
+
+    // Swap the content of two Params.
+    void swap(NOMAD::Param &p) noexcept
+    {
+        m_name.swap(p.m_name);
+        m_paramvalue.swap(p.m_paramvalue);
+        m_category.swap(p.m_category);
+        std::swap(m_value_is_const, p.m_value_is_const);
+    }
+
     // Destructor
     ~Param() {}
 
     // Get/Set
 
     // Name - Setting name has some validation.
-    std::string get_name() const;
+    const std::string & get_name() const;
     void set_name(const std::string param_name);
 
     // Get Category
-    std::string         get_category()          const { return m_category; }
+    const std::string & get_category()          const { return m_category; }
 
     // Get for all supported value types
-    std::string     get_value_str()     const { return m_paramvalue.get_value_str(); }
+    const std::string & get_value_str() const { return m_paramvalue.get_value_str(); }
     NOMAD::Double   get_value_double()  const { return m_paramvalue.get_value_double(); }
     bool            get_value_bool()    const { return m_paramvalue.get_value_bool(); }
     int             get_value_int()     const { return m_paramvalue.get_value_int(); }
-    std::string     get_type_str()      const { return m_paramvalue.get_type_str(); }
+    const std::string & get_type_str()  const { return m_paramvalue.get_type_str(); }
 
     // Set value
     void            set_value (const std::string value);
@@ -80,6 +96,9 @@ public:
     bool operator< (const NOMAD::Param &p) const;
 };
 
+// Swap the content of two Params.
+inline void swap(NOMAD::Param &p1, NOMAD::Param &p2) noexcept { p1.swap(p2); }
+
 #include "nomad_nsend.hpp"
 
 #endif
@@ -1,4 +1,6 @@
 
+#include <utility>
+
 #include "ParamValue.hpp"
 
 // Constructors
@@ -18,9 +20,9 @@ NOMAD::ParamValue::ParamValue(const double value)
     m_type_unsupported(false),
     m_value_str()
 {
-    std::stringstream ss;
-    ss << value;
-    m_value_str = ss.str();
+    char buf[NOMAD::Double::STR_SIZE];
+    NOMAD::Double::snprint_double(buf, sizeof(buf), value);
+    m_value_str = buf;
 }
 
 // Constructor for std::string.
@@ -44,22 +46,16 @@ NOMAD::ParamValue::ParamValue(const char* value)
 NOMAD::ParamValue::ParamValue(const int value)
   : m_type_str("int"),
     m_type_unsupported(false),
-    m_value_str()
+    m_value_str(NOMAD::itos(value))
 {
-    std::stringstream ss;
-    ss << value;
-    m_value_str = ss.str();
 }
 
 // Constructor for bool.
 NOMAD::ParamValue::ParamValue(const bool value)
   : m_type_str("bool"),
     m_type_unsupported(false),
-    m_value_str()
+    m_value_str(value ? "1" : "0")
 {
-    std::stringstream ss;
-    ss << value;
-    m_value_str = ss.str();
 }
 
 // Constructor for a type given as argument (as string).
@@ -91,6 +87,14 @@ NOMAD::ParamValue::ParamValue(const NOMAD::ParamValue &v)
 {
 }
 
+// Move constructor
+NOMAD::ParamValue::ParamValue(NOMAD::ParamValue &&v) noexcept
+  : m_type_str(std::move(v.m_type_str)),
+    m_type_unsupported(v.m_type_unsupported),
+    m_value_str(std::move(v.m_value_str))
+{
+}
+
 // Affectation operators
 NOMAD::ParamValue & NOMAD::ParamValue::operator = ( const NOMAD::ParamValue & v )
 {
@@ -101,6 +105,23 @@ NOMAD::ParamValue & NOMAD::ParamValue::operator = ( const NOMAD::ParamValue & v
     return *this;
 }
 
+NOMAD::ParamValue & NOMAD::ParamValue::operator = ( NOMAD::ParamValue && v ) noexcept
+{
+    m_type_str          = std::move(v.m_type_str);
+    m_type_unsupported  = v.m_type_unsupported;
+    m_value_str         = std::move(v.m_value_str);
+
+    return *this;
+}
+
+// Swap
+void NOMAD::ParamValue::swap(NOMAD::ParamValue &v) noexcept
+{
+    m_type_str.swap(v.m_type_str);
+    std::swap(m_type_unsupported, v.m_type_unsupported);
+    m_value_str.swap(v.m_value_str);
+}
+
 // Validate the type given by m_type_string.
 // Unsupported type means the user has to do the conversion from string. There
 // is no constructor for this type and no output to this type.
@@ -133,7 +154,7 @@ bool NOMAD::ParamValue::is_valid() const
         // Accept a NOMAD::Double even if it is not defined.
         try
         {
-            NOMAD::Double d = get_value_double();
+            get_value_double();
             is_valid = true;
         }
         catch (NOMAD::Exception &e)
@@ -182,14 +203,11 @@ bool NOMAD::ParamValue::is_valid() const
 NOMAD::Double NOMAD::ParamValue::get_value_double() const
 {
     NOMAD::Double d = 0.0;
-    std::string err = "ERROR: Could not convert this value to NOMAD::Double : " + m_value_str;
-    if ("NOMAD::Double" != m_type_str)
-    {
-        throw NOMAD::Exception(__FILE__,__LINE__,err);
-    }
-
-    if (!d.atof(m_value_str))
+    // The error message is built on failure only, so that a successful
+    // conversion does not allocate.
+    if ("NOMAD::Double" != m_type_str || !d.atof(m_value_str))
     {
+        std::string err = "ERROR: Could not convert this value to NOMAD::Double : " + m_value_str;
         throw NOMAD::Exception(__FILE__,__LINE__,err);
     }
 
@@ -199,16 +217,15 @@ NOMAD::Double NOMAD::ParamValue::get_value_double() const
 bool NOMAD::ParamValue::get_value_bool() const
 {
     bool b = false;
-    std::string err = "ERROR: Could not convert this value to bool : " + m_value_str;
 
-    if ("bool" != m_type_str)
+    int intb = -1;
+    if ("bool" == m_type_str)
     {
-        throw NOMAD::Exception(__FILE__,__LINE__,err);
+        intb = NOMAD::string_to_bool(m_value_str);
     }
-
-    int intb = NOMAD::string_to_bool(m_value_str);
     if (intb < 0)
     {
+        std::string err = "ERROR: Could not convert this value to bool : " + m_value_str;
         throw NOMAD::Exception(__FILE__,__LINE__,err);
     }
     b = intb;
@@ -219,15 +236,10 @@ bool NOMAD::ParamValue::get_value_bool() const
 int NOMAD::ParamValue::get_value_int() const
 {
     int i = 0;
-    std::string err = "ERROR: Could not convert this value to int : " + m_value_str;
 
-    if ("int" != m_type_str)
-    {
-        throw NOMAD::Exception(__FILE__,__LINE__,err);
-    }
-    
-    if (!NOMAD::atoi(m_value_str, i))
+    if ("int" != m_type_str || !NOMAD::atoi(m_value_str, i))
     {
+        std::string err = "ERROR: Could not convert this value to int : " + m_value_str;
         throw NOMAD::Exception(__FILE__,__LINE__,err);
     }
 
@@ -277,17 +289,15 @@ void NOMAD::ParamValue::set_value(const NOMAD::Double value)
 void NOMAD::ParamValue::set_value(const double value)
 {
     m_type_str = "NOMAD::Double";
-    std::stringstream ss;
-    ss << value;
-    m_value_str = ss.str();
+    char buf[NOMAD::Double::STR_SIZE];
+    NOMAD::Double::snprint_double(buf, sizeof(buf), value);
+    m_value_str = buf;
 }
 
 void NOMAD::ParamValue::set_value(const bool value)
 {
     m_type_str = "bool";
-    std::stringstream ss;
-    ss << value;
-    m_value_str = ss.str();
+    m_value_str = value ? "1" : "0";
 }
 
 void NOMAD::ParamValue::set_value(std::string value)
@@ -305,9 +315,7 @@ void NOMAD::ParamValue::set_value(const char* value)
 void NOMAD::ParamValue::set_value(const int value)
 {
     m_type_str = "int";
-    std::stringstream ss;
-    ss << value;
-    m_value_str = ss.str();
+    m_value_str = NOMAD::itos(value);
 }
 
 void NOMAD::ParamValue::set_value_str(const std::string value)
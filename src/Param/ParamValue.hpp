@@ -29,8 +29,15 @@ public:
     // Copy constructor
     ParamValue(const NOMAD::ParamValue &v);
 
+    // Move constructor
+    ParamValue(NOMAD::ParamValue &&v) noexcept;
+
     // Affectation operators.
     ParamValue & operator = ( const NOMAD::ParamValue & v );
+    ParamValue & operator = ( NOMAD::ParamValue && v ) noexcept;
+
+    // Swap the content of two ParamValues.
+    void swap(NOMAD::ParamValue &v) noexcept;
 
 
     // Comparison operators
@@ -49,12 +56,12 @@ public:
     bool is_valid() const;
 
     // Get/Set
-    std::string get_type_str() const { return m_type_str; }
+    const std::string & get_type_str() const { return m_type_str; }
 
     NOMAD::Double   get_value_double()              const;
     bool            get_value_bool()                const;
     int             get_value_int()                 const;
-    std::string     get_value_str()                 const { return m_value_str; }
+    const std::string & get_value_str()             const { return m_value_str; }
     std::string     get_value_str(const int index)  const;
 
     void set_value(const NOMAD::Double value);
@@ -75,6 +82,9 @@ public:
 
 };
 
+// Swap the content of two ParamValues.
+inline void swap(NOMAD::ParamValue &v1, NOMAD::ParamValue &v2) noexcept { v1.swap(v2); }
+
 #include "nomad_nsend.hpp"
 
 #endif
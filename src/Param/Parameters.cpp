@@ -1,6 +1,8 @@
 
 #include <algorithm>
+#include <cctype>
 #include <fstream>
+#include <utility>
 #include <Util/fileutils.hpp>
 #include <Util/utils.hpp>
 #include "Parameters.hpp"
@@ -26,8 +28,24 @@ NOMAD::Parameters::Parameters()
 
         parse_line(line);
     }
+#ifdef MEMORY_DEBUG
+    NOMAD::MemoryCounter::construct(NOMAD::MemoryCounter::PARAMETERS, sizeof(Parameters));
+#endif
 }
 
+#ifdef MEMORY_DEBUG
+NOMAD::Parameters::Parameters(const Parameters &params)
+  : m_params(params.m_params)
+{
+    NOMAD::MemoryCounter::construct(NOMAD::MemoryCounter::PARAMETERS, sizeof(Parameters));
+}
+
+NOMAD::Parameters::~Parameters()
+{
+    NOMAD::MemoryCounter::destruct(NOMAD::MemoryCounter::PARAMETERS, sizeof(Parameters));
+}
+#endif
+
 // Add the parameter.
 // If a parameter with this name already exists, set its value
 // to the input parameter's value.
@@ -70,22 +88,14 @@ bool NOMAD::Parameters::add(const NOMAD::Param &param)
 // 1 - Parameter found and updated
 // 0 - Parameter found but not updated
 // -1 - Parameter not found.
-int NOMAD::Parameters::update(const std::string param_name, const std::string value_string)
+int NOMAD::Parameters::update(const std::string &param_name, const std::string &value_string)
 {
     int ret_value = -1;
 
-    // VRM current implementation is not optimal.
-    // There is redundancy in search, plus search itself could use std functions.
-    if (is_defined(param_name))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it != m_params.end())
     {
-        Param param(param_name, value_string);
-        if (!this->find(param_name, param))
-        {
-            std::string err = "Parameter could not be found: " + param_name;
-            throw NOMAD::Exception(__FILE__, __LINE__, err);
-        }
-
-        if (param.value_is_const())
+        if (it->value_is_const())
         {
             ret_value = 0;
             std::cerr << "Could not update this parameter value because it is const: " << param_name << std::endl;
@@ -96,13 +106,13 @@ int NOMAD::Parameters::update(const std::string param_name, const std::string va
             {
                 // Create a new Param based on the found param, but
                 // using the new value.
-                Param newparam = param;
+                Param newparam = *it;
                 newparam.set_value_str(value_string);
-                // Remove the current param and add the new one.
-                m_params.erase(param);
-                std::pair<std::set<NOMAD::Param>::iterator,bool> ret;
-                ret = m_params.insert(newparam);
-                ret_value = ret.second;
+                // Replace the current param by the new one, at the same
+                // position in the set.
+                it = m_params.erase(it);
+                m_params.insert(it, std::move(newparam));
+                ret_value = 1;
             }
             catch (NOMAD::Exception &e)
             {
@@ -115,131 +125,124 @@ int NOMAD::Parameters::update(const std::string param_name, const std::string va
     return ret_value;
 }
 
-bool NOMAD::Parameters::remove(const std::string param_name)
+bool NOMAD::Parameters::remove(const std::string &param_name)
 {
-    bool param_removed = false;
-
-    // Work with caps
-    std::string param_name_caps = param_name;
-    NOMAD::toupper(param_name_caps);
-
-    if (!is_defined(param_name_caps))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
     {
         std::string err = "There is no parameter " + param_name + " to remove.";
         std::cerr << err << std::endl;
-    }
-    std::set<NOMAD::Param>::iterator it;
-    for (it = m_params.begin(); it != m_params.end(); it++)
-    {
-        if (it->get_name() == param_name_caps)
-        {
-            m_params.erase(it);
-            param_removed = true;
-        }
+        return false;
     }
 
-    if (it == m_params.end())
-    {
-        // Sanity check. We should never get there.
-        std::string err = "Could not remove parameter " + param_name;
-        NOMAD::Exception(__FILE__, __LINE__, err);
-    }
+    m_params.erase(it);
 
-    return param_removed;
+    return true;
 }
 
 
-bool NOMAD::Parameters::is_defined(const std::string param_name) const
+bool NOMAD::Parameters::is_defined(const std::string &param_name) const
 {
-    Param param(param_name, param_name); // unused
-    bool found = this->find(param_name, param);
-
-    return found;
+    return (find_iterator(param_name) != m_params.end());
 }
 
 
-std::string NOMAD::Parameters::get_value_str(const std::string param_name) const
+std::string NOMAD::Parameters::get_value_str(const std::string &param_name) const
 {
-    Param param(param_name, param_name);
-    if (!this->find(param_name, param))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
     {   
         std::string err = "Parameter is not defined: " + param_name;
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
-    return param.get_value_str();
+    return it->get_value_str();
 }
 
-NOMAD::Double NOMAD::Parameters::get_value_double(const std::string param_name) const
+NOMAD::Double NOMAD::Parameters::get_value_double(const std::string &param_name) const
 {
-    std::string s = "0.0";
-    Param param(param_name, s, "NOMAD::Double");
-    if (!this->find(param_name, param))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
     {   
         std::string err = "Parameter is not defined: " + param_name;
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
-    return param.get_value_double();
+    return it->get_value_double();
 }
 
-bool NOMAD::Parameters::get_value_bool(const std::string param_name) const
+bool NOMAD::Parameters::get_value_bool(const std::string &param_name) const
 {
-    std::string s = "false";
-    Param param(param_name, s, "bool");
-    if (!this->find(param_name, param))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
     {   
         std::string err = "Parameter is not defined: " + param_name;
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
-    return param.get_value_bool();
+    return it->get_value_bool();
 }
 
-int NOMAD::Parameters::get_value_int(const std::string param_name) const
+int NOMAD::Parameters::get_value_int(const std::string &param_name) const
 {
-    std::string s = "0";
-    Param param(param_name, s, "int");
-    if (!this->find(param_name, param))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
     {   
         std::string err = "Parameter is not defined: " + param_name;
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
-    return param.get_value_int();
+    return it->get_value_int();
 }
 
-std::string NOMAD::Parameters::get_type_str(const std::string param_name) const
+std::string NOMAD::Parameters::get_type_str(const std::string &param_name) const
 {
-    Param param(param_name, param_name);
-    if (!this->find(param_name, param))
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
     {   
         std::string err = "Parameter is not defined: " + param_name;
         throw NOMAD::Exception(__FILE__, __LINE__, err);
     }
 
-    return param.get_type_str();
+    return it->get_type_str();
 }
 
-bool NOMAD::Parameters::find(const std::string param_name, Param &param) const
+bool NOMAD::Parameters::find(const std::string &param_name, Param &param) const
 {
-    // Work with caps
-    std::string param_name_caps = param_name;
-    NOMAD::toupper(param_name_caps);
+    std::set<NOMAD::Param>::const_iterator it = find_iterator(param_name);
+    if (it == m_params.end())
+    {
+        return false;
+    }
 
-    std::set<NOMAD::Param>::const_iterator it;
-    bool found = false;
+    param = *it;
+    return true;
+}
 
+// Names are stored in caps. Compare without making a caps copy
+// of param_name.
+std::set<NOMAD::Param>::const_iterator NOMAD::Parameters::find_iterator(const std::string &param_name) const
+{
+    std::set<NOMAD::Param>::const_iterator it;
     for (it = m_params.begin(); it != m_params.end(); it++)
     {
-        if (it->get_name() == param_name_caps)
+        const std::string &name = it->get_name();
+        if (name.size() != param_name.size())
+        {
+            continue;
+        }
+        size_t i = 0;
+        while (i < name.size() && name[i] == std::toupper(static_cast<unsigned char>(param_name[i])))
+        {
+            i++;
+        }
+        if (i == name.size())
         {
-            param = *it;
-            found = true;
+            break;
         }
     }
 
-    return found;
+    return it;
 }
 
 bool NOMAD::Parameters::is_parameter_category(const std::string s)
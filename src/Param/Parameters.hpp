@@ -5,6 +5,7 @@
 #include <set>
 #include <vector>
 #include "Param.hpp"
+#include "Util/MemoryCounter.hpp"
 
 #include "nomad_nsbegin.hpp"
 
@@ -18,9 +19,19 @@ private:
 
     // For debugging
     void debug_display() const;
+
+    // Find parameter with this name, case insensitive.
+    // Return m_params.end() if it is not found. Does not allocate.
+    std::set<NOMAD::Param>::const_iterator find_iterator(const std::string &param_name) const;
 public:
     explicit Parameters();
+#ifdef MEMORY_DEBUG
+    // With MEMORY_DEBUG, instances are counted by NOMAD::MemoryCounter.
+    Parameters(const Parameters &params);
+    ~Parameters();
+#else
     ~Parameters() {}
+#endif
 
     // Add a Param to the list.
     // True if param was correctly added.
@@ -33,25 +44,25 @@ public:
     // -1 if parameter was not found.
     // if parameter was updated, false if it
     // was not found or could not be update.
-    int update(const std::string param_name, const std::string value_string);
+    int update(const std::string &param_name, const std::string &value_string);
 
     // Delete a Param from the list, by name.
     // True if Param named param_name was deleted successfully.
-    bool remove(const std::string param_name);
+    bool remove(const std::string &param_name);
 
     // Return true if a parameter with that name exists, false otherwise.
-    bool is_defined(const std::string param_name) const;
+    bool is_defined(const std::string &param_name) const;
 
     // Get/Set
     // Get param value for all supported value types
-    std::string     get_value_str   (const std::string param_name)  const;
-    NOMAD::Double   get_value_double(const std::string param_name)  const;
-    bool            get_value_bool  (const std::string param_name)  const;
-    int             get_value_int   (const std::string param_name)  const;
-    std::string     get_type_str    (const std::string param_name)  const;
+    std::string     get_value_str   (const std::string &param_name)  const;
+    NOMAD::Double   get_value_double(const std::string &param_name)  const;
+    bool            get_value_bool  (const std::string &param_name)  const;
+    int             get_value_int   (const std::string &param_name)  const;
+    std::string     get_type_str    (const std::string &param_name)  const;
 
     // Find parameter with this name
-    bool find(const std::string param_name, Param &param) const;
+    bool find(const std::string &param_name, Param &param) const;
 
     // Helpers for reader
     static bool is_parameter_category(const std::string s);
@@ -0,0 +1,151 @@
+/**
+ \file   MemoryCounter.cpp
+ \brief  Instance and memory accounting (implementation)
+ \see    MemoryCounter.hpp
+ */
+#include <ostream>
+#ifndef WINDOWS
+#include <pthread.h>
+#endif
+
+#include "Util/MemoryCounter.hpp"
+
+/*-----------------------------------*/
+/*   static members initialization   */
+/*-----------------------------------*/
+const long NOMAD::MemoryCounter::FLUSH_SIZE;
+NOMAD::MemoryCounter::Slot * NOMAD::MemoryCounter::_slots = NULL;
+long NOMAD::MemoryCounter::_shared[NB_COUNTERS] = { 0 };
+NOMAD_THREAD_LOCAL NOMAD::MemoryCounter::Slot * NOMAD::MemoryCounter::_slot = NULL;
+
+/*-----------------------------------------------*/
+/*         publish the pending instances         */
+/*-----------------------------------------------*/
+void NOMAD::MemoryCounter::flush ( counter_type type , Counter & c )
+{
+#if defined(__GNUC__)
+    __atomic_fetch_add ( &_shared[type] , c.pending , __ATOMIC_RELAXED );
+#else
+    _shared[type] += c.pending;
+#endif
+    c.pending = 0;
+}
+
+/*-----------------------------------------------*/
+/*          slot of the current thread           */
+/*-----------------------------------------------*/
+#ifndef WINDOWS
+namespace {
+    // Key used to publish the pending instances of a thread when it exits.
+    pthread_key_t  exit_key;
+    pthread_once_t exit_key_once = PTHREAD_ONCE_INIT;
+
+    void thread_exit ( void * )
+    {
+        NOMAD::MemoryCounter::flush_thread();
+    }
+
+    void create_exit_key ( void )
+    {
+        pthread_key_create ( &exit_key , thread_exit );
+    }
+}
+#endif
+
+void NOMAD::MemoryCounter::flush_thread ( void )
+{
+    Slot * slot = _slot;
+    if ( slot )
+        for ( int i = 0 ; i < NB_COUNTERS ; ++i )
+            flush ( static_cast<counter_type> ( i ) , slot->counters[i] );
+}
+
+NOMAD::MemoryCounter::Slot * NOMAD::MemoryCounter::new_slot ( void )
+{
+    Slot * slot = new Slot;
+    for ( int i = 0 ; i < NB_COUNTERS ; ++i )
+    {
+        slot->counters[i].live    = 0;
+        slot->counters[i].bytes   = 0;
+        slot->counters[i].pending = 0;
+        slot->counters[i].peak    = 0;
+    }
+
+    // Push the slot on the list.
+#if defined(__GNUC__)
+    slot->next = __atomic_load_n ( &_slots , __ATOMIC_RELAXED );
+    while ( !__atomic_compare_exchange_n ( &_slots , &slot->next , slot , true ,
+                                           __ATOMIC_RELEASE , __ATOMIC_RELAXED ) )
+        ;
+#else
+    slot->next = _slots;
+    _slots = slot;
+#endif
+
+    _slot = slot;
+#ifndef WINDOWS
+    pthread_once ( &exit_key_once , create_exit_key );
+    pthread_setspecific ( exit_key , slot );
+#endif
+    return slot;
+}
+
+/*-----------------------------------------------*/
+/*                    queries                    */
+/*-----------------------------------------------*/
+namespace {
+    // Head of the list of slots, with acquire semantics.
+    template < typename T >
+    T * load_head ( T * const & head )
+    {
+#if defined(__GNUC__)
+        return __atomic_load_n ( &head , __ATOMIC_ACQUIRE );
+#else
+        return head;
+#endif
+    }
+}
+
+long NOMAD::MemoryCounter::get_live ( counter_type type )
+{
+    long live = 0;
+    for ( Slot * slot = load_head ( _slots ) ; slot ; slot = slot->next )
+        live += load ( slot->counters[type].live );
+    return live;
+}
+
+long NOMAD::MemoryCounter::get_peak ( counter_type type )
+{
+    long peak = 0;
+    for ( Slot * slot = load_head ( _slots ) ; slot ; slot = slot->next )
+    {
+        long p = load ( slot->counters[type].peak );
+        if ( p > peak )
+            peak = p;
+    }
+    long live = get_live ( type );
+    return ( live > peak ) ? live : peak;
+}
+
+long NOMAD::MemoryCounter::get_bytes ( counter_type type )
+{
+    long bytes = 0;
+    for ( Slot * slot = load_head ( _slots ) ; slot ; slot = slot->next )
+        bytes += load ( slot->counters[type].bytes );
+    return bytes;
+}
+
+/*-----------------------------------------------*/
+/*                    display                    */
+/*-----------------------------------------------*/
+void NOMAD::MemoryCounter::display ( std::ostream & out )
+{
+    const char * names[NB_COUNTERS] = { "Double" , "Point" , "Parameters" };
+    for ( int i = 0 ; i < NB_COUNTERS ; ++i )
+    {
+        counter_type type = static_cast<counter_type> ( i );
+        out << names[i] << ": live=" << get_live ( type )
+            << " peak="  << get_peak  ( type )
+            << " bytes=" << get_bytes ( type ) << std::endl;
+    }
+}
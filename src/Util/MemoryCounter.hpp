@@ -0,0 +1,195 @@
+/**
+ \file   MemoryCounter.hpp
+ \brief  Instance and memory accounting (headers)
+ \see    MemoryCounter.cpp
+ */
+#ifndef __NOMAD400_MEMORY_COUNTER__
+#define __NOMAD400_MEMORY_COUNTER__
+
+#include "Util/defines.hpp"
+
+#include "nomad_nsbegin.hpp"
+
+    /// Instance and memory accounting.
+    /**
+     - Counts the live instances, the peak number of instances and the
+       live bytes of some classes (see \c counter_type).
+     - With \c MEMORY_DEBUG (see defines.hpp), the constructors and
+       destructors of the counted classes call \c construct(),
+       \c destruct() and \c resize(). The query functions are always
+       available, and return zeros without \c MEMORY_DEBUG.
+     - Each thread updates its own counters, with no lock and no atomic
+       read-modify-write. The counters of all threads are summed when they
+       are queried.
+     - A thread publishes its count every \c FLUSH_SIZE instances, and when
+       it exits. The peak is exact when one thread is running. Otherwise,
+       it may miss up to \c FLUSH_SIZE instances per other running thread.
+     */
+    class MemoryCounter {
+
+    public:
+
+        /// Counted classes.
+        enum counter_type
+        {
+            DOUBLE      ,     ///< NOMAD::Double
+            POINT       ,     ///< NOMAD::Point
+            PARAMETERS  ,     ///< NOMAD::Parameters
+            NB_COUNTERS       ///< Number of counters
+        };
+
+        /// Number of instances counted by a thread before they are published.
+        static const long FLUSH_SIZE = 64;
+
+    private:
+
+        /// Counters of one type, in one thread.
+        struct Counter
+        {
+            long live;      ///< Live instances created minus destroyed by the thread.
+            long bytes;     ///< Live bytes allocated minus freed by the thread.
+            long pending;   ///< Instances not yet added to the shared count.
+            long peak;      ///< Peak of the live instances seen by the thread.
+        };
+
+        /// Counters of one thread.
+        /**
+         Slots are linked in a list and never freed, so that the counts
+         of finished threads are kept.
+         */
+        struct Slot
+        {
+            Counter counters[NB_COUNTERS]; ///< One counter per type.
+            Slot *  next;                  ///< Next slot in the list.
+        };
+
+        static Slot * _slots;             ///< List of the slots of all threads.
+        static long   _shared[NB_COUNTERS]; ///< Published live instances.
+
+        /// Slot of the current thread.
+        static NOMAD_THREAD_LOCAL Slot * _slot;
+
+        /// Create the slot of the current thread.
+        /**
+         \return The slot.
+         */
+        static Slot * new_slot ( void );
+
+        /// Access to the slot of the current thread.
+        /**
+         \return The slot.
+         */
+        static Slot & get_slot ( void )
+        {
+            Slot * slot = _slot;
+            return *( slot ? slot : new_slot() );
+        }
+
+        /// Relaxed load of a counter that another thread may write.
+        /**
+         \param x The counter -- \b IN.
+         \return The value of the counter.
+         */
+#if defined(__GNUC__)
+        static long load ( const long & x ) { return __atomic_load_n ( &x , __ATOMIC_RELAXED ); }
+#else
+        static long load ( const long & x ) { return *static_cast<const volatile long *> ( &x ); }
+#endif
+
+        /// Relaxed store of a counter written by the current thread only.
+        /**
+         \param x The counter -- \b OUT.
+         \param v The new value -- \b IN.
+         */
+#if defined(__GNUC__)
+        static void store ( long & x , long v ) { __atomic_store_n ( &x , v , __ATOMIC_RELAXED ); }
+#else
+        static void store ( long & x , long v ) { *static_cast<volatile long *> ( &x ) = v; }
+#endif
+
+        /// Add the pending instances of the current thread to the shared count.
+        /**
+         \param type The counted class -- \b IN.
+         \param c    The counter of the current thread -- \b IN/OUT.
+         */
+        static void flush ( counter_type type , Counter & c );
+
+        /// Update the live instances of the current thread.
+        /**
+         \param type  The counted class -- \b IN.
+         \param delta Instances created (> 0) or destroyed (< 0) -- \b IN.
+         \param bytes Bytes allocated (> 0) or freed (< 0) -- \b IN.
+         */
+        static void update ( counter_type type , long delta , long bytes )
+        {
+            Counter & c = get_slot().counters[type];
+            store ( c.live    , c.live  + delta );
+            store ( c.bytes   , c.bytes + bytes );
+            c.pending += delta;
+            if ( c.pending >= FLUSH_SIZE || c.pending <= -FLUSH_SIZE )
+                flush ( type , c );
+            long seen = load ( _shared[type] ) + c.pending;
+            if ( seen > c.peak )
+                store ( c.peak , seen );
+        }
+
+    public:
+
+        /// Publish the pending instances of the current thread.
+        /**
+         Called when a thread exits.
+         */
+        static void flush_thread ( void );
+
+        /// Count the construction of an instance.
+        /**
+         \param type  The counted class -- \b IN.
+         \param bytes The memory used by the instance -- \b IN.
+         */
+        static void construct ( counter_type type , long bytes ) { update ( type , 1 , bytes ); }
+
+        /// Count the destruction of an instance.
+        /**
+         \param type  The counted class -- \b IN.
+         \param bytes The memory used by the instance -- \b IN.
+         */
+        static void destruct ( counter_type type , long bytes ) { update ( type , -1 , -bytes ); }
+
+        /// Count a change of memory of an instance.
+        /**
+         \param type  The counted class -- \b IN.
+         \param bytes Bytes allocated (> 0) or freed (< 0) -- \b IN.
+         */
+        static void resize ( counter_type type , long bytes ) { update ( type , 0 , bytes ); }
+
+        /// Access to the number of live instances.
+        /**
+         \param type The counted class -- \b IN.
+         \return The number of instances in memory, in all threads.
+         */
+        static long get_live ( counter_type type );
+
+        /// Access to the peak number of instances.
+        /**
+         \param type The counted class -- \b IN.
+         \return The max number of instances in memory.
+         */
+        static long get_peak ( counter_type type );
+
+        /// Access to the live bytes.
+        /**
+         \param type The counted class -- \b IN.
+         \return The memory used by the instances in memory, in bytes.
+         */
+        static long get_bytes ( counter_type type );
+
+        /// Display of all counters.
+        /**
+         \param out The output stream -- \b IN.
+         */
+        static void display ( std::ostream & out );
+    };
+
+#include "nomad_nsend.hpp"
+
+#endif
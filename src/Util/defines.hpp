@@ -27,6 +27,19 @@
 #endif
 #endif
 
+// define in order to remove the per-operation checks of NOMAD::Double:
+// undefined values then propagate like NaN, and must be validated by batch
+// with NOMAD::Double::check_defined(). Must be the same for the library and
+// for the code that uses it.
+//#define UNCHECKED_DOUBLE
+
+// Max dimension of the points that store their coordinates inline, without
+// heap allocation (see NOMAD::Point). Must be the same for the library and
+// for the code that uses it.
+#ifndef POINT_SMALL_SIZE
+#define POINT_SMALL_SIZE 10
+#endif
+
 
 // CASE Linux using gnu compiler   
 #ifdef __gnu_linux__
@@ -54,6 +67,26 @@
 #pragma warning(disable:4996)
 #endif
 
+// For functions that never return, such as the functions that throw
+// exceptions on behalf of inline code
+#if defined(__GNUC__)
+#define NOMAD_NORETURN __attribute__((noreturn))
+#elif defined(_MSC_VER)
+#define NOMAD_NORETURN __declspec(noreturn)
+#else
+#define NOMAD_NORETURN
+#endif
+
+// For thread-local variables with a constant initializer.
+// The default TLS model is kept so that the shared library can be dlopen'ed.
+#if defined(__GNUC__)
+#define NOMAD_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define NOMAD_THREAD_LOCAL __declspec(thread)
+#else
+#define NOMAD_THREAD_LOCAL thread_local
+#endif
+
 // For NOMAD random number generator 
 #if !defined(UINT32_MAX)
 typedef unsigned int uint32_t;
@@ -76,9 +109,16 @@ typedef unsigned int uint32_t;
 	
 	/// Default epsilon used by NOMAD::Double
 	/** Use Parameters::set_EPSILON(), or parameter EPSILON,
-	 or NOMAD::Double::set_epsilon() to change it
+	 or NOMAD::Double::set_epsilon() to change it,
+	 or a NOMAD::DoubleContext to change it for one thread
 	 */
 	const double DEFAULT_EPSILON = 1e-13;
+
+	/// Default quantum used by NOMAD::PointHash
+	/** Coordinates are hashed by cells of this width. It must stay well
+	 above the epsilon of NOMAD::Double.
+	 */
+	const double DEFAULT_HASH_QUANTUM = 1e-8;
 	
 	/// Default infinity string used by NOMAD::Double
 	/** Use Parameters::set_INF_STR(), or parameter INF_STR,
@@ -109,6 +149,21 @@ typedef unsigned int uint32_t;
         BINARY            ///< Binary variable               (B)
     };
 
+    /// Norm type
+    enum hnorm_type
+    {
+        L1   ,   ///< norm L1
+        L2   ,   ///< norm L2
+        LINF     ///< norm Linf
+    };
+
+    /// Storage layout of a set of points (see NOMAD::PointSet)
+    enum storage_layout
+    {
+        AOS  ,   ///< Array of structures: the coordinates of a point are contiguous
+        SOA      ///< Structure of arrays: the values of a coordinate are contiguous
+    };
+
     /// Blackbox outputs type
     enum bb_output_type
     {
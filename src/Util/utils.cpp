@@ -5,6 +5,8 @@
  \date   March 2017
  \see    utils.hpp
  */
+#include <cstdio>
+
 #include "utils.hpp"
 
 /*----------------------------------------------------------------------*/
@@ -29,9 +31,9 @@ int NOMAD::string_to_bool ( const std::string & ss )
 /*-----------------------------------------------------------------*/
 std::string NOMAD::itos ( const int i )
 {
-    std::ostringstream oss;
-    oss << i;
-    return oss.str();
+    char buf[16];
+    snprintf ( buf , sizeof(buf) , "%d" , i );
+    return buf;
 }
 
 /*-----------------------------------------------------------------*/
@@ -106,3 +108,30 @@ bool NOMAD::atoi ( const char c , int & i )
 }
 
 
+
+std::string NOMAD::bbot_to_string ( NOMAD::bb_output_type bbot )
+{
+    switch ( bbot )
+    {
+        case NOMAD::OBJ:
+            return "OBJ";
+        case NOMAD::EB:
+            return "EB";
+        case NOMAD::PB:
+            return "PB";
+        case NOMAD::PEB_P:
+            return "PEB_P";
+        case NOMAD::PEB_E:
+            return "PEB_E";
+        case NOMAD::FILTER:
+            return "F";
+        case NOMAD::CNT_EVAL:
+            return "CNT_EVAL";
+        case NOMAD::STAT_AVG:
+            return "STAT_AVG";
+        case NOMAD::STAT_SUM:
+            return "STAT_SUM";
+        default:
+            return "NOTHING";
+    }
+}
@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <list>
+#include <stdint.h>
 
 #include "Util/defines.hpp"
 
@@ -66,6 +67,25 @@
      */
     bool atoi ( const char c , int & i );
     
+    /// Convert a blackbox output type into a string.
+    /**
+     \param bbot The blackbox output type -- \b IN.
+     \return     The name of the type, as in parameter BB_OUTPUT_TYPE.
+     */
+    std::string bbot_to_string ( NOMAD::bb_output_type bbot );
+    
+    /// splitmix64 finalizer: a bijection of 64-bit integers with a good avalanche.
+    /**
+     \param h The integer -- \b IN.
+     \return  The mixed integer.
+     */
+    inline uint64_t mix ( uint64_t h )
+    {
+        h = ( h ^ ( h >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        h = ( h ^ ( h >> 27 ) ) * 0x94D049BB133111EBULL;
+        return h ^ ( h >> 31 );
+    }
+    
 #include "nomad_nsend.hpp"
 
 #endif
@@ -0,0 +1,43 @@
+// Write a binary cache file (see NOMAD::CacheFile) as text, for debugging.
+//
+// Usage: cache_export cache_file [text_file]
+// The text is written on the standard output when there is no text file.
+
+#include <fstream>
+#include <iostream>
+
+#include "Cache/CacheFile.hpp"
+#include "Util/Exception.hpp"
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "usage: " << argv[0] << " cache_file [text_file]" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        NOMAD::CacheFile file;
+        file.open(argv[1], true);
+        if (argc == 3)
+        {
+            std::ofstream out(argv[2]);
+            if (!out)
+            {
+                std::cerr << argv[0] << ": cannot write file " << argv[2] << std::endl;
+                return 1;
+            }
+            file.export_text(out);
+        }
+        else
+            file.export_text(std::cout);
+    }
+    catch (NOMAD::Exception & e)
+    {
+        std::cerr << argv[0] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+#include "Math/Point.hpp"
+#include "Math/Vector.hpp"
+#include "Param/Parameters.hpp"
+#include "gtest/gtest.h"
+
+
+// Count every call to the global operator new made by this test program.
+static size_t nb_allocations = 0;
+
+void * operator new ( size_t size )
+{
+    ++nb_allocations;
+    void * p = std::malloc ( size ? size : 1 );
+    if ( !p )
+        throw std::bad_alloc();
+    return p;
+}
+
+void * operator new[] ( size_t size )
+{
+    return operator new ( size );
+}
+
+void operator delete ( void * p ) noexcept
+{
+    std::free ( p );
+}
+
+void operator delete[] ( void * p ) noexcept
+{
+    std::free ( p );
+}
+
+void operator delete ( void * p , size_t ) noexcept
+{
+    std::free ( p );
+}
+
+void operator delete[] ( void * p , size_t ) noexcept
+{
+    std::free ( p );
+}
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests that the copy-free paths of Point, Vector, Param, ParamValue
+// and Parameters do not allocate.
+
+// Moves and swaps of Point and Vector
+TEST(AllocationTest, PointVector) {
+    // Large enough to live on the heap.
+    const int n = 3 * NOMAD::Point::SMALL_SIZE;
+
+    NOMAD::Point x ( n , 1.0 ) , y ( n , 2.0 );
+    NOMAD::Vector v ( x , y ) , w ( y , x );
+
+    size_t before = nb_allocations;
+    NOMAD::Point z ( std::move ( x ) );
+    x = std::move ( y );
+    swap ( x , z );
+    x.swap ( z );
+    NOMAD::Vector u ( std::move ( v ) );
+    v = std::move ( w );
+    swap ( u , v );
+    EXPECT_EQ ( 0u , nb_allocations - before );
+    EXPECT_EQ ( n , x.get_size() );
+    EXPECT_EQ ( 2.0 , x[0] );
+    EXPECT_EQ ( 1.0 , z[0] );
+
+    // Getters return references and the norm is computed in place.
+    before = nb_allocations;
+    const NOMAD::Point & ip = u.get_initialPoint();
+    const NOMAD::Point & ep = u.get_endPoint();
+    NOMAD::Double norm = u.norm();
+    EXPECT_EQ ( 0u , nb_allocations - before );
+    EXPECT_EQ ( n , ip.get_size() );
+    EXPECT_EQ ( n , ep.get_size() );
+    EXPECT_TRUE ( norm > 0.0 );
+
+    // Growing a std::vector moves its Points: only the buffers of the
+    // std::vector itself are allocated.
+    std::vector<NOMAD::Point> points;
+    for ( int i = 0 ; i < 4 ; ++i )
+        points.push_back ( NOMAD::Point ( n , i ) );
+    before = nb_allocations;
+    size_t nb_growths = 0;
+    size_t capacity = points.capacity();
+    for ( int i = 0 ; i < 100 ; ++i )
+    {
+        NOMAD::Point p ( n , i );
+        size_t before_push = nb_allocations;
+        points.push_back ( std::move ( p ) );
+        EXPECT_TRUE ( nb_allocations - before_push <= 1u );
+        if ( points.capacity() != capacity )
+        {
+            capacity = points.capacity();
+            ++nb_growths;
+        }
+    }
+    // 100 coordinate arrays plus one buffer per growth.
+    EXPECT_EQ ( 100u + nb_growths , nb_allocations - before );
+}
+
+// Moves and swaps of Param and ParamValue, and Parameters lookups
+TEST(AllocationTest, Parameters) {
+    // Names and values longer than any small string buffer.
+    const std::string name1 = "A_PARAMETER_WITH_A_LONG_NAME";
+    const std::string name2 = "another_parameter_with_a_long_name";
+    const std::string name3 = "Yet_Another_Parameter_With_A_Long_Name";
+
+    NOMAD::ParamValue pv1 ( std::string ( "a string value longer than the buffer" ) );
+    NOMAD::ParamValue pv2 ( 12 );
+    NOMAD::Param p1 ( name1 , 3.5 );
+    NOMAD::Param p2 ( name2 , "another string value longer than the buffer" );
+
+    size_t before = nb_allocations;
+    NOMAD::ParamValue pv3 ( std::move ( pv1 ) );
+    pv1 = std::move ( pv2 );
+    swap ( pv1 , pv3 );
+    NOMAD::Param p3 ( std::move ( p1 ) );
+    p1 = std::move ( p2 );
+    swap ( p1 , p3 );
+    EXPECT_EQ ( 0u , nb_allocations - before );
+    EXPECT_EQ ( "a string value longer than the buffer" , pv1.get_value_str() );
+    EXPECT_EQ ( 12 , pv3.get_value_int() );
+
+    NOMAD::Parameters params;
+    params.add ( p1 );
+    params.add ( p3 );
+    params.add ( NOMAD::Param ( name3 , true ) );
+    params.add ( NOMAD::Param ( "INT_PARAMETER_WITH_A_LONG_NAME" , 42 ) );
+    const std::string name4 = "int_parameter_with_a_long_name";
+    const std::string undefined_name = "NOT_A_PARAMETER_NAME_EITHER_AT_ALL";
+
+    before = nb_allocations;
+    EXPECT_TRUE  ( params.is_defined ( name1 ) );
+    EXPECT_TRUE  ( params.is_defined ( name2 ) );
+    EXPECT_FALSE ( params.is_defined ( undefined_name ) );
+    EXPECT_EQ    ( 3.5  , params.get_value_double ( name1 ) );
+    EXPECT_EQ    ( true , params.get_value_bool   ( name3 ) );
+    EXPECT_EQ    ( 42   , params.get_value_int    ( name4 ) );
+    EXPECT_EQ ( 0u , nb_allocations - before );
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
@@ -0,0 +1,163 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "Cache/CacheFile.hpp"
+#include "Math/Point.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Name of a temporary file in the current directory.
+std::string temp_file_name(const std::string & name)
+{
+    std::ostringstream oss;
+    oss << name << "." << getpid() << ".tmp";
+    return oss.str();
+}
+
+// Are two values identical, bit by bit ?
+bool same_bits(const NOMAD::Double & d1, const NOMAD::Double & d2)
+{
+    return 0 == memcmp(&d1, &d2, sizeof(NOMAD::Double));
+}
+
+// Tests CacheFile class.
+
+// Records written, read back after closing, and appended after reopening
+TEST(CacheFileTest, Records) {
+    // This test is named "Records", and belongs to the "CacheFileTest"
+    // test case.
+
+    const std::string file_name = temp_file_name("cachefile_records");
+    const int n = 7, p = 3000;
+    std::vector<NOMAD::bb_output_type> bbot;
+    bbot.push_back(NOMAD::OBJ);
+    bbot.push_back(NOMAD::PB);
+    bbot.push_back(NOMAD::EB);
+    const int m = static_cast<int>(bbot.size());
+
+    NOMAD::RNG::set_seed(5);
+    NOMAD::PointSet points(p, n), outputs(p, m);
+    for (int j = 0; j < p; j++)
+    {
+        for (int i = 0; i < n; i++)
+            points(j,i) = NOMAD::RNG::rand(-10.0, 10.0);
+        outputs(j,0) = NOMAD::RNG::rand(0.0, 1.0);
+        outputs(j,1) = -j;
+        // outputs(j,2) is undefined
+    }
+
+    NOMAD::CacheFile file;
+    EXPECT_FALSE(file.is_open());
+    file.create(file_name, n, bbot, 1e-10);
+    EXPECT_TRUE(file.is_open());
+    EXPECT_EQ(0, file.size());
+    for (int j = 0; j < p / 2; j++)
+        EXPECT_EQ(j, file.append(points.row(j), outputs.row(j)));
+    EXPECT_ANY_THROW(file.append(points.row(0), points.row(0)));
+    file.close();
+    EXPECT_FALSE(file.is_open());
+
+    // Reopen and append
+    file.open(file_name);
+    EXPECT_EQ(n, file.get_dimension());
+    EXPECT_EQ(m, file.get_nb_outputs());
+    EXPECT_EQ(1e-10, file.get_epsilon());
+    EXPECT_TRUE(bbot == file.get_bb_output_type());
+    EXPECT_EQ(p / 2, file.size());
+    for (int j = p / 2; j < p; j++)
+        EXPECT_EQ(j, file.append(points.row(j), outputs.row(j)));
+    file.close();
+
+    // Read only
+    file.open(file_name, true);
+    EXPECT_TRUE(file.is_read_only());
+    ASSERT_EQ(p, file.size());
+    for (int j = 0; j < p; j++)
+    {
+        for (int i = 0; i < n; i++)
+            EXPECT_TRUE(same_bits(points(j,i), file.get_point(j)[i]));
+        for (int i = 0; i < m; i++)
+            EXPECT_TRUE(same_bits(outputs(j,i), file.get_outputs(j)[i]));
+    }
+    EXPECT_FALSE(file.get_outputs(0)[2].is_defined());
+    EXPECT_ANY_THROW(file.append(points.row(0), outputs.row(0)));
+
+    // Warm start of a cache
+    NOMAD::EvalCache cache(n, m);
+    EXPECT_EQ(p, file.load(cache));
+    EXPECT_EQ(0, file.load(cache));
+    NOMAD::PointView f;
+    EXPECT_TRUE(cache.find(points.row(p - 1), f));
+    EXPECT_EQ(outputs(p - 1,1), f[1]);
+    file.close();
+
+    // A crash after the file has grown: the free space is ignored
+    {
+        NOMAD::CacheFile other;
+        other.open(file_name);
+        for (int j = 0; j < 10; j++)
+            other.append(points.row(j), outputs.row(j));
+        NOMAD::CacheFile reader;
+        reader.open(file_name, true);
+        EXPECT_EQ(p + 10, reader.size());
+    }
+
+    std::remove(file_name.c_str());
+}
+
+// Bad files, and text export
+TEST(CacheFileTest, Files) {
+    const std::string file_name = temp_file_name("cachefile_files");
+    std::vector<NOMAD::bb_output_type> bbot(1, NOMAD::OBJ);
+    bbot.push_back(NOMAD::FILTER);
+
+    NOMAD::CacheFile file;
+    EXPECT_ANY_THROW(file.open(file_name));
+    EXPECT_ANY_THROW(file.create(file_name, 0, bbot));
+    EXPECT_FALSE(file.is_open());
+
+    // Text export
+    file.create(file_name, 2, bbot, 1e-13);
+    NOMAD::Point x(2), f(2);
+    x[0] = 0.1;
+    x[1] = -3;
+    f[0] = 1.0 / 3.0;
+    file.append(x, f);
+    std::ostringstream oss;
+    file.export_text(oss);
+    EXPECT_EQ("# NOMAD cache file version 1\n"
+              "# DIMENSION 2\n"
+              "# BB_OUTPUT_TYPE OBJ F\n"
+              "# EPSILON 1e-13\n"
+              "# RECORDS 1\n"
+              "( 0.1 -3 ) 0.3333333333333333 NaN\n", oss.str());
+    file.close();
+
+    // Corrupted header
+    {
+        std::fstream fs(file_name.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(0);
+        fs.put('X');
+    }
+    EXPECT_ANY_THROW(file.open(file_name));
+    EXPECT_FALSE(file.is_open());
+
+    // Truncated file
+    {
+        std::ofstream fs(file_name.c_str(), std::ios::binary | std::ios::trunc);
+        fs << "NOMADCF";
+    }
+    EXPECT_ANY_THROW(file.open(file_name, true));
+
+    std::remove(file_name.c_str());
+}
@@ -0,0 +1,145 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <limits>
+#include "Math/Compare.hpp"
+#include "Math/Point.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests Compare class.
+
+// Results of the comparisons, with the exceptions on undefined values.
+enum { IS_FALSE, IS_TRUE, NOT_DEFINED };
+
+// Reference: the scalar loops of Point::operator==() and operator<().
+int ref_equal(const NOMAD::Point & x, const NOMAD::Point & y)
+{
+    try
+    {
+        if (x.get_size() != y.get_size())
+            return IS_FALSE;
+        for (int k = 0; k < x.get_size(); ++k)
+            if (x[k] != y[k])
+                return IS_FALSE;
+        return IS_TRUE;
+    }
+    catch (NOMAD::Double::Not_Defined &)
+    {
+        return NOT_DEFINED;
+    }
+}
+
+int ref_less(const NOMAD::Point & x, const NOMAD::Point & y)
+{
+    try
+    {
+        if (x.get_size() != y.get_size())
+            return (x.get_size() < y.get_size()) ? IS_TRUE : IS_FALSE;
+        for (int k = 0; k < x.get_size(); ++k)
+        {
+            if (x[k] < y[k])
+                return IS_TRUE;
+            if (x[k] > y[k])
+                return IS_FALSE;
+        }
+        return IS_FALSE;
+    }
+    catch (NOMAD::Double::Not_Defined &)
+    {
+        return NOT_DEFINED;
+    }
+}
+
+int test_equal(const NOMAD::Point & x, const NOMAD::Point & y)
+{
+    try
+    {
+        return (x == y) ? IS_TRUE : IS_FALSE;
+    }
+    catch (NOMAD::Double::Not_Defined &)
+    {
+        return NOT_DEFINED;
+    }
+}
+
+int test_less(const NOMAD::Point & x, const NOMAD::Point & y)
+{
+    try
+    {
+        return (x < y) ? IS_TRUE : IS_FALSE;
+    }
+    catch (NOMAD::Double::Not_Defined &)
+    {
+        return NOT_DEFINED;
+    }
+}
+
+// Differential test of the kernels against the scalar loops
+TEST(CompareTest, Differential) {
+    // This test is named "Differential", and belongs to the "CompareTest"
+    // test case.
+
+    const double eps = NOMAD::Double::get_epsilon();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    const NOMAD::Compare::isa_type isas[] = { NOMAD::Compare::SCALAR,
+                                              NOMAD::Compare::SSE2,
+                                              NOMAD::Compare::AVX2 };
+    const NOMAD::Compare::isa_type best = NOMAD::Compare::get_isa();
+    EXPECT_EQ(NOMAD::Compare::get_best_isa(), best);
+
+    for (int t = 0; t < 3; t++)
+    {
+        NOMAD::Compare::isa_type isa = NOMAD::Compare::set_isa(isas[t]);
+        EXPECT_LE(isa, isas[t]);
+        EXPECT_EQ(isa, NOMAD::Compare::get_isa());
+
+        NOMAD::RNG::set_seed(17);
+        for (int r = 0; r < 20000; r++)
+        {
+            // Mostly equal points, with a few perturbed coordinates
+            int n = static_cast<int>(NOMAD::RNG::rand(0.0, 20.0));
+            NOMAD::Point x(n), y(n);
+            for (int i = 0; i < n; i++)
+            {
+                x[i] = NOMAD::RNG::rand(-1.0, 1.0);
+                y[i] = x[i];
+            }
+            int nb_changes = static_cast<int>(NOMAD::RNG::rand(0.0, 3.0));
+            for (int c = 0; c < nb_changes && n > 0; c++)
+            {
+                int i = static_cast<int>(NOMAD::RNG::rand(0.0, n - 0.5));
+                NOMAD::Point & z = (NOMAD::RNG::rand() % 2) ? x : y;
+                if (!z[i].is_defined())
+                    continue;
+                switch (NOMAD::RNG::rand() % 9)
+                {
+                    case 0: z[i] = z[i].todouble() + 0.5 * eps; break;
+                    case 1: z[i] = z[i].todouble() - 2.0 * eps; break;
+                    case 2: z[i] = z[i].todouble() + 2.0 * eps; break;
+                    case 3: z[i] = NOMAD::Double(); break;
+                    case 4: z[i] = nan; break;
+                    case 5: z[i] = inf; break;
+                    case 6: x[i] = y[i] = -inf; break;
+                    case 7: z[i] = NOMAD::RNG::rand(-1.0, 1.0); break;
+                    default: z[i] = 0.0; break;
+                }
+            }
+            ASSERT_EQ(ref_equal(x, y), test_equal(x, y)) << "isa " << isa << ": " << x << " / " << y;
+            ASSERT_EQ(ref_less(x, y), test_less(x, y)) << "isa " << isa << ": " << x << " / " << y;
+            ASSERT_EQ(ref_less(y, x), test_less(y, x)) << "isa " << isa << ": " << y << " / " << x;
+        }
+    }
+    NOMAD::Compare::set_isa(best);
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
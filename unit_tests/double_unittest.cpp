@@ -4,6 +4,15 @@
 //
 // Don't forget gtest.h, which declares the testing framework.
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <iomanip>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "Math/Double.hpp"
 #include "gtest/gtest.h"
 
@@ -24,6 +33,439 @@ TEST(DoubleTest, Basic) {
 
 }
 
+// Layout of Double: undefined is stored as a reserved NaN, no flag.
+TEST(DoubleTest, Layout) {
+
+    EXPECT_EQ(sizeof(double), sizeof(NOMAD::Double));
+    NOMAD::Double d;
+    EXPECT_EQ((int)sizeof(double), d.mem_sizeof());
+#ifndef MEMORY_DEBUG
+    EXPECT_TRUE(std::is_trivially_copyable<NOMAD::Double>::value);
+#endif
+
+    // An array of Doubles has no padding.
+    NOMAD::Double arr[4];
+    EXPECT_EQ(4 * sizeof(double), sizeof(arr));
+
+    // Undefined value bit pattern.
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    EXPECT_EQ(NOMAD::Double::UNDEF_BITS, bits);
+    EXPECT_TRUE(NOMAD::Double::is_undef_value(NOMAD::Double::undef_value()));
+
+    // Undefinedness survives a raw copy.
+    NOMAD::Double d2 = 2.5;
+    std::memcpy(static_cast<void*>(&d2), &d, sizeof(d));
+    EXPECT_FALSE(d2.is_defined());
+}
+
+// Undefined values.
+TEST(DoubleTest, Undefined) {
+
+    NOMAD::Double d;
+    EXPECT_FALSE(d.is_defined());
+    EXPECT_EQ(NOMAD::DEFAULT_UNDEF_STR, d.tostring());
+    EXPECT_THROW(d.todouble(), NOMAD::Double::Not_Defined);
+
+    d = 1.5;
+    EXPECT_TRUE(d.is_defined());
+    EXPECT_EQ(1.5, d.todouble());
+    d.clear();
+    EXPECT_FALSE(d.is_defined());
+
+    // A NaN that is not the reserved undefined value is defined.
+    NOMAD::Double dnan = NOMAD::NaN;
+    EXPECT_TRUE(dnan.is_defined());
+
+    // Arithmetic on undefined values throws.
+    NOMAD::Double one = 1.0;
+    NOMAD::Double undef;
+    EXPECT_THROW(one += undef, NOMAD::Double::Not_Defined);
+    EXPECT_THROW(undef *= one, NOMAD::Double::Not_Defined);
+    EXPECT_THROW(undef.abs(), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(undef.sqrt(), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(undef == one, NOMAD::Double::Not_Defined);
+
+    // comp_with_undef: undefined values come first.
+    NOMAD::Double two = 2.0;
+    EXPECT_TRUE (undef.comp_with_undef(one));
+    EXPECT_FALSE(one.comp_with_undef(undef));
+    EXPECT_FALSE(undef.comp_with_undef(NOMAD::Double()));
+    EXPECT_TRUE (one.comp_with_undef(two));
+    EXPECT_FALSE(two.comp_with_undef(one));
+
+    // atof of the undefined strings.
+    NOMAD::Double d3 = 3.0;
+    EXPECT_TRUE(d3.atof("-"));
+    EXPECT_FALSE(d3.is_defined());
+    d3 = 3.0;
+    EXPECT_TRUE(d3.atof(NOMAD::DEFAULT_UNDEF_STR));
+    EXPECT_FALSE(d3.is_defined());
+}
+
+// Inline arithmetic and batch validation.
+TEST(DoubleTest, Arithmetic) {
+
+    NOMAD::Double a = 3.0, b = 4.0;
+    NOMAD::Double c = a;
+    c += b;
+    EXPECT_EQ(7.0, c.todouble());
+    c -= a;
+    EXPECT_EQ(4.0, c.todouble());
+    c *= b;
+    EXPECT_EQ(16.0, c.todouble());
+    c /= b;
+    EXPECT_EQ(4.0, c.todouble());
+    EXPECT_EQ(5.0, (a.pow2() + b.pow2()).sqrt().todouble());
+    EXPECT_EQ(3.0, (-a).abs().todouble());
+    EXPECT_EQ(0.75, (a / b).todouble());
+    EXPECT_THROW(a / 0.0, NOMAD::Double::Invalid_Value);
+    EXPECT_THROW(c /= 0.0, NOMAD::Double::Invalid_Value);
+    EXPECT_THROW(NOMAD::Double(-1.0).sqrt(), NOMAD::Double::Invalid_Value);
+
+    // Batch validation.
+    NOMAD::Double x[4] = { 1.0, 2.0, 3.0, 4.0 };
+    EXPECT_NO_THROW(NOMAD::Double::check_defined(x, x + 4));
+    EXPECT_NO_THROW(x[3].check_defined());
+    x[2].clear();
+    EXPECT_THROW(NOMAD::Double::check_defined(x, x + 4), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(x[2].check_defined(), NOMAD::Double::Not_Defined);
+    EXPECT_NO_THROW(NOMAD::Double::check_defined(x, x + 2));
+}
+
+// Display of a Double before the allocation-free formatting, for reference.
+static void stream_display(std::ostream& os, const NOMAD::Double& d)
+{
+    if (d.is_defined())
+    {
+        double value = d.todouble();
+        if (value == NOMAD::INF)
+            os << NOMAD::Double::get_inf_str();
+        else if (value == -NOMAD::INF)
+            os << "-" << NOMAD::Double::get_inf_str();
+        else if (std::floor(value) == std::ceil(value) && fabs(value) < INT_MAX-1)
+            os << static_cast<int>(value);
+        else
+            os << value;
+    }
+    else
+        os << NOMAD::Double::get_undef_str();
+}
+
+// tostring() before the allocation-free formatting, for reference.
+static std::string stream_tostring(const NOMAD::Double& d)
+{
+    if (!d.is_defined())
+        return NOMAD::Double::get_undef_str();
+    if (d.todouble() == NOMAD::INF)
+        return NOMAD::Double::get_inf_str();
+    if (d.todouble() == -NOMAD::INF)
+        return "-" + NOMAD::Double::get_inf_str();
+    std::stringstream ss;
+    ss << d.todouble();
+    return ss.str();
+}
+
+// Formatting is byte-compatible with the std::ostream formatting.
+TEST(DoubleTest, Format) {
+
+    std::vector<NOMAD::Double> values;
+    values.push_back(NOMAD::Double());
+    values.push_back(NOMAD::INF);
+    values.push_back(-NOMAD::INF);
+    values.push_back(NOMAD::NaN);
+    values.push_back(0.0);
+    values.push_back(-0.0);
+    values.push_back(1.0);
+    values.push_back(-17.0);
+    values.push_back(0.1);
+    values.push_back(3.14159265358979323);
+    values.push_back(1234567.0);
+    values.push_back(INT_MAX);
+    values.push_back(1e100);
+    values.push_back(-2.5e-300);
+    values.push_back(4.9e-324);
+    values.push_back(std::numeric_limits<double>::infinity());
+    std::srand(1234);
+    for (int i = 0; i < 2000; i++)
+    {
+        double mantissa = (double)std::rand() / RAND_MAX - 0.5;
+        int exponent = std::rand() % 40 - 20;
+        values.push_back(mantissa * std::pow(10.0, exponent));
+        values.push_back(std::floor(mantissa * 1e6));
+    }
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        const NOMAD::Double& d = values[i];
+        std::string expected = stream_tostring(d);
+        EXPECT_EQ(expected, d.tostring());
+
+        char buf[NOMAD::Double::STR_SIZE];
+        int n = d.snprint(buf, sizeof(buf));
+        EXPECT_EQ(expected, std::string(buf));
+        EXPECT_EQ((int)expected.size(), n);
+
+        std::string appended = "x=";
+        d.append_to(appended);
+        EXPECT_EQ("x=" + expected, appended);
+
+        // operator<<, with default, width and precision settings.
+        std::ostringstream oss1, oss2;
+        oss1 << d << " " << std::setw(12) << d << " " << std::setprecision(12) << d;
+        stream_display(oss2, d);
+        oss2 << " " << std::setw(12);
+        stream_display(oss2, d);
+        oss2 << " " << std::setprecision(12);
+        stream_display(oss2, d);
+        EXPECT_EQ(oss2.str(), oss1.str());
+
+        // operator<< with a non-default format.
+        std::ostringstream oss3, oss4;
+        oss3 << std::scientific << d;
+        oss4 << std::scientific;
+        stream_display(oss4, d);
+        EXPECT_EQ(oss4.str(), oss3.str());
+
+        // int_display is the same as operator<<.
+        std::ostringstream oss5;
+        stream_display(oss5, d);
+        d.snprint(buf, sizeof(buf), true);
+        EXPECT_EQ(oss5.str(), std::string(buf));
+    }
+
+    // Truncation, as snprintf.
+    char small[4];
+    NOMAD::Double pi = 3.14159265358979323;
+    EXPECT_EQ(7, pi.snprint(small, sizeof(small)));
+    EXPECT_EQ(std::string("3.1"), std::string(small));
+
+    // Shortest round-trip digits.
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (!values[i].is_defined() || values[i].is_nan())
+            continue;
+        double v = values[i].todouble();
+        char buf[NOMAD::Double::STR_SIZE];
+        NOMAD::Double::snprint_double(buf, sizeof(buf), v, NOMAD::Double::SHORTEST_PRECISION);
+        EXPECT_EQ(v, std::strtod(buf, NULL));
+    }
+    char buf[NOMAD::Double::STR_SIZE];
+    NOMAD::Double::snprint_double(buf, sizeof(buf), 0.1, NOMAD::Double::SHORTEST_PRECISION);
+    EXPECT_EQ(std::string("0.1"), std::string(buf));
+    NOMAD::Double::snprint_double(buf, sizeof(buf), 0.1+0.2, NOMAD::Double::SHORTEST_PRECISION);
+    EXPECT_EQ(std::string("0.30000000000000004"), std::string(buf));
+    NOMAD::Double::snprint_double(buf, sizeof(buf), pi.todouble(), NOMAD::Double::SHORTEST_PRECISION);
+    EXPECT_EQ(std::string("3.141592653589793"), std::string(buf));
+}
+
+// Parsing values from strings and from ranges of characters.
+TEST(DoubleTest, Parse) {
+
+    NOMAD::Double d;
+
+    // Valid strings for atof.
+    EXPECT_TRUE(d.atof("1.5"));     EXPECT_EQ(1.5, d.todouble());
+    EXPECT_TRUE(d.atof("-2"));      EXPECT_EQ(-2.0, d.todouble());
+    EXPECT_TRUE(d.atof("+.25"));    EXPECT_EQ(0.25, d.todouble());
+    EXPECT_TRUE(d.atof("1e3"));     EXPECT_EQ(1000.0, d.todouble());
+    EXPECT_TRUE(d.atof("1E-3"));    EXPECT_EQ(0.001, d.todouble());
+    EXPECT_TRUE(d.atof("7"));       EXPECT_EQ(7.0, d.todouble());
+    EXPECT_TRUE(d.atof("inf"));     EXPECT_EQ(NOMAD::INF, d.todouble());
+    EXPECT_TRUE(d.atof("+Inf"));    EXPECT_EQ(NOMAD::INF, d.todouble());
+    EXPECT_TRUE(d.atof("-INF"));    EXPECT_EQ(-NOMAD::INF, d.todouble());
+    EXPECT_TRUE(d.atof("-"));       EXPECT_FALSE(d.is_defined());
+    EXPECT_TRUE(d.atof("NaN"));     EXPECT_FALSE(d.is_defined());
+
+    // Invalid strings: the value is unchanged.
+    d = 4.0;
+    EXPECT_FALSE(d.atof(""));
+    EXPECT_FALSE(d.atof("+"));
+    EXPECT_FALSE(d.atof("."));
+    EXPECT_FALSE(d.atof("a1"));
+    EXPECT_FALSE(d.atof("1a"));
+    EXPECT_FALSE(d.atof("1e"));
+    EXPECT_FALSE(d.atof("1ex"));
+    EXPECT_FALSE(d.atof(" 1"));
+    EXPECT_FALSE(d.atof("1 2"));
+    EXPECT_FALSE(d.atof("nan"));
+    EXPECT_EQ(4.0, d.todouble());
+
+    // Relative values.
+    bool relative = false;
+    EXPECT_TRUE(d.relative_atof("r0.5", relative));
+    EXPECT_TRUE(relative);
+    EXPECT_EQ(0.5, d.todouble());
+    EXPECT_FALSE(d.relative_atof("R-0.5", relative));
+    EXPECT_TRUE(d.relative_atof("0.5", relative));
+    EXPECT_FALSE(relative);
+
+    // Parse a line of coordinates in place. The buffer is not null-terminated.
+    std::string line = "  1.5\t-2 inf - NaN 3e2 r0.25 xyz";
+    const char* first = line.data();
+    const char* last  = first + line.size();
+    double expected[] = { 1.5, -2.0, NOMAD::INF, 0.0, 0.0, 300.0 };
+    bool expected_defined[] = { true, true, true, false, false, true };
+    for (int i = 0; i < 6; i++)
+    {
+        size_t n = d.parse(first, last);
+        ASSERT_LT(0u, n);
+        EXPECT_EQ(expected_defined[i], d.is_defined());
+        if (expected_defined[i])
+        {
+            EXPECT_EQ(expected[i], d.todouble());
+        }
+        first += n;
+    }
+    // The relative value is not accepted by parse(), but by relative_parse().
+    EXPECT_EQ(0u, d.parse(first, last));
+    size_t n = d.relative_parse(first, last, relative);
+    EXPECT_EQ(6u, n);
+    EXPECT_TRUE(relative);
+    EXPECT_EQ(0.25, d.todouble());
+    first += n;
+    // Invalid value, then end of range.
+    EXPECT_EQ(0u, d.parse(first, last));
+    EXPECT_EQ(0.25, d.todouble());
+    EXPECT_EQ(0u, d.parse(last, last));
+
+    // Range ending in the middle of a number.
+    std::string s2 = "12345";
+    EXPECT_EQ(3u, d.parse(s2.data(), s2.data() + 3));
+    EXPECT_EQ(123.0, d.todouble());
+
+    // Same results as atof on random numbers.
+    std::srand(4321);
+    for (int i = 0; i < 1000; i++)
+    {
+        NOMAD::Double x = ((double)std::rand() / RAND_MAX - 0.5) * std::pow(10.0, std::rand() % 20 - 10);
+        std::string sx = x.tostring();
+        NOMAD::Double d1, d2;
+        EXPECT_TRUE(d1.atof(sx));
+        EXPECT_EQ(sx.size(), d2.parse(sx.data(), sx.data() + sx.size()));
+        EXPECT_EQ(d1.todouble(), d2.todouble());
+        EXPECT_EQ(std::atof(sx.c_str()), d2.todouble());
+    }
+}
+
+// Numeric contexts: two threads compare with different epsilons concurrently.
+TEST(DoubleTest, Context) {
+
+    // The default context is used by default.
+    EXPECT_EQ(&NOMAD::Double::get_default_context(), &NOMAD::Double::get_context());
+    EXPECT_EQ(NOMAD::DEFAULT_EPSILON, NOMAD::Double::get_epsilon());
+    EXPECT_THROW(NOMAD::DoubleContext(0.0), NOMAD::Exception);
+
+    NOMAD::DoubleContext coarse(1e-3, "INFINITY", "UNDEF");
+    NOMAD::DoubleContext fine(1e-12);
+
+    std::atomic<int> ready(0);
+    const int nb_iter = 200000;
+    int nb_equal[2] = { 0, 0 };
+    std::string inf_str[2], undef_str[2];
+
+    auto worker = [&](int i, NOMAD::DoubleContext & context)
+    {
+        NOMAD::Double::Context_Scope scope(context);
+        // Start comparing when both threads are ready.
+        ready++;
+        while (ready.load() < 2)
+        {
+            std::this_thread::yield();
+        }
+        NOMAD::Double a = 1.0;
+        for (int k = 0; k < nb_iter; k++)
+        {
+            NOMAD::Double b = 1.0 + 1e-6 * (k % 100);
+            if (a == b)
+            {
+                nb_equal[i]++;
+            }
+        }
+        inf_str[i]   = NOMAD::Double(NOMAD::INF).tostring();
+        undef_str[i] = NOMAD::Double().tostring();
+    };
+
+    std::thread t1(worker, 0, std::ref(coarse));
+    std::thread t2(worker, 1, std::ref(fine));
+    t1.join();
+    t2.join();
+
+    // With epsilon=1e-3, all values are equal to 1. With epsilon=1e-12,
+    // only k % 100 == 0 is.
+    EXPECT_EQ(nb_iter, nb_equal[0]);
+    EXPECT_EQ(nb_iter / 100, nb_equal[1]);
+    EXPECT_EQ("INFINITY", inf_str[0]);
+    EXPECT_EQ("UNDEF", undef_str[0]);
+    EXPECT_EQ(NOMAD::DEFAULT_INF_STR, inf_str[1]);
+    EXPECT_EQ(NOMAD::DEFAULT_UNDEF_STR, undef_str[1]);
+
+    // The contexts of the other threads did not change this thread.
+    EXPECT_EQ(NOMAD::DEFAULT_EPSILON, NOMAD::Double::get_epsilon());
+
+    // Contexts are restored at the end of a scope, and are used for parsing.
+    {
+        NOMAD::Double::Context_Scope scope(coarse);
+        EXPECT_EQ(1e-3, NOMAD::Double::get_epsilon());
+        NOMAD::Double d;
+        EXPECT_TRUE(d.atof("-INFINITY"));
+        EXPECT_EQ(-NOMAD::INF, d.todouble());
+        NOMAD::Double::set_epsilon(1e-4);
+        EXPECT_EQ(1e-4, coarse.get_epsilon());
+    }
+    EXPECT_EQ(&NOMAD::Double::get_default_context(), &NOMAD::Double::get_context());
+    EXPECT_EQ(NOMAD::DEFAULT_EPSILON, NOMAD::Double::get_epsilon());
+}
+
+// Projection to the mesh of arrays: same results as the scalar version.
+TEST(DoubleTest, ProjectToMesh) {
+
+    const int n = 1000;
+    std::vector<NOMAD::Double> x(n), ref(n), delta(n), lb(n), ub(n);
+    std::srand(1234);
+    for (int i = 0; i < n; i++)
+    {
+        x[i]     = ((double)std::rand() / RAND_MAX - 0.5) * 100.0;
+        ref[i]   = ((double)std::rand() / RAND_MAX - 0.5) * 10.0;
+        delta[i] = std::pow(2.0, std::rand() % 10 - 5);
+        lb[i]    = -40.0 + std::rand() % 3;
+        ub[i]    =  40.0 - std::rand() % 3;
+        // Some undefined, zero and NaN values.
+        switch (i % 17)
+        {
+            case 1: x[i] = NOMAD::Double();     break;
+            case 3: ref[i] = NOMAD::Double();   break;
+            case 5: delta[i] = NOMAD::Double(); break;
+            case 7: delta[i] = 0.0;             break;
+            case 9: lb[i] = NOMAD::Double();    break;
+            case 11: ub[i] = NOMAD::Double();   break;
+            case 13: x[i] = NOMAD::NaN;         break;
+            case 15: x[i] = ub[i].todouble() + 1e-14; break;
+            case 16: x[i] = (i % 2) ? 1e17 : -3e16;   break;
+        }
+    }
+
+    // All combinations of optional arrays.
+    for (int mask = 0; mask < 8; mask++)
+    {
+        const NOMAD::Double* pref = (mask & 4) ? &ref[0] : NULL;
+        const NOMAD::Double* plb  = (mask & 2) ? &lb[0]  : NULL;
+        const NOMAD::Double* pub  = (mask & 1) ? &ub[0]  : NULL;
+
+        std::vector<NOMAD::Double> scalar(x), batch(x);
+        for (int i = 0; i < n; i++)
+        {
+            scalar[i].project_to_mesh(pref ? ref[i] : NOMAD::Double(), delta[i],
+                                      plb ? lb[i] : NOMAD::Double(),
+                                      pub ? ub[i] : NOMAD::Double());
+        }
+        NOMAD::Double::project_to_mesh(&batch[0], n, pref, &delta[0], plb, pub);
+
+        // Bitwise identical.
+        EXPECT_EQ(0, std::memcmp(&scalar[0], &batch[0], n * sizeof(NOMAD::Double)));
+    }
+}
+
 // Step 3. Call RUN_ALL_TESTS() in main().
 //
 // We do this by linking in src/gtest_main.cc file, which consists of
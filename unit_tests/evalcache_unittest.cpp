@@ -0,0 +1,120 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <set>
+#include "Cache/EvalCache.hpp"
+#include "Math/Point.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Value of the coordinate i just below the upper boundary of its cell in
+// [lo,hi], by bisection on the changes of hash.
+double boundary(const NOMAD::PointHash & hash, int n, int i, double lo, double hi)
+{
+    NOMAD::Point x(n, 0.0);
+    x[i] = lo;
+    const uint64_t h = hash(x);
+    for (int r = 0; r < 100; r++)
+    {
+        x[i] = 0.5 * (lo + hi);
+        if (hash(x) == h)
+            lo = x[i].todouble();
+        else
+            hi = x[i].todouble();
+    }
+    return lo;
+}
+
+// Tests EvalCache class.
+
+// Insertion and lookup, against a std::set
+TEST(EvalCacheTest, Basic) {
+    // This test is named "Basic", and belongs to the "EvalCacheTest"
+    // test case.
+
+    const int n = 3, m = 2;
+    NOMAD::EvalCache cache(n, m);
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(n, cache.get_dimension());
+    EXPECT_EQ(m, cache.get_nb_outputs());
+
+    // Points on a coarse grid: many duplicates
+    NOMAD::RNG::set_seed(11);
+    std::set<NOMAD::Point> ref;
+    NOMAD::Point x(n), f(m);
+    for (int r = 0; r < 5000; r++)
+    {
+        for (int i = 0; i < n; i++)
+            x[i] = static_cast<int>(NOMAD::RNG::rand(0.0, 20.0)) * 0.1;
+        f[0] = x[0] + x[1];
+        f[1] = r;
+        bool is_new = ref.insert(x).second;
+        EXPECT_EQ(is_new, cache.insert(x, f));
+    }
+    EXPECT_EQ(static_cast<int>(ref.size()), cache.size());
+
+    // All the points are found, with their first outputs
+    std::set<NOMAD::Point>::const_iterator it;
+    for (it = ref.begin(); it != ref.end(); ++it)
+    {
+        int index = cache.find(*it);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(*it, cache.get_point(index).to_point());
+        NOMAD::PointView outputs;
+        EXPECT_TRUE(cache.find(*it, outputs));
+        EXPECT_EQ((*it)[0] + (*it)[1], outputs[0]);
+    }
+
+    // Points that are not in the cache
+    x[0] = 2.5;
+    EXPECT_EQ(-1, cache.find(x));
+    EXPECT_EQ(-1, cache.find(NOMAD::Point(n - 1, 0.0)));
+    EXPECT_ANY_THROW(cache.insert(x, NOMAD::Point(m + 1, 0.0)));
+
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(-1, cache.find(*ref.begin()));
+}
+
+// Points equal to epsilon, near the boundaries of the cells
+TEST(EvalCacheTest, Epsilon) {
+    const int n = 10;
+    const double q = 1e-6;
+    const double eps = NOMAD::Double::get_epsilon();
+    NOMAD::EvalCache cache(n, 1, NOMAD::PointHash(q));
+    cache.reserve(100);
+
+    NOMAD::Point x(n), y(n), f(1, 1.0);
+    for (int r = 0; r < 100; r++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            // Half of the coordinates near a boundary
+            x[i] = (i % 2) ? boundary(cache.get_hash(), n, i, (r + i) * q, (r + i + 1) * q)
+                           : (r + i) * q;
+            y[i] = x[i].todouble() + ((r % 2) ? 0.5 : -0.5) * eps;
+        }
+        EXPECT_TRUE(cache.insert(x, f));
+        EXPECT_EQ(r, cache.find(y));
+        EXPECT_FALSE(cache.insert(y, f));
+    }
+
+    // More coordinates near a boundary than keys: full scan
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = boundary(cache.get_hash(), n, i, i * q, (i + 1) * q);
+        y[i] = x[i].todouble() + 0.5 * eps;
+    }
+    EXPECT_TRUE(cache.insert(x, f));
+    EXPECT_EQ(100, cache.find(y));
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
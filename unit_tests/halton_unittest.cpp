@@ -0,0 +1,204 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+#include "Math/Halton.hpp"
+#include "Math/Point.hpp"
+#include "Math/PointSet.hpp"
+
+#include "gtest/gtest.h"
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests the Halton sequence.
+
+// Values of the sequence
+TEST(HaltonTest, Values) {
+    // This test is named "Values", and belongs to the "HaltonTest"
+    // test case.
+
+    NOMAD::Halton halton(3, 6);
+    halton.set_scrambling(false);
+    EXPECT_EQ(3, halton.get_dimension());
+    EXPECT_EQ(6, halton.get_nb_samples());
+    EXPECT_EQ(2, halton.get_base(0));
+    EXPECT_EQ(3, halton.get_base(1));
+    EXPECT_EQ(5, halton.get_base(2));
+
+    const double x0[6] = { 0.5, 0.25, 0.75, 0.125, 0.625, 0.375 };
+    const double x1[6] = { 1.0/3, 2.0/3, 1.0/9, 4.0/9, 7.0/9, 2.0/9 };
+    const double x2[6] = { 0.2, 0.4, 0.6, 0.8, 0.04, 0.24 };
+    NOMAD::PointSet points;
+    halton.Sample(points);
+    ASSERT_EQ(6, points.get_nb_points());
+    for (int k = 0; k < 6; k++)
+    {
+        EXPECT_EQ(x0[k], points(k,0).todouble());
+        EXPECT_EQ(x1[k], points(k,1).todouble());
+        EXPECT_EQ(x2[k], points(k,2).todouble());
+    }
+
+    // The first b^m-1 samples of each coordinate are distinct multiples
+    // of b^-m, except 0. With scrambling, they are shifted by the same
+    // value: the digits of position m and more are all zero.
+    const int n = 30;
+    NOMAD::Halton halton_n(n, 12167 - 1);   // 23^3-1
+    for (int scrambling = 0; scrambling < 2; scrambling++)
+    {
+        halton_n.set_scrambling(scrambling == 1);
+        halton_n.Sample(points);
+        for (int i = 0; i < 9; i++)
+        {
+            const int b = halton_n.get_base(i);
+            int bm = 1;
+            while (bm * b <= points.get_nb_points() + 1)
+                bm *= b;
+            double v_min = 1.0;
+            for (int k = 0; k < bm - 1; k++)
+            {
+                ASSERT_GE(points(k,i).todouble(), 0.0);
+                ASSERT_LT(points(k,i).todouble(), 1.0);
+                v_min = std::min(v_min, points(k,i).todouble());
+            }
+            const double shift = (scrambling == 1) ? v_min - std::floor(v_min * bm) / bm : 0.0;
+            std::vector<int> counts(bm, 0);
+            for (int k = 0; k < bm - 1; k++)
+                counts[std::lround((points(k,i).todouble() - shift) * bm)]++;
+            if (scrambling == 0)
+            {
+                EXPECT_EQ(0, counts[0]);
+            }
+            EXPECT_EQ(bm - 1, std::count(counts.begin(), counts.end(), 1));
+        }
+    }
+
+    // Scrambling changes the coordinates, in base 2 too.
+    NOMAD::PointSet scrambled;
+    halton_n.Sample(scrambled);
+    halton_n.set_scrambling(false);
+    halton_n.Sample(points);
+    for (int i = 0; i < n; i++)
+    {
+        int nb_diff = 0;
+        for (int k = 0; k < points.get_nb_points(); k++)
+            nb_diff += (points(k,i).todouble() != scrambled(k,i).todouble());
+        EXPECT_GT(nb_diff, points.get_nb_points() / 2);
+    }
+
+    EXPECT_ANY_THROW(NOMAD::Halton(0, 1));
+    EXPECT_ANY_THROW(NOMAD::Halton(NOMAD::MAX_DIMENSION + 1, 1));
+    EXPECT_ANY_THROW(NOMAD::Halton(2, -1));
+    NOMAD::Halton big(NOMAD::MAX_DIMENSION, 4);
+    EXPECT_EQ(7919, big.get_base(NOMAD::MAX_DIMENSION - 1));
+    big.set_scrambling(false);
+    big.Sample(points);
+    EXPECT_EQ(1.0 / 7919, points(0,NOMAD::MAX_DIMENSION-1).todouble());
+}
+
+// Direct access, skip-ahead, bounds and seeds
+TEST(HaltonTest, Access) {
+    const int n = 20;
+    const int p = 1000;
+    NOMAD::Halton halton(n, p, 123);
+    NOMAD::PointSet points(p, n, NOMAD::SOA);
+    halton.Sample(points);
+    EXPECT_EQ(NOMAD::SOA, points.get_layout());
+
+    // Sample(k), and next() after seek(), give the same samples.
+    NOMAD::Point x;
+    for (int k = 0; k < p; k += 37)
+    {
+        halton.Sample(k, x);
+        EXPECT_EQ(n, x.get_size());
+        for (int i = 0; i < n; i++)
+            EXPECT_EQ(points(k,i).todouble(), x[i].todouble());
+    }
+    halton.seek(500);
+    EXPECT_EQ(500, halton.get_index());
+    int k = 500;
+    while (halton.next(x))
+    {
+        for (int i = 0; i < n; i++)
+            EXPECT_EQ(points(k,i).todouble(), x[i].todouble());
+        k++;
+    }
+    EXPECT_EQ(p, k);
+    EXPECT_TRUE(halton.done());
+
+    // Blocks
+    halton.seek(0);
+    NOMAD::PointSet block(64, n);
+    k = 0;
+    int nb;
+    while ((nb = halton.next(block)) > 0)
+    {
+        for (int r = 0; r < nb; r++, k++)
+            for (int i = 0; i < n; i++)
+                EXPECT_EQ(points(k,i).todouble(), block(r,i).todouble());
+    }
+    EXPECT_EQ(p, k);
+
+    // Large indices
+    NOMAD::Halton large(n, INT_MAX);
+    large.seek(INT_MAX - 2);
+    EXPECT_TRUE(large.next(x));
+    NOMAD::Point y;
+    large.Sample(INT_MAX - 1, y);
+    EXPECT_TRUE(large.next(x));
+    EXPECT_FALSE(large.next(x));
+    for (int i = 0; i < n; i++)
+        EXPECT_EQ(y[i].todouble(), x[i].todouble());
+
+    // Seeds
+    NOMAD::PointSet other;
+    halton.set_seed(124);
+    EXPECT_EQ(124, halton.get_seed());
+    halton.Sample(other);
+    const int seeded[2] = { 0, 3 };
+    for (int c = 0; c < 2; c++)
+    {
+        int nb_diff = 0;
+        for (k = 0; k < p; k++)
+            nb_diff += (other(k,seeded[c]).todouble() != points(k,seeded[c]).todouble());
+        EXPECT_GT(nb_diff, p / 2);
+    }
+    halton.set_seed(123);
+    halton.Sample(other);
+    for (k = 0; k < p; k++)
+        for (int i = 0; i < n; i++)
+            EXPECT_EQ(points(k,i).todouble(), other(k,i).todouble());
+
+    // Bounds
+    std::vector<double> l(n, -2.0), u(n, 3.0);
+    u[0] = -2.0;
+    halton.set_bounds(l, u);
+    halton.Sample(other);
+    for (k = 0; k < p; k++)
+    {
+        EXPECT_EQ(-2.0, other(k,0).todouble());
+        for (int i = 1; i < n; i++)
+        {
+            EXPECT_GE(other(k,i).todouble(), -2.0);
+            EXPECT_LE(other(k,i).todouble(), 3.0);
+            EXPECT_NEAR(-2.0 + 5.0 * points(k,i).todouble(), other(k,i).todouble(), 1e-14);
+        }
+    }
+    NOMAD::Point lp(n, -2.0), up(n, 3.0);
+    halton.set_bounds(lp, up);
+    EXPECT_EQ(3.0, halton.get_ub()[0]);
+    EXPECT_ANY_THROW(halton.set_bounds(u, l));
+    l[1] = NOMAD::INF;
+    EXPECT_ANY_THROW(halton.set_bounds(l, u));
+    lp[1] = NOMAD::Double();
+    EXPECT_ANY_THROW(halton.set_bounds(lp, up));
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
@@ -0,0 +1,116 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Cache/KDTree.hpp"
+#include "Math/Point.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests KDTree class.
+
+// Scaled distance, computed as in the tree.
+double scaled_dist(const NOMAD::PointView & x, const NOMAD::PointView & y,
+                   const NOMAD::Point & scale, NOMAD::hnorm_type type)
+{
+    double r = 0.0;
+    for (int i = 0; i < x.get_size(); i++)
+    {
+        double d = std::fabs((x[i].todouble() - y[i].todouble()) / scale[i].todouble());
+        if (type == NOMAD::L1)
+            r += d;
+        else if (type == NOMAD::L2)
+            r += d * d;
+        else
+            r = std::max(r, d);
+    }
+    return (type == NOMAD::L2) ? std::sqrt(r) : r;
+}
+
+// Radius and nearest queries against a linear scan
+TEST(KDTreeTest, Queries) {
+    // This test is named "Queries", and belongs to the "KDTreeTest"
+    // test case.
+
+    const int n = 4;
+    NOMAD::KDTree tree(n);
+    EXPECT_EQ(n, tree.get_dimension());
+    NOMAD::RNG::set_seed(21);
+
+    NOMAD::Point scale(n);
+    for (int i = 0; i < n; i++)
+        scale[i] = 1.0 + i;
+    const NOMAD::hnorm_type types[] = { NOMAD::L1, NOMAD::L2, NOMAD::LINF };
+
+    NOMAD::Point x(n), c(n);
+    std::vector<int> ids, expected;
+    std::vector<NOMAD::Double> dists;
+    const int sizes[] = { 0, 10, 64, 65, 300, 1000, 3001 };
+    for (int s = 1; s < 7; s++)
+    {
+        // Incremental insertion, with duplicated points
+        for (int j = sizes[s-1]; j < sizes[s]; j++)
+        {
+            for (int i = 0; i < n; i++)
+                x[i] = (j % 7 == 0) ? 0.5 : NOMAD::RNG::rand(-1.0, 1.0) * (i + 1);
+            EXPECT_EQ(j, tree.insert(x));
+        }
+        EXPECT_EQ(sizes[s], tree.size());
+
+        for (int r = 0; r < 20; r++)
+        {
+            for (int i = 0; i < n; i++)
+                c[i] = NOMAD::RNG::rand(-1.0, 1.0) * (i + 1);
+            NOMAD::Point unscaled(n, 1.0);
+            const NOMAD::Point & sc = (r % 2) ? scale : unscaled;
+            NOMAD::PointView sv = (r % 2) ? NOMAD::PointView(scale) : NOMAD::PointView();
+            NOMAD::hnorm_type type = types[r % 3];
+
+            // Radius
+            double radius = 0.3 + 0.05 * r;
+            tree.radius_search(c, radius, ids, sv, type);
+            expected.clear();
+            for (int j = 0; j < tree.size(); j++)
+                if (scaled_dist(c, tree.get_point(j), sc, type) <= radius)
+                    expected.push_back(j);
+            std::sort(ids.begin(), ids.end());
+            EXPECT_EQ(expected, ids);
+
+            // Nearest
+            int k = 1 + r;
+            tree.nearest(c, k, ids, &dists, sv, type);
+            ASSERT_EQ(std::min(k, tree.size()), static_cast<int>(ids.size()));
+            std::vector<double> all;
+            for (int j = 0; j < tree.size(); j++)
+                all.push_back(scaled_dist(c, tree.get_point(j), sc, type));
+            std::sort(all.begin(), all.end());
+            for (size_t j = 0; j < ids.size(); j++)
+            {
+                EXPECT_NEAR(all[j], dists[j].todouble(), 1e-12);
+                EXPECT_NEAR(all[j], scaled_dist(c, tree.get_point(ids[j]), sc, type), 1e-12);
+            }
+        }
+    }
+
+    // Errors
+    EXPECT_ANY_THROW(tree.insert(NOMAD::Point(n - 1, 0.0)));
+    EXPECT_ANY_THROW(tree.insert(NOMAD::Point(n)));
+    EXPECT_ANY_THROW(tree.nearest(c, 3, ids, NULL, NOMAD::Point(n, 0.0)));
+
+    tree.clear();
+    EXPECT_EQ(0, tree.size());
+    tree.nearest(c, 3, ids);
+    EXPECT_TRUE(ids.empty());
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
@@ -3,6 +3,12 @@
 //
 // Don't forget gtest.h, which declares the testing framework.
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 #include "Math/LHS.hpp"
 #include "Math/Point.hpp"
 #include "Math/RNG.hpp"
@@ -76,6 +82,290 @@ TEST(LHSTest, Basic) {
     delete lhs;
 }
 
+// Streaming sampling: each coordinate is a Latin hypercube, and the samples
+// do not depend on the way they are generated
+TEST(LHSTest, Stream) {
+    const int n = 4;
+    const int sizes[] = { 1, 2, 3, 17, 1000 };
+    for (int s = 0; s < 5; s++)
+    {
+        const int p = sizes[s];
+        NOMAD::LHS lhs(n, p, 123);
+        std::vector<int> l(n), u(n);
+        for (int i = 0; i < n; i++)
+        {
+            l[i] = -i;
+            u[i] = 10 * (i + 1);
+        }
+        lhs.set_l(l);
+        lhs.set_u(u);
+
+        // One at a time
+        NOMAD::LHS::Stream stream(lhs);
+        EXPECT_EQ(p, stream.get_nb_samples());
+        NOMAD::PointSet points(p, n);
+        NOMAD::Point x;
+        int j = 0;
+        while (stream.next(x))
+        {
+            ASSERT_EQ(n, x.get_size());
+            for (int i = 0; i < n; i++)
+                points(j,i) = x[i];
+            j++;
+        }
+        EXPECT_EQ(p, j);
+        EXPECT_TRUE(stream.done());
+
+        // Each cell of each coordinate has exactly one sample
+        for (int i = 0; i < n; i++)
+        {
+            std::vector<int> count(p, 0);
+            for (j = 0; j < p; j++)
+            {
+                double t = (points(j,i).todouble() - l[i]) / (u[i] - l[i]) * p;
+                int k = static_cast<int>(floor(t));
+                ASSERT_GE(k, 0);
+                ASSERT_LT(k, p);
+                count[k]++;
+            }
+            for (int k = 0; k < p; k++)
+                EXPECT_EQ(1, count[k]);
+        }
+
+        // By blocks, and from the middle
+        stream.seek(0);
+        NOMAD::PointSet block(7, n);
+        j = 0;
+        int nb;
+        while ((nb = stream.next(block)) > 0)
+        {
+            for (int k = 0; k < nb; k++, j++)
+                for (int i = 0; i < n; i++)
+                    EXPECT_EQ(points(j,i).todouble(), block(k,i).todouble());
+        }
+        EXPECT_EQ(p, j);
+        stream.seek(p / 2);
+        EXPECT_TRUE(stream.next(x));
+        EXPECT_EQ(points(p / 2,0).todouble(), x[0].todouble());
+    }
+
+    // Another seed gives other samples
+    std::vector<int> l(n, 0), u(n, 1);
+    NOMAD::LHS lhs1(n, 100, 1), lhs2(n, 100, 2);
+    lhs1.set_l(l);
+    lhs1.set_u(u);
+    lhs2.set_l(l);
+    lhs2.set_u(u);
+    NOMAD::Point x1, x2;
+    NOMAD::LHS::Stream(lhs1).Sample(0, x1);
+    NOMAD::LHS::Stream(lhs2).Sample(0, x2);
+    EXPECT_NE(x1[0].todouble(), x2[0].todouble());
+
+    // No bounds
+    NOMAD::LHS lhs3(n, 10);
+    EXPECT_ANY_THROW(NOMAD::LHS::Stream stream(lhs3));
+}
+
+// Parallel sampling: same samples, bit by bit, for any number of threads
+TEST(LHSTest, Parallel) {
+    const int n = 5, p = 1001;
+    NOMAD::LHS lhs(n, p, 77);
+    lhs.set_l(std::vector<int>(n, -3));
+    lhs.set_u(std::vector<int>(n, 8));
+
+    NOMAD::PointSet ref(p, n);
+    NOMAD::LHS::Stream stream(lhs);
+    NOMAD::Point x;
+    for (int j = 0; stream.next(x); j++)
+        for (int i = 0; i < n; i++)
+            ref(j,i) = x[i];
+
+    const int threads[] = { 1, 2, 3, 8, 0 };
+    for (int t = 0; t < 5; t++)
+    {
+        for (int layout = 0; layout < 2; layout++)
+        {
+            NOMAD::PointSet points(1, 1, layout ? NOMAD::SOA : NOMAD::AOS);
+            lhs.SampleParallel(points, threads[t]);
+            ASSERT_EQ(p, points.get_nb_points());
+            ASSERT_EQ(n, points.get_dimension());
+            for (int j = 0; j < p; j++)
+                for (int i = 0; i < n; i++)
+                    ASSERT_EQ(0, memcmp(&ref(j,i), &points(j,i), sizeof(NOMAD::Double)));
+        }
+    }
+}
+
+// Real bounds: each coordinate is a Latin hypercube in [l_i,u_i]
+TEST(LHSTest, RealBounds) {
+    const int n = 4, p = 50;
+    NOMAD::Point l(n), u(n);
+    l[0] = -0.5;  u[0] = 0.25;
+    l[1] = 1e-3;  u[1] = 2e-3;
+    l[2] = -1e6;  u[2] = 1e6;
+    l[3] = 3.3;   u[3] = 3.3;
+
+    NOMAD::LHS lhs(n, p, 9);
+    NOMAD::PointSet empty(1, 1);
+    EXPECT_ANY_THROW(lhs.Sample(empty));
+    lhs.set_bounds(l, u);
+    EXPECT_EQ(-0.5, lhs.get_lb()[0]);
+    EXPECT_EQ(0.25, lhs.get_ub()[0]);
+
+    for (int mode = 0; mode < 2; mode++)
+    {
+        NOMAD::PointSet points(p, n, mode ? NOMAD::SOA : NOMAD::AOS);
+        if (mode == 0)
+            lhs.Sample(points);
+        else
+            lhs.SampleParallel(points, 2);
+
+        for (int i = 0; i < n; i++)
+        {
+            const double li = l[i].todouble(), ui = u[i].todouble();
+            std::vector<int> count(p, 0);
+            for (int j = 0; j < p; j++)
+            {
+                const double x = points(j,i).todouble();
+                ASSERT_GE(x, li);
+                ASSERT_LE(x, ui);
+                if (ui > li)
+                    count[std::min(p - 1, static_cast<int>(floor((x - li) / (ui - li) * p)))]++;
+            }
+            for (int k = 0; k < p && u[i] > l[i]; k++)
+                EXPECT_EQ(1, count[k]);
+        }
+    }
+
+    // Sample() keeps the formula of Algorithm 3.9 in NOMAD::Double:
+    // x_ij = l_i + (Pi_ij - r_ij) / p * (u_i - l_i)
+    NOMAD::RNG::set_seed(3);
+    std::srand(3);
+    std::vector<NOMAD::Point*> sample = lhs.Sample();
+    ASSERT_EQ(p, static_cast<int>(sample.size()));
+    NOMAD::RNG::set_seed(3);
+    std::srand(3);
+    std::vector<std::vector<int> > Pi;
+    for (int i = 0; i < n; i++)
+        Pi.push_back(NOMAD::LHS::Permutation(p));
+    for (int j = 0; j < p; j++)
+        for (int i = 0; i < n; i++)
+        {
+            NOMAD::Double r_ij = NOMAD::RNG::rand(0,1);
+            NOMAD::Double x_ij = l[i] + (NOMAD::Double(Pi[i][j]) - r_ij) / NOMAD::Double(p) * (u[i] - l[i]);
+            EXPECT_EQ(x_ij.todouble(), (*sample[j])[i].todouble());
+        }
+
+    // Sample(PointSet &) has the same permutations and random values, and
+    // differs from Sample() by rounding only
+    NOMAD::RNG::set_seed(3);
+    std::srand(3);
+    NOMAD::PointSet points(p, n);
+    lhs.Sample(points);
+    for (int j = 0; j < p; j++)
+    {
+        for (int i = 0; i < n; i++)
+            EXPECT_NEAR((*sample[j])[i].todouble(), points(j,i).todouble(),
+                        1e-14 * (std::fabs(l[i].todouble()) + std::fabs(u[i].todouble())));
+        delete sample[j];
+    }
+
+    // No samples
+    NOMAD::LHS none(n, 0);
+    EXPECT_TRUE(none.Sample().empty());
+
+    // Bad bounds
+    std::vector<double> lb(n, 0.0), ub(n, 1.0);
+    EXPECT_ANY_THROW(lhs.set_bounds(ub, lb));
+    EXPECT_ANY_THROW(lhs.set_bounds(std::vector<double>(n + 1, 0.0), ub));
+    ub[1] = NOMAD::INF;
+    EXPECT_ANY_THROW(lhs.set_bounds(lb, ub));
+    u[2] = NOMAD::Double();
+    EXPECT_ANY_THROW(lhs.set_bounds(l, u));
+}
+
+// Minimum distance between the points scaled to [0,1]^n
+double min_distance(const NOMAD::PointSet &points, const NOMAD::LHS &lhs)
+{
+    const int p = points.get_nb_points(), n = points.get_dimension();
+    double d2_min = NOMAD::INF;
+    for (int a = 0; a < p; a++)
+        for (int b = a + 1; b < p; b++)
+        {
+            double d2 = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                double d = (points(a,i).todouble() - points(b,i).todouble())
+                         / (lhs.get_ub()[i] - lhs.get_lb()[i]);
+                d2 += d * d;
+            }
+            d2_min = std::min(d2_min, d2);
+        }
+    return sqrt(d2_min);
+}
+
+// Maximin sampling: Latin hypercube at the centers of the cells, better
+// than random, and independent of the number of threads
+TEST(LHSTest, Maximin) {
+    const int n = 3, p = 20;
+    NOMAD::LHS lhs(n, p, 31);
+    std::vector<double> l(n), u(n);
+    for (int i = 0; i < n; i++)
+    {
+        l[i] = -1.0 - i;
+        u[i] = 2.0 * (i + 1);
+    }
+    lhs.set_bounds(l, u);
+
+    NOMAD::PointSet random(p, n), optimized(p, n);
+    double d_random = lhs.SampleMaximin(random, 0);
+    double d_optimized = lhs.SampleMaximin(optimized, 20000);
+    EXPECT_NEAR(d_random, min_distance(random, lhs), 1e-12);
+    EXPECT_NEAR(d_optimized, min_distance(optimized, lhs), 1e-12);
+    EXPECT_GT(d_optimized, d_random);
+
+    for (int i = 0; i < n; i++)
+    {
+        std::vector<int> count(p, 0);
+        for (int j = 0; j < p; j++)
+        {
+            double t = (optimized(j,i).todouble() - l[i]) / (u[i] - l[i]) * p - 0.5;
+            int k = static_cast<int>(floor(t + 0.5));
+            ASSERT_GE(k, 0);
+            ASSERT_LT(k, p);
+            EXPECT_NEAR(k, t, 1e-9);
+            count[k]++;
+        }
+        for (int k = 0; k < p; k++)
+            EXPECT_EQ(1, count[k]);
+    }
+
+    // Restarts on threads
+    NOMAD::PointSet ref(p, n), points(p, n);
+    double d_ref = lhs.SampleMaximin(ref, 2000, 0.0, 5, 1);
+    const int threads[] = { 2, 3, 5, 8 };
+    for (int t = 0; t < 4; t++)
+    {
+        EXPECT_EQ(d_ref, lhs.SampleMaximin(points, 2000, 0.0, 5, threads[t]));
+        for (int j = 0; j < p; j++)
+            for (int i = 0; i < n; i++)
+                EXPECT_EQ(ref(j,i).todouble(), points(j,i).todouble());
+    }
+
+    // Time budget only
+    EXPECT_GT(lhs.SampleMaximin(points, 0, 0.1), d_random);
+
+    // Errors are thrown before any thread starts: bounds not set, or a
+    // matrix of the distances that cannot be indexed
+    NOMAD::LHS no_bounds(n, p, 31);
+    EXPECT_THROW(no_bounds.SampleMaximin(points, 1, 0.0, 2, 2), NOMAD::Exception);
+    NOMAD::LHS big(1, INT_MAX, 31);
+    big.set_bounds(std::vector<double>(1, 0.0), std::vector<double>(1, 1.0));
+    NOMAD::PointSet big_points;
+    EXPECT_THROW(big.SampleMaximin(big_points, 1, 0.0, 2, 2), NOMAD::Exception);
+    EXPECT_EQ(0, big_points.get_nb_points());
+}
+
 // Step 3. Call RUN_ALL_TESTS() in main().
 //
 // We do this by linking in src/gtest_main.cc file, which consists of
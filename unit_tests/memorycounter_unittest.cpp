@@ -0,0 +1,124 @@
+
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <thread>
+#include <vector>
+
+#include "Math/Point.hpp"
+#include "Param/Parameters.hpp"
+#include "Util/MemoryCounter.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests MemoryCounter class.
+
+// Counters updated by several threads are summed when queried.
+TEST(MemoryCounterTest, Threads) {
+
+    // The PARAMETERS counter is not used by other objects in this test.
+    const NOMAD::MemoryCounter::counter_type type = NOMAD::MemoryCounter::PARAMETERS;
+    long live0  = NOMAD::MemoryCounter::get_live(type);
+    long bytes0 = NOMAD::MemoryCounter::get_bytes(type);
+
+    // Construct in several threads.
+    const int nb_threads = 4;
+    const int nb_objects = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nb_threads; t++)
+    {
+        threads.push_back(std::thread([&]() {
+            for (int i = 0; i < nb_objects; i++)
+            {
+                NOMAD::MemoryCounter::construct(type, 16);
+            }
+        }));
+    }
+    for (int t = 0; t < nb_threads; t++)
+    {
+        threads[t].join();
+    }
+    EXPECT_EQ(live0 + nb_threads * nb_objects, NOMAD::MemoryCounter::get_live(type));
+    EXPECT_EQ(bytes0 + 16L * nb_threads * nb_objects, NOMAD::MemoryCounter::get_bytes(type));
+    // The peak may miss the pending instances of the other running threads.
+    long min_peak = live0 + nb_threads * nb_objects - (nb_threads - 1) * NOMAD::MemoryCounter::FLUSH_SIZE;
+    EXPECT_LE(min_peak, NOMAD::MemoryCounter::get_peak(type));
+
+    // Destroy in another thread.
+    std::thread t([&]() {
+        for (int i = 0; i < nb_threads * nb_objects; i++)
+        {
+            NOMAD::MemoryCounter::destruct(type, 16);
+        }
+    });
+    t.join();
+    EXPECT_EQ(live0, NOMAD::MemoryCounter::get_live(type));
+    EXPECT_EQ(bytes0, NOMAD::MemoryCounter::get_bytes(type));
+    EXPECT_LE(min_peak, NOMAD::MemoryCounter::get_peak(type));
+
+    // Resize.
+    NOMAD::MemoryCounter::resize(type, 100);
+    EXPECT_EQ(bytes0 + 100, NOMAD::MemoryCounter::get_bytes(type));
+    NOMAD::MemoryCounter::resize(type, -100);
+    EXPECT_EQ(live0, NOMAD::MemoryCounter::get_live(type));
+}
+
+// Peak count in a single thread is exact.
+TEST(MemoryCounterTest, Peak) {
+
+    const NOMAD::MemoryCounter::counter_type type = NOMAD::MemoryCounter::PARAMETERS;
+    long live0 = NOMAD::MemoryCounter::get_live(type);
+    long peak0 = NOMAD::MemoryCounter::get_peak(type);
+    long n = peak0 - live0 + 1000;
+    for (long i = 0; i < n; i++)
+    {
+        NOMAD::MemoryCounter::construct(type, 1);
+    }
+    for (long i = 0; i < n; i++)
+    {
+        NOMAD::MemoryCounter::destruct(type, 1);
+    }
+    EXPECT_EQ(live0 + n, NOMAD::MemoryCounter::get_peak(type));
+    EXPECT_EQ(live0, NOMAD::MemoryCounter::get_live(type));
+}
+
+// Double, Point and Parameters are counted with MEMORY_DEBUG.
+TEST(MemoryCounterTest, Classes) {
+
+    long doubles0 = NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::DOUBLE);
+    long points0  = NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::POINT);
+    long bytes0   = NOMAD::MemoryCounter::get_bytes(NOMAD::MemoryCounter::POINT);
+    long params0  = NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::PARAMETERS);
+    {
+        NOMAD::Point p(10, 1.0);
+        NOMAD::Point q(p);
+        q = NOMAD::Point(20, 2.0);
+        NOMAD::Parameters params;
+#ifdef MEMORY_DEBUG
+        EXPECT_EQ(doubles0 + 30, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::DOUBLE));
+        EXPECT_EQ(points0 + 2, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::POINT));
+        EXPECT_EQ(bytes0 + p.mem_sizeof() + q.mem_sizeof(),
+                  NOMAD::MemoryCounter::get_bytes(NOMAD::MemoryCounter::POINT));
+        EXPECT_EQ(params0 + 1, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::PARAMETERS));
+        EXPECT_EQ(NOMAD::Double::get_cardinality(),
+                  NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::DOUBLE));
+#else
+        EXPECT_EQ(0, doubles0 + points0 + bytes0 + params0);
+        EXPECT_EQ(0, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::POINT));
+        EXPECT_EQ(0, NOMAD::Double::get_cardinality());
+#endif
+    }
+    EXPECT_EQ(doubles0, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::DOUBLE));
+    EXPECT_EQ(points0, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::POINT));
+    EXPECT_EQ(bytes0, NOMAD::MemoryCounter::get_bytes(NOMAD::MemoryCounter::POINT));
+    EXPECT_EQ(params0, NOMAD::MemoryCounter::get_live(NOMAD::MemoryCounter::PARAMETERS));
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
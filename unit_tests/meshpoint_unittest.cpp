@@ -0,0 +1,154 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <set>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+#include "Math/MeshFrame.hpp"
+#include "Math/MeshPoint.hpp"
+#include "Math/Point.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests MeshPoint class.
+
+// Conversion from and to NOMAD::Point
+TEST(MeshPointTest, Conversion) {
+    // This test is named "Conversion", and belongs to the "MeshPointTest"
+    // test case.
+
+    const int n = 5;
+    NOMAD::Point ref(n), delta(n);
+    for (int i = 0; i < n; i++)
+    {
+        ref[i] = 0.3 * i - 0.7;
+        delta[i] = 1.0 / (3 << i);
+    }
+    NOMAD::MeshFrame frame(ref, delta);
+    EXPECT_EQ(n, frame.get_size());
+
+    // Reference point
+    NOMAD::MeshPoint r(frame);
+    EXPECT_EQ(n, r.get_size());
+    EXPECT_EQ(&frame, r.get_frame());
+    EXPECT_EQ(ref, r.to_point());
+
+    // Projected points are on the mesh, and the conversion back is exact
+    NOMAD::RNG::set_seed(5);
+    NOMAD::Point x(n);
+    for (int t = 0; t < 1000; t++)
+    {
+        for (int i = 0; i < n; i++)
+            x[i] = NOMAD::RNG::rand(-100.0, 100.0);
+        x.project_to_mesh(ref, delta);
+        NOMAD::MeshPoint m(frame, x);
+        NOMAD::Point y = m.to_point();
+        for (int i = 0; i < n; i++)
+        {
+            EXPECT_EQ(x[i].todouble(), y[i].todouble());
+            EXPECT_EQ(x[i].todouble(), m.get_coord(i).todouble());
+        }
+    }
+
+    // Indices
+    NOMAD::MeshPoint m(frame);
+    m[2] = -7;
+    x = ref;
+    x[2] = ref[2] - 7 * delta[2];
+    EXPECT_EQ(x, m.to_point());
+    EXPECT_TRUE(NOMAD::MeshPoint(frame, x) == m);
+
+    // Undefined coordinate
+    x[1] = NOMAD::Double();
+    NOMAD::MeshPoint u(frame, x);
+    EXPECT_EQ(NOMAD::MeshPoint::UNDEF_INDEX, u[1]);
+    EXPECT_FALSE(u.to_point()[1].is_defined());
+    std::ostringstream s;
+    s << u;
+    EXPECT_EQ("0 " + NOMAD::Double::get_undef_str() + " -7 0 0", s.str());
+
+    // Points that are not on the mesh
+    x = ref;
+    x[0] += 0.4 * delta[0];
+    EXPECT_ANY_THROW(NOMAD::MeshPoint(frame, x));
+    x[0] = 1e300;
+    EXPECT_ANY_THROW(NOMAD::MeshPoint(frame, x));
+    EXPECT_ANY_THROW(NOMAD::MeshPoint(frame, NOMAD::Point(n - 1, 0.0)));
+    EXPECT_ANY_THROW(NOMAD::MeshFrame(ref, NOMAD::Point(n, 0.0)));
+}
+
+// Exact comparisons and hash
+TEST(MeshPointTest, Comparison) {
+    const int n = 3;
+    NOMAD::MeshFrame frame(NOMAD::Point(n, 0.1), NOMAD::Point(n, 0.5));
+    NOMAD::MeshFrame frame2(NOMAD::Point(n, 0.1), NOMAD::Point(n, 0.5));
+
+    // Same order as the points, and same equality
+    std::set<NOMAD::MeshPoint> mesh_set;
+    std::unordered_set<NOMAD::MeshPoint, NOMAD::MeshPointHash> mesh_hash;
+    std::set<NOMAD::Point> point_set;
+    NOMAD::RNG::set_seed(9);
+    for (int t = 0; t < 2000; t++)
+    {
+        NOMAD::MeshPoint m(frame);
+        for (int i = 0; i < n; i++)
+            m[i] = static_cast<int>(NOMAD::RNG::rand(-5.0, 5.0));
+        bool is_new = point_set.insert(m.to_point()).second;
+        EXPECT_EQ(is_new, mesh_set.insert(m).second);
+        EXPECT_EQ(is_new, mesh_hash.insert(m).second);
+    }
+    EXPECT_EQ(point_set.size(), mesh_set.size());
+    std::set<NOMAD::Point>::const_iterator it = point_set.begin();
+    std::set<NOMAD::MeshPoint>::const_iterator it2 = mesh_set.begin();
+    for ( ; it != point_set.end(); ++it, ++it2)
+        EXPECT_EQ(*it, it2->to_point());
+
+    // Points on different frame objects are different
+    NOMAD::MeshPoint a(frame), b(frame2);
+    EXPECT_TRUE(frame == frame2);
+    EXPECT_FALSE(a == b);
+    EXPECT_TRUE((a < b) != (b < a));
+    EXPECT_EQ(a.hash(), NOMAD::MeshPoint(frame).hash());
+}
+
+// Storage: copies, moves and memory
+TEST(MeshPointTest, Storage) {
+    const int n_small = NOMAD::MeshPoint::SMALL_SIZE;
+    const int n_large = NOMAD::MeshPoint::SMALL_SIZE + 5;
+    NOMAD::MeshFrame small_frame(NOMAD::Point(n_small, 0.0), NOMAD::Point(n_small, 1.0));
+    NOMAD::MeshFrame large_frame(NOMAD::Point(n_large, 0.0), NOMAD::Point(n_large, 1.0));
+
+    NOMAD::MeshPoint s(small_frame), l(large_frame);
+    s[0] = 3;
+    l[0] = 4;
+    NOMAD::MeshPoint s2(s), l2(l);
+    EXPECT_TRUE(s2 == s);
+    EXPECT_TRUE(l2 == l);
+
+    NOMAD::MeshPoint l3(std::move(l2));
+    EXPECT_TRUE(l3 == l);
+    EXPECT_EQ(0, l2.get_size());
+
+    swap(s2, l3);
+    EXPECT_TRUE(s2 == l);
+    EXPECT_TRUE(l3 == s);
+    s2 = s;
+    EXPECT_TRUE(s2 == s);
+
+    // Half the memory of the points
+    NOMAD::Point p = s.to_point();
+    EXPECT_LT(s.mem_sizeof(), p.mem_sizeof());
+    NOMAD::Point q = l.to_point();
+    EXPECT_LT(l.mem_sizeof(), q.mem_sizeof());
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
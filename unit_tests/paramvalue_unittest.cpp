@@ -56,6 +56,22 @@ TEST(ParamValueTest, Basic) {
     int i6_get = value6.get_value_int();
     EXPECT_EQ(i6, i6_get);
 
+    // Value strings are the same as with std::ostream.
+    double d6[] = { 10.101, 0.1, -3.14159265358979323, 1e-10, 1234567.0, 0.0 };
+    for (size_t i = 0; i < sizeof(d6) / sizeof(double); i++)
+    {
+        std::ostringstream oss;
+        oss << d6[i];
+        EXPECT_EQ(oss.str(), NOMAD::ParamValue(d6[i]).get_value_str());
+    }
+    int i6b[] = { 0, -1, 42, INT_MAX, INT_MIN };
+    for (size_t i = 0; i < sizeof(i6b) / sizeof(int); i++)
+    {
+        std::ostringstream oss;
+        oss << i6b[i];
+        EXPECT_EQ(oss.str(), NOMAD::ParamValue(i6b[i]).get_value_str());
+    }
+
     // Test 0. A value of 0 is ambiguous because the type could be
     // a NOMAD::Double, bool, int, etc.
     // With the newer implementation of ParamValue, it compiles, but type is not well defined.
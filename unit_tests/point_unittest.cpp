@@ -41,6 +41,87 @@ TEST(PointTest, Basic) {
 
 }
 
+// Projection of points to the mesh
+TEST(PointTest, ProjectToMesh) {
+
+    NOMAD::Point ref(3, 1.0);
+    NOMAD::Point delta(3, 0.5);
+    NOMAD::Point lb(3, -1.0);
+    NOMAD::Point ub(3, 2.0);
+    ub[2] = NOMAD::Double();
+
+    NOMAD::Point points[2] = { NOMAD::Point(3), NOMAD::Point(3) };
+    points[0][0] = 1.3;
+    points[0][1] = 2.9;
+    points[0][2] = 3.7;
+    points[1][0] = -3.1;
+    points[1][1] = 0.74;
+    // points[1][2] stays undefined.
+
+    NOMAD::Point::project_to_mesh(points, 2, ref, delta, lb, ub);
+    EXPECT_EQ(points[0][0], 1.5);
+    EXPECT_EQ(points[0][1], 2.0);   // Upper bound.
+    EXPECT_EQ(points[0][2], 3.5);   // No upper bound.
+    EXPECT_EQ(points[1][0], -1.0);  // Lower bound.
+    EXPECT_EQ(points[1][1], 0.5);
+    EXPECT_FALSE(points[1][2].is_defined());
+
+    // Same as the scalar version, without bounds and reference.
+    NOMAD::Point p(3, 0.26), q(3, 0.26);
+    p.project_to_mesh(NOMAD::Point(), delta);
+    for (int i = 0; i < 3; i++)
+    {
+        q[i].project_to_mesh(NOMAD::Double(), delta[i]);
+        EXPECT_EQ(p[i].todouble(), q[i].todouble());
+    }
+
+    // Bad dimensions.
+    EXPECT_THROW(p.project_to_mesh(ref, NOMAD::Point(2, 0.5)), NOMAD::Exception);
+}
+
+// Points stored inline and on the heap
+TEST(PointTest, SmallBuffer) {
+
+    const int small = NOMAD::Point::SMALL_SIZE;
+    const int dims[] = { 0, 1, small, small + 1, 3 * small };
+    for (int a = 0; a < 5; a++)
+    {
+        NOMAD::Point p(dims[a], 1.5);
+        EXPECT_EQ(dims[a], p.get_size());
+        for (int i = 0; i < dims[a]; i++)
+        {
+            EXPECT_EQ(1.5, p[i].todouble());
+        }
+
+        // Memory footprint: heap only above the threshold.
+        int heap = (dims[a] > small) ? dims[a] * (int)sizeof(NOMAD::Double) : 0;
+        EXPECT_EQ((int)sizeof(NOMAD::Point) + heap, p.mem_sizeof());
+
+        // Copies and affectations between all sizes.
+        for (int b = 0; b < 5; b++)
+        {
+            NOMAD::Point q(dims[b], 2.5);
+            NOMAD::Point r(q);
+            EXPECT_TRUE(r == q);
+            r = p;
+            EXPECT_TRUE(r == p);
+            EXPECT_EQ(p.mem_sizeof(), r.mem_sizeof());
+            if (dims[a] > 0)
+            {
+                // The copy does not share the coordinates.
+                r[0] = 3.5;
+                EXPECT_EQ(1.5, p[0].todouble());
+            }
+            r = r;
+            EXPECT_EQ(dims[a], r.get_size());
+        }
+    }
+
+    // Undefined coordinates by default.
+    NOMAD::Point u(3);
+    EXPECT_FALSE(u[2].is_defined());
+}
+
 // Step 3. Call RUN_ALL_TESTS() in main().
 //
 // We do this by linking in src/gtest_main.cc file, which consists of
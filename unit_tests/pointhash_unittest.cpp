@@ -0,0 +1,130 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <algorithm>
+#include <cmath>
+#include "Math/Point.hpp"
+#include "Math/PointHash.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Value of the coordinate i just below the upper boundary of its cell in
+// [lo,hi], by bisection on the changes of hash.
+double boundary(const NOMAD::PointHash & hash, int n, int i, double lo, double hi)
+{
+    NOMAD::Point x(n, 0.0);
+    x[i] = lo;
+    const uint64_t h = hash(x);
+    for (int r = 0; r < 100; r++)
+    {
+        x[i] = 0.5 * (lo + hi);
+        if (hash(x) == h)
+            lo = x[i].todouble();
+        else
+            hi = x[i].todouble();
+    }
+    return lo;
+}
+
+// Tests PointHash class.
+
+// Equal points have the same hash, or one of the keys
+TEST(PointHashTest, Consistency) {
+    // This test is named "Consistency", and belongs to the "PointHashTest"
+    // test case.
+
+    const int n = 6;
+    const double eps = NOMAD::Double::get_epsilon();
+    NOMAD::PointHash hash(1e-6);
+    EXPECT_EQ(1e-6, hash.get_quantum());
+    NOMAD::RNG::set_seed(3);
+    uint64_t keys[NOMAD::PointHash::MAX_KEYS];
+
+    for (int r = 0; r < 2000; r++)
+    {
+        // Coordinates near the boundaries of the cells
+        NOMAD::Point x(n), y(n);
+        for (int i = 0; i < n; i++)
+        {
+            double k = floor(NOMAD::RNG::rand(0.0, 2000.0)) - 1000;
+            x[i] = boundary(hash, n, i, k * 1e-6, (k + 1) * 1e-6)
+                 + NOMAD::RNG::rand(-2.0, 2.0) * eps;
+            y[i] = x[i].todouble() + NOMAD::RNG::rand(-0.9, 0.9) * eps;
+        }
+        ASSERT_TRUE(x == y);
+
+        int nb = hash.keys(y, keys);
+        ASSERT_GE(nb, 1);
+        EXPECT_EQ(hash(y), keys[0]);
+        EXPECT_TRUE(std::find(keys, keys + nb, hash(x)) != keys + nb);
+    }
+
+    // Views with strides
+    NOMAD::PointSet soa(2, n, NOMAD::SOA, 0.25);
+    NOMAD::Point z(n, 0.25);
+    EXPECT_EQ(hash(z), hash(soa.row(1)));
+
+    // Different points in different cells
+    NOMAD::Point z2(z);
+    z2[3] = 0.5;
+    EXPECT_NE(hash(z), hash(z2));
+    EXPECT_NE(hash(NOMAD::Point(n - 1, 0.25)), hash(z));
+
+    // Bad quantum
+    EXPECT_ANY_THROW(NOMAD::PointHash bad(eps));
+}
+
+// Hash with a mesh frame
+TEST(PointHashTest, Mesh) {
+    const int n = 4;
+    NOMAD::Point ref(n), delta(n);
+    for (int i = 0; i < n; i++)
+    {
+        ref[i] = 0.1 * i;
+        delta[i] = 0.25 / (i + 1);
+    }
+    NOMAD::PointHash hash(ref, delta);
+    EXPECT_EQ(ref, hash.get_ref());
+    EXPECT_EQ(delta, hash.get_delta());
+    uint64_t keys[NOMAD::PointHash::MAX_KEYS];
+
+    // Mesh points are centered in their cells: one key only
+    NOMAD::Point x(n);
+    for (int r = 0; r < 100; r++)
+    {
+        for (int i = 0; i < n; i++)
+            x[i] = ref[i] + (r - 50 + 3 * i) * delta[i];
+        EXPECT_EQ(1, hash.keys(x, keys));
+        EXPECT_EQ(hash(x), keys[0]);
+    }
+
+    // Midpoints of the mesh are also far from the boundaries
+    for (int i = 0; i < n; i++)
+        x[i] = ref[i] + 0.5 * delta[i];
+    EXPECT_EQ(1, hash.keys(x, keys));
+
+    // Too many coordinates near a boundary
+    const int m = NOMAD::PointHash::MAX_AMBIGUOUS + 1;
+    NOMAD::PointHash hash2(1.0);
+    NOMAD::Point y(m);
+    for (int i = 0; i < m; i++)
+        y[i] = boundary(hash2, m, i, 0.0, 1.0);
+    EXPECT_EQ(-1, hash2.keys(y, keys));
+    y[0] = 0.0;
+    EXPECT_EQ(NOMAD::PointHash::MAX_KEYS, hash2.keys(y, keys));
+
+    // Bad mesh
+    EXPECT_ANY_THROW(NOMAD::PointHash(ref, NOMAD::Point(n - 1, 1.0)));
+    EXPECT_ANY_THROW(NOMAD::PointHash(ref, NOMAD::Point(n, 0.0)));
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
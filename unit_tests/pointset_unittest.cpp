@@ -0,0 +1,216 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+#include "Math/LHS.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests PointSet class.
+
+// Basic tests for PointSet
+TEST(PointSetTest, Basic) {
+    // This test is named "Basic", and belongs to the "PointSetTest"
+    // test case.
+
+    const int p = 13;
+    const int n = 5;
+    const NOMAD::storage_layout layouts[] = { NOMAD::AOS , NOMAD::SOA };
+
+    for (int l = 0; l < 2; l++)
+    {
+        NOMAD::PointSet ps(p, n, layouts[l], 1.0);
+        EXPECT_EQ(p, ps.get_nb_points());
+        EXPECT_EQ(n, ps.get_dimension());
+        EXPECT_EQ(layouts[l], ps.get_layout());
+        // Aligned buffer
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(ps.data()) % NOMAD::PointSet::ALIGNMENT);
+
+        for (int i = 0; i < p; i++)
+            for (int j = 0; j < n; j++)
+                ps(i,j) = 10 * i + j;
+
+        // Rows and columns
+        NOMAD::PointSet::Const_Slice r = ps.row(3);
+        NOMAD::PointSet::Const_Slice c = ps.column(2);
+        EXPECT_EQ(n, r.get_size());
+        EXPECT_EQ(p, c.get_size());
+        EXPECT_EQ(layouts[l] == NOMAD::AOS, r.is_contiguous());
+        EXPECT_EQ(layouts[l] == NOMAD::SOA, c.is_contiguous());
+        for (int j = 0; j < n; j++)
+            EXPECT_EQ(30 + j, r[j]);
+        for (int i = 0; i < p; i++)
+            EXPECT_EQ(10 * i + 2, c[i]);
+
+        // Columns of the SOA layout are aligned
+        if (layouts[l] == NOMAD::SOA)
+        {
+            EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(ps.column(1).data()) % NOMAD::PointSet::ALIGNMENT);
+        }
+
+        // Points
+        NOMAD::Point x = ps.get_point(4);
+        EXPECT_EQ(n, x.get_size());
+        EXPECT_EQ(43, x[3]);
+        x[3] = -1;
+        ps.set_point(5, x);
+        EXPECT_EQ(-1, ps(5,3));
+        EXPECT_ANY_THROW(ps.set_point(p, x));
+        EXPECT_ANY_THROW(ps.set_point(0, NOMAD::Point(n + 1)));
+
+        // Add points, with reallocations
+        for (int k = 0; k < 50; k++)
+            ps.add_point(NOMAD::Point(n, k));
+        EXPECT_EQ(p + 50, ps.get_nb_points());
+        EXPECT_EQ(43, ps(4,3));
+        EXPECT_EQ(49, ps(p + 49, 0));
+
+        // Copy, change of layout
+        NOMAD::PointSet ps2(ps);
+        ps2.set_layout(layouts[1 - l]);
+        EXPECT_EQ(ps.get_nb_points(), ps2.get_nb_points());
+        for (int i = 0; i < ps.get_nb_points(); i++)
+            for (int j = 0; j < n; j++)
+                EXPECT_EQ(ps(i,j), ps2(i,j));
+
+        // Resize
+        ps2.resize(2);
+        ps2.resize(3);
+        EXPECT_EQ(3, ps2.get_nb_points());
+        EXPECT_FALSE(ps2(2,0).is_defined());
+        ps = ps2;
+        EXPECT_EQ(3, ps.get_nb_points());
+        EXPECT_EQ(13, ps(1,3));
+
+        // Move
+        NOMAD::PointSet ps3(std::move(ps2));
+        EXPECT_EQ(3, ps3.get_nb_points());
+        EXPECT_EQ(0, ps2.get_nb_points());
+    }
+
+    // The first point added sets the dimension
+    NOMAD::PointSet empty;
+    empty.add_point(NOMAD::Point(3, 2.0));
+    EXPECT_EQ(3, empty.get_dimension());
+    EXPECT_ANY_THROW(empty.add_point(NOMAD::Point(2)));
+
+    // Capacities past INT_MAX values are rejected, in both layouts
+    NOMAD::PointSet big(0, 3);
+    EXPECT_ANY_THROW(big.reserve(INT_MAX / 2));
+    big.set_layout(NOMAD::SOA);
+    EXPECT_ANY_THROW(big.reserve(INT_MAX / 3));
+    EXPECT_EQ(0, big.get_capacity());
+}
+
+// Norms and distances, compared to the ones of Point
+TEST(PointSetTest, Norms) {
+    const int p = 37;
+    const int n = 11;
+    NOMAD::RNG::set_seed(123);
+
+    NOMAD::PointSet aos(p, n, NOMAD::AOS);
+    NOMAD::PointSet other(p, n, NOMAD::AOS);
+    for (int i = 0; i < p; i++)
+        for (int j = 0; j < n; j++)
+        {
+            aos(i,j)   = NOMAD::RNG::rand(-10, 10);
+            other(i,j) = NOMAD::RNG::rand(-10, 10);
+        }
+    NOMAD::PointSet soa(aos);
+    soa.set_layout(NOMAD::SOA);
+    NOMAD::Point x = other.get_point(0);
+
+    const NOMAD::hnorm_type types[] = { NOMAD::L1 , NOMAD::L2 , NOMAD::LINF };
+    std::vector<NOMAD::Double> r1(p), r2(p), r3(p), r4(p), r5(p);
+    for (int t = 0; t < 3; t++)
+    {
+        aos.norms(&r1[0], types[t]);
+        soa.norms(&r2[0], types[t]);
+        soa.dists(x, &r3[0], types[t]);
+        soa.dists(other, &r4[0], types[t]);
+        aos.dists(other, &r5[0], types[t]);
+        for (int i = 0; i < p; i++)
+        {
+            NOMAD::Point y = aos.get_point(i);
+            NOMAD::Point z = other.get_point(i);
+            EXPECT_NEAR(y.norm(types[t]).todouble(), r1[i].todouble(), 1e-12);
+            EXPECT_NEAR(y.norm(types[t]).todouble(), r2[i].todouble(), 1e-12);
+            EXPECT_NEAR(y.dist(x, types[t]).todouble(), r3[i].todouble(), 1e-12);
+            EXPECT_NEAR(y.dist(z, types[t]).todouble(), r4[i].todouble(), 1e-12);
+            EXPECT_NEAR(y.dist(z, types[t]).todouble(), r5[i].todouble(), 1e-12);
+        }
+    }
+
+    // Undefined coordinates
+    soa(5,3) = NOMAD::Double();
+#ifdef UNCHECKED_DOUBLE
+    soa.norms(&r2[0]);
+    EXPECT_FALSE(r2[5].is_defined());
+    EXPECT_TRUE(r2[4].is_defined());
+#else
+    EXPECT_THROW(soa.norms(&r2[0]), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(soa.norms(&r2[0], NOMAD::LINF), NOMAD::Double::Not_Defined);
+#endif
+    EXPECT_ANY_THROW(soa.dists(NOMAD::Point(n + 1), &r2[0]));
+}
+
+// LHS into a PointSet
+TEST(PointSetTest, LHS) {
+    const int n = 6;
+    const int p = 20;
+    std::vector<int> l(n, -5), u(n, 5);
+
+    NOMAD::LHS lhs1(n, p, 42);
+    lhs1.set_l(l);
+    lhs1.set_u(u);
+    NOMAD::RNG::set_seed(42);
+    std::vector<NOMAD::Point*> sample = lhs1.Sample();
+
+    NOMAD::LHS lhs2(n, p, 42);
+    lhs2.set_l(l);
+    lhs2.set_u(u);
+    NOMAD::RNG::set_seed(42);
+    NOMAD::PointSet points(0, 0, NOMAD::SOA);
+    lhs2.Sample(points);
+    EXPECT_EQ(p, points.get_nb_points());
+    EXPECT_EQ(n, points.get_dimension());
+    EXPECT_EQ(NOMAD::SOA, points.get_layout());
+
+    // Same samples, up to the rounding of the scale factor of Sample(PointSet &)
+    for (int j = 0; j < p; j++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            EXPECT_NEAR((*sample[j])[i].todouble(), points(j,i).todouble(), 1e-13);
+        }
+        delete sample[j];
+    }
+
+    // One point in each of the p intervals of each coordinate
+    for (int i = 0; i < n; i++)
+    {
+        std::vector<int> count(p, 0);
+        for (int j = 0; j < p; j++)
+        {
+            int k = static_cast<int>((points(j,i).todouble() + 5) / 10 * p);
+            ASSERT_GE(k, 0);
+            ASSERT_LT(k, p);
+            count[k]++;
+        }
+        for (int k = 0; k < p; k++)
+            EXPECT_EQ(1, count[k]);
+    }
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
@@ -0,0 +1,137 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <sstream>
+#include "Math/Point.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/PointView.hpp"
+#include "Math/RNG.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests PointView class.
+
+// Views on points and on rows of point sets
+TEST(PointViewTest, Basic) {
+    // This test is named "Basic", and belongs to the "PointViewTest"
+    // test case.
+
+    const int n = 7;
+    NOMAD::Point x(n);
+    for (int i = 0; i < n; i++)
+        x[i] = 1.5 * i - 2;
+
+    // View on a point: no copy
+    NOMAD::PointView v = x;
+    EXPECT_EQ(n, v.get_size());
+    EXPECT_EQ(1, v.get_stride());
+    EXPECT_TRUE(v.is_contiguous());
+    EXPECT_EQ(&x[0], v.data());
+    EXPECT_TRUE(v == x);
+    EXPECT_TRUE(x == v);
+    EXPECT_EQ(x, v.to_point());
+
+    // Views on the rows of point sets, with both layouts
+    NOMAD::PointSet aos(4, n, NOMAD::AOS, 0.0);
+    NOMAD::PointSet soa(4, n, NOMAD::SOA, 0.0);
+    aos.set_point(2, x);
+    soa.set_point(2, x);
+    NOMAD::PointView va = aos.row(2);
+    NOMAD::PointView vs = soa.row(2);
+    EXPECT_TRUE(va.is_contiguous());
+    EXPECT_FALSE(vs.is_contiguous());
+    EXPECT_EQ(soa.get_ld(), vs.get_stride());
+    EXPECT_TRUE(va == x);
+    EXPECT_TRUE(vs == x);
+    EXPECT_TRUE(x == vs);
+    EXPECT_FALSE(vs != va);
+    EXPECT_TRUE(vs < NOMAD::PointView(soa.row(1)));
+    EXPECT_FALSE(vs < va);
+    EXPECT_FALSE(va < vs);
+    EXPECT_TRUE(NOMAD::PointView(soa.row(1)) != x);
+
+    // Different dimensions
+    NOMAD::Point y(n - 1, 0.0);
+    EXPECT_FALSE(y == vs);
+    EXPECT_TRUE(y < vs);
+
+    // Display
+    std::ostringstream s1, s2, s3, s4;
+    s1 << x;
+    s2 << vs;
+    x.display(s3, ", ", 4, 4);
+    vs.display(s4, ", ", 4, 4);
+    EXPECT_EQ(s1.str(), s2.str());
+    EXPECT_EQ(s3.str(), s4.str());
+
+    // Empty view
+    NOMAD::PointView e;
+    EXPECT_EQ(0, e.get_size());
+    EXPECT_TRUE(e == NOMAD::Point());
+}
+
+// Norms on strided views
+TEST(PointViewTest, Norms) {
+    const int n = 300;
+    NOMAD::RNG::set_seed(7);
+    NOMAD::PointSet soa(3, n, NOMAD::SOA);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < n; j++)
+            soa(i,j) = NOMAD::RNG::rand(-1, 1);
+    NOMAD::Point x = soa.get_point(0);
+    NOMAD::Point y = soa.get_point(1);
+    NOMAD::PointView vx = soa.row(0);
+    NOMAD::PointView vy = soa.row(1);
+
+    // Same summation order as the points: same results
+    const NOMAD::hnorm_type types[] = { NOMAD::L1 , NOMAD::L2 , NOMAD::LINF };
+    for (int t = 0; t < 3; t++)
+    {
+        EXPECT_EQ(x.norm(types[t]).todouble(), vx.norm(types[t]).todouble());
+        EXPECT_EQ(x.dist(y, types[t]).todouble(), vx.dist(vy, types[t]).todouble());
+        EXPECT_EQ(x.dist(y, types[t]).todouble(), x.dist(vy, types[t]).todouble());
+    }
+    EXPECT_EQ(x.squared_norm().todouble(), vx.squared_norm().todouble());
+    EXPECT_EQ(x.dot_product(y).todouble(), vx.dot_product(vy).todouble());
+    EXPECT_EQ(x.dot_product(y).todouble(), x.dot_product(vy).todouble());
+    EXPECT_ANY_THROW(vx.dist(NOMAD::Point(n - 1, 0.0)));
+
+    // Undefined coordinate
+    soa(1, 5) = NOMAD::Double();
+#ifndef UNCHECKED_DOUBLE
+    EXPECT_THROW(NOMAD::PointView(soa.row(1)).norm(), NOMAD::Double::Not_Defined);
+#endif
+}
+
+// Projection to the mesh with views
+TEST(PointViewTest, ProjectToMesh) {
+    const int n = 5;
+    NOMAD::PointSet frame(4, n, NOMAD::SOA);
+    for (int j = 0; j < n; j++)
+    {
+        frame(0,j) = 0.1 * j;       // ref
+        frame(1,j) = 0.25;          // delta
+        frame(2,j) = -1.0;          // lb
+        frame(3,j) = 1.0;           // ub
+    }
+
+    NOMAD::Point x1(n), x2(n);
+    for (int j = 0; j < n; j++)
+        x1[j] = x2[j] = 0.77 * j - 1.3;
+
+    // Strided views, and the same values as points
+    x1.project_to_mesh(frame.row(0), frame.row(1), frame.row(2), frame.row(3));
+    x2.project_to_mesh(frame.get_point(0), frame.get_point(1),
+                       frame.get_point(2), frame.get_point(3));
+    EXPECT_EQ(x2, x1);
+    EXPECT_ANY_THROW(x1.project_to_mesh(frame.row(0), NOMAD::Point(n - 1, 1.0)));
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
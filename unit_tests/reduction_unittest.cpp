@@ -0,0 +1,133 @@
+
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "Math/Point.hpp"
+#include "Math/Reduction.hpp"
+#include "Math/Vector.hpp"
+#include "gtest/gtest.h"
+
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests Reduction class.
+
+// Results of the kernels, compared to long double loops.
+TEST(ReductionTest, Kernels) {
+
+    const int sizes[] = { 0, 1, 3, 4, 7, 128, 129, 1000 };
+    std::srand(42);
+    for (int s = 0; s < 8; s++)
+    {
+        int n = sizes[s];
+        std::vector<NOMAD::Double> x(n + 1), y(n + 1);
+        long double sum = 0, dot = 0, sq = 0, sqd = 0, l1 = 0, l1d = 0, linf = 0, linfd = 0;
+        for (int i = 0; i < n; i++)
+        {
+            double a = (double)std::rand() / RAND_MAX - 0.5;
+            double b = (double)std::rand() / RAND_MAX * 3.0;
+            x[i] = a;
+            y[i] = b;
+            sum += a;
+            dot += (long double)a * b;
+            sq += (long double)a * a;
+            sqd += (long double)(b - a) * (b - a);
+            l1 += std::fabs(a);
+            l1d += std::fabs(b - a);
+            linf = std::max(linf, (long double)std::fabs(a));
+            linfd = std::max(linfd, (long double)std::fabs(b - a));
+        }
+        const double tol = 1e-13 * (n + 1);
+        EXPECT_NEAR((double)sum, NOMAD::Reduction::sum(&x[0], n).todouble(), tol);
+        EXPECT_NEAR((double)sum, NOMAD::Reduction::sum_compensated(&x[0], n).todouble(), tol);
+        EXPECT_NEAR((double)dot, NOMAD::Reduction::dot(&x[0], &y[0], n).todouble(), tol);
+        EXPECT_NEAR((double)sq, NOMAD::Reduction::squared_norm(&x[0], n).todouble(), tol);
+        EXPECT_NEAR((double)sqd, NOMAD::Reduction::squared_dist(&x[0], &y[0], n).todouble(), tol);
+        EXPECT_NEAR((double)l1, NOMAD::Reduction::norm(&x[0], n, NOMAD::L1).todouble(), tol);
+        EXPECT_NEAR(std::sqrt((double)sq), NOMAD::Reduction::norm(&x[0], n).todouble(), tol);
+        EXPECT_EQ((double)linf, NOMAD::Reduction::norm(&x[0], n, NOMAD::LINF).todouble());
+        EXPECT_NEAR((double)l1d, NOMAD::Reduction::dist(&x[0], &y[0], n, NOMAD::L1).todouble(), tol);
+        EXPECT_NEAR(std::sqrt((double)sqd), NOMAD::Reduction::dist(&x[0], &y[0], n).todouble(), tol);
+        EXPECT_EQ((double)linfd, NOMAD::Reduction::dist(&x[0], &y[0], n, NOMAD::LINF).todouble());
+    }
+}
+
+// Accuracy in high dimension.
+TEST(ReductionTest, Accuracy) {
+
+    // 1 followed by many values that are lost by a serial sum.
+    const int n = NOMAD::MAX_DIMENSION;
+    std::vector<NOMAD::Double> x(n, 1e-16);
+    x[0] = 1.0;
+    double exact = 1.0 + (n - 1) * 1e-16;
+
+    double serial = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        serial += x[i].todouble();
+    }
+    EXPECT_EQ(1.0, serial);
+
+    // Pairwise sum only loses the small values of the first block.
+    double pairwise = NOMAD::Reduction::sum(&x[0], n).todouble();
+    EXPECT_LT(std::fabs(pairwise - exact), std::fabs(serial - exact));
+    EXPECT_NEAR(exact, pairwise, NOMAD::Reduction::BLOCK_SIZE * 1e-16);
+    EXPECT_EQ(exact, NOMAD::Reduction::sum_compensated(&x[0], n).todouble());
+
+    // Cancellation: compensated sum is exact.
+    double v[] = { 1e100, 1.0, -1e100, 1.0 };
+    std::vector<NOMAD::Double> y(v, v + 4);
+    EXPECT_EQ(2.0, NOMAD::Reduction::sum_compensated(&y[0], 4).todouble());
+}
+
+// Undefined and NaN values.
+TEST(ReductionTest, Undefined) {
+
+    std::vector<NOMAD::Double> x(200, 1.0), y(200, 2.0);
+    x[150] = NOMAD::Double();
+#ifdef UNCHECKED_DOUBLE
+    EXPECT_FALSE(NOMAD::Reduction::sum(&x[0], 200).is_defined());
+    EXPECT_FALSE(NOMAD::Reduction::norm(&x[0], 200, NOMAD::LINF).is_defined());
+#else
+    EXPECT_THROW(NOMAD::Reduction::sum(&x[0], 200), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(NOMAD::Reduction::sum_compensated(&x[0], 200), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(NOMAD::Reduction::dot(&y[0], &x[0], 200), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(NOMAD::Reduction::norm(&x[0], 200, NOMAD::LINF), NOMAD::Double::Not_Defined);
+    EXPECT_THROW(NOMAD::Reduction::dist(&y[0], &x[0], 200, NOMAD::L1), NOMAD::Double::Not_Defined);
+#endif
+    // Other values are fine.
+    EXPECT_EQ(150.0, NOMAD::Reduction::sum(&x[0], 150).todouble());
+
+    // A defined NaN gives a NaN.
+    x[150] = NOMAD::NaN;
+    EXPECT_TRUE(NOMAD::Reduction::sum(&x[0], 200).is_nan());
+    EXPECT_TRUE(NOMAD::Reduction::norm(&x[0], 200, NOMAD::LINF).is_nan());
+}
+
+// Point and Vector use the reduction.
+TEST(ReductionTest, PointVector) {
+
+    NOMAD::Point p(3), q(3);
+    p[0] = 1.0; p[1] = -2.0; p[2] = 2.0;
+    q[0] = 4.0; q[1] = 2.0;  q[2] = 2.0;
+    EXPECT_EQ(9.0, p.squared_norm().todouble());
+    EXPECT_EQ(3.0, p.norm().todouble());
+    EXPECT_EQ(5.0, p.norm(NOMAD::L1).todouble());
+    EXPECT_EQ(2.0, p.norm(NOMAD::LINF).todouble());
+    EXPECT_EQ(5.0, p.dist(q).todouble());
+    EXPECT_EQ(4.0, p.dist(q, NOMAD::LINF).todouble());
+    EXPECT_EQ(4.0 - 4.0 + 4.0, p.dot_product(q).todouble());
+    EXPECT_EQ(5.0, NOMAD::Vector(p, q).norm().todouble());
+    EXPECT_THROW(p.dist(NOMAD::Point(2)), NOMAD::Exception);
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
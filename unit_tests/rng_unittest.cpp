@@ -0,0 +1,270 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <climits>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "Math/PointSet.hpp"
+#include "Math/RNG.hpp"
+
+#include "gtest/gtest.h"
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests the random number generator.
+
+// Draws of the generator
+static std::vector<uint32_t> draws(int nb)
+{
+    std::vector<uint32_t> v;
+    for (int i = 0; i < nb; i++)
+        v.push_back(NOMAD::RNG::rand());
+    return v;
+}
+
+static std::vector<uint32_t> draws(NOMAD::RandomGenerator &g, int nb)
+{
+    std::vector<uint32_t> v;
+    for (int i = 0; i < nb; i++)
+        v.push_back(g.rand());
+    return v;
+}
+
+// Seeds
+TEST(RNGTest, Seed) {
+    // This test is named "Seed", and belongs to the "RNGTest"
+    // test case.
+
+    EXPECT_FALSE(NOMAD::RNG::get_compatibility_mode());
+
+    // Reproducible sequences
+    NOMAD::RNG::set_seed(12);
+    EXPECT_EQ(12, NOMAD::RNG::get_seed());
+    std::vector<uint32_t> v12 = draws(100);
+    NOMAD::RNG::set_seed(13);
+    std::vector<uint32_t> v13 = draws(100);
+    NOMAD::RNG::set_seed(12);
+    EXPECT_EQ(v12, draws(100));
+
+    // Neighbor seeds give unrelated sequences.
+    int nb_same = 0;
+    for (int i = 0; i < 100; i++)
+        nb_same += (v12[i] == v13[i]);
+    EXPECT_EQ(0, nb_same);
+    NOMAD::RNG::set_seed(0);
+    EXPECT_NE(0U, NOMAD::RNG::rand());
+
+    // Large seeds are O(1).
+    NOMAD::RNG::set_seed(INT_MAX);
+    EXPECT_EQ(INT_MAX, NOMAD::RNG::get_seed());
+    EXPECT_ANY_THROW(NOMAD::RNG::set_seed(-1));
+
+    // Compatibility mode: the default state, advanced by s draws
+    NOMAD::RNG::set_compatibility_mode(true);
+    EXPECT_TRUE(NOMAD::RNG::get_compatibility_mode());
+    const int seeds[] = { 0, 1, 2, 255, 256, 1000, 123457 };
+    for (int k = 0; k < 7; k++)
+    {
+        NOMAD::RNG::reset_private_seed_to_default();
+        for (int i = 0; i < seeds[k]; i++)
+            NOMAD::RNG::rand();
+        std::vector<uint32_t> ref = draws(10);
+        NOMAD::RNG::set_seed(seeds[k]);
+        EXPECT_EQ(ref, draws(10));
+    }
+    NOMAD::RNG::set_seed(INT_MAX);
+    EXPECT_EQ(INT_MAX, NOMAD::RNG::get_seed());
+    NOMAD::RNG::set_compatibility_mode(false);
+}
+
+// Jump ahead
+TEST(RNGTest, Jump) {
+    NOMAD::RNG::set_seed(7);
+    const int nb_draws[] = { 0, 1, 17, 300, 4096, 100001 };
+    for (int k = 0; k < 6; k++)
+    {
+        NOMAD::RNG::set_seed(7);
+        for (int i = 0; i < nb_draws[k]; i++)
+            NOMAD::RNG::rand();
+        std::vector<uint32_t> ref = draws(10);
+        NOMAD::RNG::set_seed(7);
+        NOMAD::RNG::jump(nb_draws[k]);
+        EXPECT_EQ(ref, draws(10));
+    }
+
+    // Jumps add up.
+    const uint64_t a = 0x123456789ABCDEFULL;
+    const uint64_t b = 0x7EDCBA987654321ULL;
+    NOMAD::RNG::set_seed(8);
+    NOMAD::RNG::jump(a);
+    NOMAD::RNG::jump(b);
+    std::vector<uint32_t> ref = draws(10);
+    NOMAD::RNG::set_seed(8);
+    NOMAD::RNG::jump(a + b);
+    EXPECT_EQ(ref, draws(10));
+}
+
+// Generator objects and substreams
+TEST(RNGTest, Generator) {
+    // Same sequences as the static functions
+    NOMAD::RNG::set_seed(12);
+    NOMAD::RandomGenerator g12(12);
+    EXPECT_EQ(12, g12.get_seed());
+    EXPECT_EQ(draws(100), draws(g12, 100));
+    NOMAD::RNG::set_compatibility_mode(true);
+    NOMAD::RNG::set_seed(1000);
+    NOMAD::RandomGenerator g1000(1000, true);
+    EXPECT_EQ(draws(100), draws(g1000, 100));
+    NOMAD::RNG::set_compatibility_mode(false);
+    NOMAD::RandomGenerator g0;
+    NOMAD::RNG::reset_private_seed_to_default();
+    EXPECT_EQ(draws(100), draws(g0, 100));
+    EXPECT_ANY_THROW(NOMAD::RandomGenerator(-1));
+
+    // Value type: a copy continues the same sequence.
+    NOMAD::RandomGenerator g(5);
+    g.rand();
+    NOMAD::RandomGenerator h = g;
+    EXPECT_EQ(draws(g, 10), draws(h, 10));
+    EXPECT_EQ(g.rand(0.0, 1.0), h.rand(0.0, 1.0));
+    EXPECT_EQ(g.normal_rand(1.0, 2.0), h.normal_rand(1.0, 2.0));
+
+    // Substream k: k*2^64 draws
+    NOMAD::RandomGenerator master(42);
+    NOMAD::RandomGenerator s0 = master.substream(0);
+    EXPECT_EQ(draws(master, 10), draws(s0, 10));
+    NOMAD::RandomGenerator s1 = master.substream(1);
+    NOMAD::RandomGenerator ref = master;
+    ref.jump(1ULL << 63);
+    ref.jump(1ULL << 63);
+    EXPECT_EQ(draws(ref, 10), draws(s1, 10));
+    NOMAD::RandomGenerator s3 = master.substream(3);
+    NOMAD::RandomGenerator s12 = master.substream(1).substream(2);
+    EXPECT_EQ(draws(s3, 10), draws(s12, 10));
+
+    // The period is 2^96-1 = (2^32-1)*2^64 + 2^64-1.
+    NOMAD::RandomGenerator last = master.substream(0xFFFFFFFFU);
+    last.jump(~0ULL);
+    EXPECT_EQ(draws(master, 10), draws(last, 10));
+
+    // One substream per thread
+    const int nb_threads = 4;
+    const int nb = 1000;
+    std::vector<std::vector<uint32_t> > seq(nb_threads), par(nb_threads);
+    for (int t = 0; t < nb_threads; t++)
+    {
+        NOMAD::RandomGenerator st = master.substream(t);
+        seq[t] = draws(st, nb);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nb_threads; t++)
+        threads.push_back(std::thread([&master, &par, t, nb]() {
+            NOMAD::RandomGenerator st = master.substream(t);
+            par[t] = draws(st, nb);
+        }));
+    for (int t = 0; t < nb_threads; t++)
+        threads[t].join();
+    EXPECT_EQ(seq, par);
+
+    // Moments of the normal distribution
+    NOMAD::RandomGenerator gn(3);
+    const int nb_normal = 100000;
+    double sum = 0.0, sum2 = 0.0;
+    for (int i = 0; i < nb_normal; i++)
+    {
+        double x = gn.normal_rand(1.0, 4.0);
+        sum += x;
+        sum2 += x * x;
+    }
+    double mean = sum / nb_normal;
+    EXPECT_NEAR(1.0, mean, 0.03);
+    EXPECT_NEAR(4.0, sum2 / nb_normal - mean * mean, 0.1);
+}
+
+// Bulk fills
+TEST(RNGTest, Fill) {
+    const int nb = 1000000;
+    std::vector<double> v(nb);
+
+    // Uniform
+    NOMAD::RandomGenerator g(4);
+    g.fill_uniform(&v[0], nb, -1.0, 3.0);
+    double sum = 0.0;
+    for (int i = 0; i < nb; i++)
+    {
+        EXPECT_GE(v[i], -1.0);
+        EXPECT_LE(v[i], 3.0);
+        sum += v[i];
+    }
+    EXPECT_NEAR(1.0, sum / nb, 0.01);
+    std::vector<int> counts(16, 0);
+    for (int i = 0; i < nb; i++)
+        counts[std::min(15, static_cast<int>((v[i] + 1.0) * 4.0))]++;
+    for (int k = 0; k < 16; k++)
+        EXPECT_NEAR(nb / 16, counts[k], 1000);
+
+    // Same seed, same values. Each fill draws two numbers.
+    NOMAD::RandomGenerator h(4);
+    std::vector<double> w(nb);
+    h.fill_uniform(&w[0], nb, -1.0, 3.0);
+    EXPECT_EQ(v, w);
+    EXPECT_EQ(g.rand(), h.rand());
+    NOMAD::RandomGenerator ref(4);
+    ref.jump(3);
+    EXPECT_EQ(ref.rand(), g.rand());
+
+    // Normal: moments and tails
+    g.fill_normal(&v[0], nb, 2.0, 9.0);
+    double m1 = 0.0, m2 = 0.0, m4 = 0.0;
+    int nb_tail = 0, nb_pos = 0;
+    for (int i = 0; i < nb; i++)
+    {
+        double x = (v[i] - 2.0) / 3.0;
+        m1 += x;
+        m2 += x * x;
+        m4 += x * x * x * x;
+        nb_tail += (std::fabs(x) > 3.442619855899);
+        nb_pos += (x > 0);
+    }
+    EXPECT_NEAR(0.0, m1 / nb, 0.005);
+    EXPECT_NEAR(1.0, m2 / nb, 0.01);
+    EXPECT_NEAR(3.0, m4 / nb, 0.05);
+    EXPECT_NEAR(nb * 0.000576, nb_tail, 100);   // P(|x|>3.4426)
+    EXPECT_NEAR(nb / 2, nb_pos, 2000);
+
+    // Points, in both layouts
+    NOMAD::PointSet aos(1000, 7, NOMAD::AOS), soa(1000, 7, NOMAD::SOA);
+    NOMAD::RandomGenerator ga(8), gs(8);
+    ga.fill_uniform(aos, 0.0, 1.0);
+    gs.fill_uniform(soa, 0.0, 1.0);
+    for (int i = 0; i < 1000; i++)
+        for (int j = 0; j < 7; j++)
+        {
+            EXPECT_TRUE(aos(i,j).is_defined());
+            EXPECT_TRUE(soa(i,j).is_defined());
+            EXPECT_GE(soa(i,j).todouble(), 0.0);
+            EXPECT_LE(aos(i,j).todouble(), 1.0);
+        }
+    ga.fill_normal(aos);
+    gs.fill_normal(soa);
+    EXPECT_EQ(soa(0,0).todouble(), aos(0,0).todouble());
+    EXPECT_EQ(soa(1,0).todouble(), aos(0,1).todouble());
+
+    // Static functions
+    NOMAD::RNG::set_seed(4);
+    NOMAD::RNG::fill_uniform(&w[0], nb, -1.0, 3.0);
+    h = NOMAD::RandomGenerator(4);
+    h.fill_uniform(&v[0], nb, -1.0, 3.0);
+    EXPECT_EQ(v, w);
+    NOMAD::RNG::fill_normal(aos, 1.0, 4.0);
+    NOMAD::RNG::fill_uniform(aos, 1.0, 4.0);
+    NOMAD::RNG::fill_normal(&w[0], 0);
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.
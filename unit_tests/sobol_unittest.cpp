@@ -0,0 +1,195 @@
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Math/Point.hpp"
+#include "Math/PointSet.hpp"
+#include "Math/Sobol.hpp"
+
+#include "gtest/gtest.h"
+
+// Step 2. Use the TEST macro to define your tests.
+
+// Tests the Sobol sequence.
+
+// Number of values in each interval of width 2^-m of coordinate i of the samples
+static std::vector<int> count_intervals(const NOMAD::PointSet &points, int i, int m)
+{
+    std::vector<int> counts(1 << m, 0);
+    for (int k = 0; k < points.get_nb_points(); k++)
+    {
+        double v = points(k,i).todouble();
+        counts[static_cast<int>(std::floor(std::ldexp(v, m)))]++;
+    }
+    return counts;
+}
+
+// Values of the sequence
+TEST(SobolTest, Values) {
+    // This test is named "Values", and belongs to the "SobolTest"
+    // test case.
+
+    NOMAD::Sobol sobol(4, 8);
+    sobol.set_scrambling(false);
+    EXPECT_EQ(4, sobol.get_dimension());
+    EXPECT_EQ(8, sobol.get_nb_samples());
+
+    // Standard Sobol sequence, with the direction numbers of Joe and Kuo
+    const double x0[8] = { 0, 0.5, 0.75, 0.25, 0.375, 0.875, 0.625, 0.125 };
+    const double x1[8] = { 0, 0.5, 0.25, 0.75, 0.375, 0.875, 0.125, 0.625 };
+    const double x2[8] = { 0, 0.5, 0.25, 0.75, 0.625, 0.125, 0.875, 0.375 };
+    const double x3[8] = { 0, 0.5, 0.25, 0.75, 0.875, 0.375, 0.625, 0.125 };
+    NOMAD::PointSet points(1, 4);
+    sobol.Sample(points);
+    ASSERT_EQ(8, points.get_nb_points());
+    for (int k = 0; k < 8; k++)
+    {
+        EXPECT_EQ(x0[k], points(k,0).todouble());
+        EXPECT_EQ(x1[k], points(k,1).todouble());
+        EXPECT_EQ(x2[k], points(k,2).todouble());
+        EXPECT_EQ(x3[k], points(k,3).todouble());
+    }
+
+    // (0,m,2)-net: each box of area 2^-m has one of the first 2^m samples.
+    const int m = 8;
+    NOMAD::Sobol net(2, 1 << m);
+    for (int scrambling = 0; scrambling < 2; scrambling++)
+    {
+        net.set_scrambling(scrambling == 1);
+        net.Sample(points);
+        for (int a = 0; a <= m; a++)
+        {
+            std::vector<int> counts(1 << m, 0);
+            for (int k = 0; k < points.get_nb_points(); k++)
+            {
+                int c0 = static_cast<int>(std::floor(std::ldexp(points(k,0).todouble(), a)));
+                int c1 = static_cast<int>(std::floor(std::ldexp(points(k,1).todouble(), m - a)));
+                counts[(c0 << (m - a)) + c1]++;
+            }
+            for (size_t b = 0; b < counts.size(); b++)
+                EXPECT_EQ(1, counts[b]);
+        }
+    }
+
+    // Each coordinate is stratified, with or without scrambling.
+    const int n = 100;
+    NOMAD::Sobol sobol_n(n, 1 << 7);
+    for (int scrambling = 0; scrambling < 2; scrambling++)
+    {
+        sobol_n.set_scrambling(scrambling == 1);
+        sobol_n.Sample(points);
+        for (int i = 0; i < n; i++)
+        {
+            std::vector<int> counts = count_intervals(points, i, 7);
+            EXPECT_EQ(counts.size(), static_cast<size_t>(std::count(counts.begin(), counts.end(), 1)));
+        }
+    }
+
+    // Coordinates are different.
+    for (int i = 1; i < n; i++)
+    {
+        bool same = true;
+        for (int k = 0; k < points.get_nb_points() && same; k++)
+            same = (points(k,i).todouble() == points(k,0).todouble());
+        EXPECT_FALSE(same);
+    }
+
+    EXPECT_ANY_THROW(NOMAD::Sobol(0, 1));
+    EXPECT_ANY_THROW(NOMAD::Sobol(NOMAD::MAX_DIMENSION + 1, 1));
+    EXPECT_ANY_THROW(NOMAD::Sobol(2, -1));
+    NOMAD::Sobol big(NOMAD::MAX_DIMENSION, 4);
+    big.Sample(points);
+    EXPECT_EQ(NOMAD::MAX_DIMENSION, points.get_dimension());
+}
+
+// Direct access, skip-ahead, bounds and seeds
+TEST(SobolTest, Access) {
+    const int n = 20;
+    const int p = 1000;
+    NOMAD::Sobol sobol(n, p, 123);
+    NOMAD::PointSet points(p, n, NOMAD::SOA);
+    sobol.Sample(points);
+    EXPECT_EQ(NOMAD::SOA, points.get_layout());
+
+    // Sample(k), and next() after seek(), give the same samples.
+    NOMAD::Point x;
+    for (int k = 0; k < p; k += 37)
+    {
+        sobol.Sample(k, x);
+        EXPECT_EQ(n, x.get_size());
+        for (int i = 0; i < n; i++)
+            EXPECT_EQ(points(k,i).todouble(), x[i].todouble());
+    }
+    sobol.seek(500);
+    EXPECT_EQ(500, sobol.get_index());
+    int k = 500;
+    while (sobol.next(x))
+    {
+        for (int i = 0; i < n; i++)
+            EXPECT_EQ(points(k,i).todouble(), x[i].todouble());
+        k++;
+    }
+    EXPECT_EQ(p, k);
+    EXPECT_TRUE(sobol.done());
+
+    // Blocks
+    sobol.seek(0);
+    NOMAD::PointSet block(64, n);
+    k = 0;
+    int nb;
+    while ((nb = sobol.next(block)) > 0)
+    {
+        for (int r = 0; r < nb; r++, k++)
+            for (int i = 0; i < n; i++)
+                EXPECT_EQ(points(k,i).todouble(), block(r,i).todouble());
+    }
+    EXPECT_EQ(p, k);
+
+    // Seeds
+    NOMAD::PointSet other;
+    sobol.set_seed(124);
+    EXPECT_EQ(124, sobol.get_seed());
+    sobol.Sample(other);
+    int nb_diff = 0;
+    for (k = 0; k < p; k++)
+        nb_diff += (other(k,3).todouble() != points(k,3).todouble());
+    EXPECT_GT(nb_diff, p / 2);
+    sobol.set_seed(123);
+    sobol.Sample(other);
+    for (k = 0; k < p; k++)
+        EXPECT_EQ(points(k,3).todouble(), other(k,3).todouble());
+
+    // Bounds
+    std::vector<double> l(n, -2.0), u(n, 3.0);
+    u[0] = -2.0;
+    sobol.set_bounds(l, u);
+    sobol.Sample(other);
+    for (k = 0; k < p; k++)
+    {
+        EXPECT_EQ(-2.0, other(k,0).todouble());
+        for (int i = 1; i < n; i++)
+        {
+            EXPECT_GE(other(k,i).todouble(), -2.0);
+            EXPECT_LE(other(k,i).todouble(), 3.0);
+            EXPECT_NEAR(-2.0 + 5.0 * points(k,i).todouble(), other(k,i).todouble(), 1e-14);
+        }
+    }
+    NOMAD::Point lp(n, -2.0), up(n, 3.0);
+    sobol.set_bounds(lp, up);
+    EXPECT_EQ(3.0, sobol.get_ub()[0]);
+    EXPECT_ANY_THROW(sobol.set_bounds(u, l));
+    l[1] = NOMAD::INF;
+    EXPECT_ANY_THROW(sobol.set_bounds(l, u));
+    EXPECT_ANY_THROW(sobol.set_bounds(std::vector<double>(2, 0.0), std::vector<double>(2, 1.0)));
+    lp[1] = NOMAD::Double();
+    EXPECT_ANY_THROW(sobol.set_bounds(lp, up));
+}
+
+// Step 3. Call RUN_ALL_TESTS() in main().
+//
+// We do this by linking in src/gtest_main.cc file, which consists of
+// a main() function which calls RUN_ALL_TESTS() for us.